@@ -0,0 +1,97 @@
+#include "OrcAsyncScheduler.h"
+#include "OrcEmulatedQueue.h"
+#include "OrcJobSystem.h"
+#include "OrcTask.h"
+
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    Orc::Task<Orc::uint64> uploadAsync(Orc::AsyncScheduler& scheduler, Orc::EmulatedQueue& copyQueue, std::vector<Orc::uint8> data)
+    {
+        // Stands in for recording a copy and submitting it.
+        auto fenceValue = copyQueue.signal();
+        co_await scheduler.waitForFence(copyQueue, fenceValue);
+        co_return data.size();
+    }
+
+    Orc::Task<void> loadAsync(Orc::AsyncScheduler& scheduler, Orc::EmulatedQueue& copyQueue, std::string path, Orc::uint32& finishedCount)
+    {
+        auto data = co_await scheduler.readFile(std::move(path));
+        co_await uploadAsync(scheduler, copyQueue, std::move(data));
+        ++finishedCount;
+    }
+
+    Orc::Task<void> yieldLoop(Orc::AsyncScheduler& scheduler, Orc::uint32 count)
+    {
+        for (Orc::uint32 i = 0; i < count; ++i)
+            co_await scheduler.yield();
+    }
+}
+
+// Drives coroutines that read a file, submit an upload and wait for its fence against a simulated copy
+// queue timeline that retires one submission per frame, then measures the cost of a bare resume. The
+// AsyncTasks test checks the ordering of the same timeline.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 fileCount = 64;
+        constexpr Orc::uint32 fileSize = 256 * 1024;
+        constexpr Orc::uint32 yieldCount = 1 << 20;
+
+        auto directory = std::filesystem::temp_directory_path() / "OrcAsyncTasks";
+        std::filesystem::create_directories(directory);
+        std::vector<std::string> paths;
+        for (Orc::uint32 i = 0; i < fileCount; ++i)
+        {
+            paths.push_back((directory / ("file" + std::to_string(i) + ".bin")).string());
+            std::ofstream(paths.back(), std::ios::binary) << std::string(fileSize, static_cast<char>(i));
+        }
+
+        Orc::JobSystem jobSystem(0);
+        Orc::EmulatedQueue copyQueue(Orc::CommandListType::CLT_COPY, false);
+        Orc::uint32 finishedCount = 0;
+        {
+            Orc::AsyncScheduler scheduler(&jobSystem);
+            auto start = std::chrono::steady_clock::now();
+            for (const auto& path : paths)
+                scheduler.spawn(loadAsync(scheduler, copyQueue, path, finishedCount));
+
+            Orc::uint32 frameCount = 0;
+            Orc::uint32 maxResumedPerFrame = 0;
+            while (scheduler.getPendingTaskCount() > 0)
+            {
+                ++frameCount;
+                copyQueue.retireNext();
+                auto resumed = scheduler.poll();
+                maxResumedPerFrame = resumed > maxResumedPerFrame ? resumed : maxResumedPerFrame;
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            const auto& stats = scheduler.getStats();
+            std::cout << "timeline: " << finishedCount << '/' << fileCount << " loads finished in " << frameCount << " frames, "
+                << stats.resumedCount << " resumes (at most " << maxResumedPerFrame
+                << " per frame), " << stats.bytesRead / elapsed.count() / 1e6 << " MB/s read" << std::endl;
+
+            scheduler.spawn(yieldLoop(scheduler, yieldCount));
+            start = std::chrono::steady_clock::now();
+            while (scheduler.getPendingTaskCount() > 0)
+                scheduler.poll();
+            std::chrono::duration<double, std::nano> yieldTime = std::chrono::steady_clock::now() - start;
+            std::cout << "yield: " << yieldTime.count() / yieldCount << " ns per suspend and resume" << std::endl;
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "OrcCommandList.h"
+#include "OrcCommandStream.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    struct CountingHandler
+    {
+        Orc::uint64 commandCount = 0;
+        Orc::uint64 checksum = 0;
+
+        void operator()(const Orc::ResourceBarrierCommand& cmd) { ++commandCount; checksum += cmd.resource; }
+        void operator()(const Orc::ClearRenderTargetCommand& cmd) { ++commandCount; checksum += cmd.renderTarget; }
+        void operator()(const Orc::SetViewportCommand& cmd) { ++commandCount; checksum += static_cast<Orc::uint64>(cmd.width); }
+        void operator()(const Orc::SetScissorRectCommand& cmd) { ++commandCount; checksum += cmd.right; }
+        void operator()(const Orc::DrawInstancedCommand& cmd) { ++commandCount; checksum += cmd.vertexCountPerInstance; }
+        void operator()(const Orc::DrawIndexedInstancedCommand& cmd) { ++commandCount; checksum += cmd.indexCountPerInstance; }
+        void operator()(const Orc::DispatchCommand& cmd) { ++commandCount; checksum += cmd.threadGroupCountX; }
+        void operator()(const Orc::CopyBufferRegionCommand& cmd) { ++commandCount; checksum += cmd.numBytes; }
+    };
+
+    void recordScene(Orc::CommandListContext& context, Orc::uint32 drawCount)
+    {
+        context.begin();
+        context.resourceBarrier(0, Orc::ResourceState::RS_PRESENT, Orc::ResourceState::RS_RENDER_TARGET);
+        context.clearRenderTarget(0, 0, 0, 0, 1);
+        context.setViewport(0, 0, 1920, 1080);
+        context.setScissorRect(0, 0, 1920, 1080);
+        for (Orc::uint32 i = 0; i < drawCount; ++i)
+            context.drawIndexedInstanced(36 + (i & 63), 1, i * 36, 0, 0);
+        context.resourceBarrier(0, Orc::ResourceState::RS_RENDER_TARGET, Orc::ResourceState::RS_PRESENT);
+        context.end();
+    }
+}
+
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 drawCount = 100000;
+        constexpr Orc::uint32 iterations = 200;
+
+        Orc::CommandListContext context(Orc::CommandListType::CLT_GRAPHICS);
+        recordScene(context, drawCount);
+
+        auto start = std::chrono::steady_clock::now();
+        for (Orc::uint32 i = 0; i < iterations; ++i)
+            recordScene(context, drawCount);
+        std::chrono::duration<double> recordTime = std::chrono::steady_clock::now() - start;
+
+        const Orc::CommandStream& stream = context.getCommandStream();
+        CountingHandler handler;
+        start = std::chrono::steady_clock::now();
+        for (Orc::uint32 i = 0; i < iterations; ++i)
+            stream.replay(handler);
+        std::chrono::duration<double> replayTime = std::chrono::steady_clock::now() - start;
+
+        std::vector<Orc::uint8> serialized(stream.getData(), stream.getData() + stream.getSize());
+        Orc::CommandStream restored;
+        start = std::chrono::steady_clock::now();
+        for (Orc::uint32 i = 0; i < iterations; ++i)
+            restored.assign(serialized.data(), serialized.size());
+        std::chrono::duration<double> assignTime = std::chrono::steady_clock::now() - start;
+
+        const double commandCount = static_cast<double>(stream.getCommandCount()) * iterations;
+        std::cout << stream.getCommandCount() << " commands per stream, " << stream.getSize() << " bytes ("
+            << static_cast<double>(stream.getSize()) / stream.getCommandCount() << " bytes/command)" << std::endl;
+        std::cout << "record:   " << commandCount / recordTime.count() / 1e6 << " M commands/s" << std::endl;
+        std::cout << "replay:   " << commandCount / replayTime.count() / 1e6 << " M commands/s (checksum " << handler.checksum << ")" << std::endl;
+        std::cout << "validate: " << commandCount / assignTime.count() / 1e6 << " M commands/s" << std::endl;
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
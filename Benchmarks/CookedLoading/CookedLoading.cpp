@@ -0,0 +1,175 @@
+#include "OrcCookedMesh.h"
+#include "OrcGltfLoader.h"
+#include "OrcJobSystem.h"
+#include "OrcTextureDecoder.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int RUN_COUNT = 5;
+
+    // A gridSize x gridSize vertex grid in an external .bin with imageCount PNG textures, standing in for
+    // a model when none are given.
+    void writeModel(const std::filesystem::path& directory, Orc::uint32 gridSize, Orc::uint32 imageCount, Orc::uint32 imageSize)
+    {
+        std::filesystem::create_directories(directory);
+        std::vector<float> vertices;
+        for (Orc::uint32 y = 0; y < gridSize; ++y)
+        {
+            for (Orc::uint32 x = 0; x < gridSize; ++x)
+            {
+                float u = static_cast<float>(x) / (gridSize - 1);
+                float v = static_cast<float>(y) / (gridSize - 1);
+                vertices.insert(vertices.end(), { u, 0.0f, v, 0.0f, 1.0f, 0.0f, u, v });
+            }
+        }
+        std::vector<Orc::uint32> indices;
+        for (Orc::uint32 y = 0; y + 1 < gridSize; ++y)
+        {
+            for (Orc::uint32 x = 0; x + 1 < gridSize; ++x)
+            {
+                Orc::uint32 i = y * gridSize + x;
+                indices.insert(indices.end(), { i, i + gridSize, i + 1, i + 1, i + gridSize, i + gridSize + 1 });
+            }
+        }
+        auto vertexBytes = vertices.size() * sizeof(float);
+        auto indexBytes = indices.size() * sizeof(Orc::uint32);
+        std::ofstream bin(directory / "Grid.bin", std::ios::binary);
+        bin.write(reinterpret_cast<const char*>(vertices.data()), vertexBytes);
+        bin.write(reinterpret_cast<const char*>(indices.data()), indexBytes);
+
+        std::string images;
+        std::vector<Orc::uint8> pixels(size_t(imageSize) * imageSize * 4);
+        for (Orc::uint32 image = 0; image < imageCount; ++image)
+        {
+            for (size_t i = 0; i < pixels.size(); ++i)
+                pixels[i] = static_cast<Orc::uint8>(i % 4 == 3 ? 255 : (i / 4 % imageSize) * (image + 1) + i / 4 / imageSize);
+            auto name = "Grid" + std::to_string(image) + ".png";
+            if (!stbi_write_png((directory / name).string().c_str(), imageSize, imageSize, 4, pixels.data(), imageSize * 4))
+                throw std::runtime_error("Cannot write " + name);
+            if (image)
+                images += ",";
+            images += R"({"uri":")" + name + R"("})";
+        }
+
+        auto vertexCount = std::to_string(gridSize * gridSize);
+        std::ofstream(directory / "Grid.gltf") << R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0}],)"
+            R"("meshes":[{"primitives":[{"attributes":{"POSITION":0,"NORMAL":1,"TEXCOORD_0":2},"indices":3}]}],)"
+            R"("buffers":[{"uri":"Grid.bin","byteLength":)" << vertexBytes + indexBytes << "}],"
+            R"("bufferViews":[{"buffer":0,"byteLength":)" << vertexBytes << R"(,"byteStride":32},)"
+            R"({"buffer":0,"byteOffset":)" << vertexBytes << R"(,"byteLength":)" << indexBytes << "}],"
+            R"("accessors":[{"bufferView":0,"componentType":5126,"count":)" << vertexCount << R"(,"type":"VEC3","min":[0,0,0],"max":[1,0,1]},)"
+            R"({"bufferView":0,"byteOffset":12,"componentType":5126,"count":)" << vertexCount << R"(,"type":"VEC3"},)"
+            R"({"bufferView":0,"byteOffset":24,"componentType":5126,"count":)" << vertexCount << R"(,"type":"VEC2"},)"
+            R"({"bufferView":1,"componentType":5125,"count":)" << indices.size() << R"(,"type":"SCALAR"}],)"
+            R"("images":[)" << images << "]}";
+    }
+
+    // Median of RUN_COUNT runs, the first of which also warms the page cache.
+    double measure(const std::function<void()>& load)
+    {
+        std::vector<double> times;
+        for (int run = 0; run < RUN_COUNT; ++run)
+        {
+            auto start = std::chrono::steady_clock::now();
+            load();
+            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[RUN_COUNT / 2];
+    }
+}
+
+// Loads each model as the entity loader does, from glTF and from an .orcmesh cooked from it: geometry
+// into a buffer standing in for an upload heap, and images decoded with their mips. Models are the
+// .gltf and .glb files given on the command line, or else those in the Models directory next to the
+// executable, or else a generated one.
+int main(int argc, char** argv)
+{
+    try
+    {
+        std::vector<std::filesystem::path> models;
+        for (int i = 1; i < argc; ++i)
+            models.push_back(argv[i]);
+        auto modelDirectory = std::filesystem::path(argv[0]).parent_path() / "Models";
+        if (models.empty() && std::filesystem::is_directory(modelDirectory))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(modelDirectory))
+            {
+                if (entry.path().extension() == ".gltf" || entry.path().extension() == ".glb")
+                    models.push_back(entry.path());
+            }
+        }
+        auto generatedDirectory = std::filesystem::temp_directory_path() / "OrcCookedLoading";
+        if (models.empty())
+        {
+            writeModel(generatedDirectory, 1024, 4, 1024);
+            models.push_back(generatedDirectory / "Grid.gltf");
+        }
+
+        Orc::JobSystem jobSystem(0);
+        std::vector<Orc::uint8> upload;
+        for (const auto& model : models)
+        {
+            auto cookedPath = (std::filesystem::temp_directory_path() / model.filename()).replace_extension(".orcmesh");
+            try
+            {
+                Orc::cookMesh(model.string(), cookedPath.string(), &jobSystem);
+
+                double gltfTime = measure([&]
+                {
+                    Orc::GltfAsset asset(model.string());
+                    std::vector<Orc::TextureData> images(asset.getDocument().images.size());
+                    Orc::TextureDecoder textureDecoder(&jobSystem);
+                    for (Orc::int32 i = 0; i < static_cast<Orc::int32>(images.size()); ++i)
+                        textureDecoder.decode(asset.getImage(i), images[i]);
+                    auto vertexBytes = asset.getVertexCount() * sizeof(Orc::Vertex);
+                    upload.resize(vertexBytes + asset.getIndexCount() * sizeof(Orc::uint32));
+                    std::vector<Orc::Submesh> submeshes;
+                    Orc::BoundingBox bounds;
+                    asset.decode(reinterpret_cast<Orc::Vertex*>(upload.data()), reinterpret_cast<Orc::uint32*>(upload.data() + vertexBytes), submeshes, bounds);
+                    textureDecoder.wait();
+                });
+
+                double cookedTime = measure([&]
+                {
+                    Orc::CookedMesh cooked(cookedPath.string());
+                    upload.resize(cooked.getVertexData().size() + cooked.getIndexData().size());
+                    std::memcpy(upload.data(), cooked.getVertexData().data(), cooked.getVertexData().size());
+                    std::memcpy(upload.data() + cooked.getVertexData().size(), cooked.getIndexData().data(), cooked.getIndexData().size());
+                    std::vector<Orc::TextureData> images;
+                    for (Orc::uint32 i = 0; i < cooked.getImageCount(); ++i)
+                        images.push_back(cooked.getImage(i));
+                });
+
+                Orc::CookedMesh cooked(cookedPath.string());
+                std::cout << model.filename().string() << ": " << cooked.getVertexCount() << " vertices, " << cooked.getIndexCount() / 3 << " triangles, "
+                    << cooked.getImageCount() << " images, " << std::filesystem::file_size(cookedPath) / double(1 << 20) << " MB cooked" << std::endl;
+                std::cout << "    glTF " << gltfTime << " ms, cooked " << cookedTime << " ms, " << gltfTime / cookedTime << "x" << std::endl;
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << model.string() << ": " << e.what() << std::endl;
+            }
+            std::filesystem::remove(cookedPath);
+        }
+        std::filesystem::remove_all(generatedDirectory);
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+    return 0;
+}
\ No newline at end of file
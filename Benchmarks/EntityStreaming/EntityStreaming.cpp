@@ -0,0 +1,150 @@
+#include "OrcApplicationContext.h"
+#include "OrcEntityLoad.h"
+#include "OrcManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Writes a gridSize x gridSize vertex grid as a .gltf with an external .bin and returns the bytes written.
+    Orc::uint64 writeGrid(const std::filesystem::path& directory, const std::string& name, Orc::uint32 gridSize)
+    {
+        std::vector<float> vertices;
+        for (Orc::uint32 y = 0; y < gridSize; ++y)
+        {
+            for (Orc::uint32 x = 0; x < gridSize; ++x)
+            {
+                float u = static_cast<float>(x) / (gridSize - 1);
+                float v = static_cast<float>(y) / (gridSize - 1);
+                vertices.insert(vertices.end(), { u, 0.0f, v, 0.0f, 1.0f, 0.0f, u, v });
+            }
+        }
+        std::vector<Orc::uint32> indices;
+        for (Orc::uint32 y = 0; y + 1 < gridSize; ++y)
+        {
+            for (Orc::uint32 x = 0; x + 1 < gridSize; ++x)
+            {
+                Orc::uint32 i = y * gridSize + x;
+                indices.insert(indices.end(), { i, i + gridSize, i + 1, i + 1, i + gridSize, i + gridSize + 1 });
+            }
+        }
+
+        auto vertexBytes = vertices.size() * sizeof(float);
+        auto indexBytes = indices.size() * sizeof(Orc::uint32);
+        std::ofstream bin(directory / (name + ".bin"), std::ios::binary);
+        bin.write(reinterpret_cast<const char*>(vertices.data()), vertexBytes);
+        bin.write(reinterpret_cast<const char*>(indices.data()), indexBytes);
+
+        auto vertexCount = std::to_string(gridSize * gridSize);
+        std::ofstream gltf(directory / (name + ".gltf"));
+        gltf << R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0}],)"
+            << R"("meshes":[{"primitives":[{"attributes":{"POSITION":0,"NORMAL":1,"TEXCOORD_0":2},"indices":3}]}],)"
+            << R"("buffers":[{"uri":")" << name << R"(.bin","byteLength":)" << vertexBytes + indexBytes << "}],"
+            << R"("bufferViews":[{"buffer":0,"byteLength":)" << vertexBytes << R"(,"byteStride":32},)"
+            << R"({"buffer":0,"byteOffset":)" << vertexBytes << R"(,"byteLength":)" << indexBytes << "}],"
+            << R"("accessors":[{"bufferView":0,"componentType":5126,"count":)" << vertexCount << R"(,"type":"VEC3","min":[0,0,0],"max":[1,0,1]},)"
+            << R"({"bufferView":0,"byteOffset":12,"componentType":5126,"count":)" << vertexCount << R"(,"type":"VEC3"},)"
+            << R"({"bufferView":0,"byteOffset":24,"componentType":5126,"count":)" << vertexCount << R"(,"type":"VEC2"},)"
+            << R"({"bufferView":1,"componentType":5125,"count":)" << indices.size() << R"(,"type":"SCALAR"}]})";
+        return vertexBytes + indexBytes + static_cast<Orc::uint64>(gltf.tellp());
+    }
+}
+
+// Streams procedurally generated glTF entities into a headless scene while rendering, and compares the
+// worst frame with the stall of loading the same files synchronously. Loads are given four priority
+// levels to show that higher priorities finish first.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 entityCount = 96;
+        constexpr Orc::uint32 priorityCount = 4;
+
+        auto directory = std::filesystem::temp_directory_path() / "OrcEntityStreaming";
+        std::filesystem::create_directories(directory);
+        std::vector<std::string> paths;
+        Orc::uint64 totalBytes = 0;
+        for (Orc::uint32 i = 0; i < entityCount; ++i)
+        {
+            auto name = "grid" + std::to_string(i);
+            totalBytes += writeGrid(directory, name, 64 + (i % 8) * 24);
+            paths.push_back((directory / (name + ".gltf")).string());
+        }
+
+        Orc::GraphicsSettings settings;
+        settings.backend = Orc::GraphicsBackendType::GBT_NULL;
+        settings.presentMode = Orc::PresentMode::PM_UNCAPPED;
+        Orc::ApplicationContext ctx(L"OrcEntityStreaming", 800, 600, settings);
+        auto root = ctx.getRoot();
+
+        auto scene = root->createSceneManager("Synchronous");
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> worstStall{};
+        for (Orc::uint32 i = 0; i < entityCount; ++i)
+        {
+            auto loadStart = std::chrono::steady_clock::now();
+            scene->createEntity("Sync" + std::to_string(i), paths[i]);
+            root->renderOneFrame();
+            worstStall = std::max<std::chrono::duration<double>>(worstStall, std::chrono::steady_clock::now() - loadStart);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "synchronous: " << entityCount << " entities in " << elapsed.count() << " s, "
+            << totalBytes / elapsed.count() / (1 << 20) << " MB/s, worst frame " << worstStall.count() * 1e3 << " ms" << std::endl;
+        root->destrotSceneManager(scene);
+
+        scene = root->createSceneManager("Streaming");
+        std::vector<std::shared_ptr<Orc::EntityLoad>> loads;
+        start = std::chrono::steady_clock::now();
+        for (Orc::uint32 i = 0; i < entityCount; ++i)
+            loads.push_back(scene->createEntityAsync("Async" + std::to_string(i), paths[i], static_cast<Orc::int32>(i % priorityCount)));
+
+        Orc::uint32 frameCount = 0;
+        std::chrono::duration<double> worstFrame{};
+        std::vector<Orc::uint64> finishFrameSum(priorityCount, 0);
+        std::vector<bool> finished(entityCount, false);
+        Orc::uint32 failedCount = 0;
+        while (root->getPendingEntityLoadCount() > 0)
+        {
+            auto frameStart = std::chrono::steady_clock::now();
+            root->renderOneFrame();
+            worstFrame = std::max<std::chrono::duration<double>>(worstFrame, std::chrono::steady_clock::now() - frameStart);
+            ++frameCount;
+            for (Orc::uint32 i = 0; i < entityCount; ++i)
+            {
+                if (!finished[i] && loads[i]->isFinished())
+                {
+                    finished[i] = true;
+                    finishFrameSum[loads[i]->getPriority()] += frameCount;
+                    if (!loads[i]->isReady())
+                    {
+                        ++failedCount;
+                        std::cerr << loads[i]->getError() << std::endl;
+                    }
+                }
+            }
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "streaming: " << entityCount << " entities in " << elapsed.count() << " s over " << frameCount << " frames, "
+            << entityCount / elapsed.count() << " loads/s, " << totalBytes / elapsed.count() / (1 << 20) << " MB/s, worst frame "
+            << worstFrame.count() * 1e3 << " ms, " << failedCount << " failed" << std::endl;
+        for (Orc::int32 priority = priorityCount - 1; priority >= 0; --priority)
+        {
+            std::cout << "  priority " << priority << ": finished at frame "
+                << static_cast<double>(finishFrameSum[priority]) / (entityCount / priorityCount) << " on average" << std::endl;
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
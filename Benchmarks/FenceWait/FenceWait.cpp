@@ -0,0 +1,83 @@
+#include "OrcEmulatedQueue.h"
+#include "OrcGraphicsSettings.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const char* toString(Orc::WaitStrategy strategy)
+    {
+        switch (strategy)
+        {
+        case Orc::WaitStrategy::WS_BLOCK:
+            return "block";
+        case Orc::WaitStrategy::WS_SPIN_THEN_BLOCK:
+            return "spin-then-block";
+        case Orc::WaitStrategy::WS_YIELD:
+            return "yield";
+        }
+        return "unknown";
+    }
+}
+
+// A simulated GPU thread completes each fence value after a fixed amount of busy work while the main
+// thread waits for it, measuring how late each strategy wakes up after the value completes.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 iterations = 2000;
+        const std::chrono::microseconds gpuTimes[] = { std::chrono::microseconds(0), std::chrono::microseconds(20), std::chrono::microseconds(200), std::chrono::microseconds(1000) };
+
+        for (auto gpuTime : gpuTimes)
+        {
+            for (auto strategy : { Orc::WaitStrategy::WS_BLOCK, Orc::WaitStrategy::WS_SPIN_THEN_BLOCK, Orc::WaitStrategy::WS_YIELD })
+            {
+                Orc::EmulatedQueue queue(Orc::CommandListType::CLT_GRAPHICS, false);
+                queue.setWaitStrategy(strategy, std::chrono::microseconds(50));
+
+                std::atomic<Orc::uint64> submitted{ 0 };
+                std::vector<std::chrono::steady_clock::time_point> completionTime(iterations + 1);
+                std::thread gpu([&]()
+                {
+                    for (Orc::uint64 value = 1; value <= iterations; ++value)
+                    {
+                        while (submitted.load(std::memory_order_acquire) < value)
+                            std::this_thread::yield();
+                        auto end = std::chrono::steady_clock::now() + gpuTime;
+                        while (std::chrono::steady_clock::now() < end);
+                        completionTime[value] = std::chrono::steady_clock::now();
+                        queue.retireNext();
+                    }
+                });
+
+                std::chrono::nanoseconds wakeLatency{};
+                for (Orc::uint64 i = 1; i <= iterations; ++i)
+                {
+                    auto value = queue.signal();
+                    submitted.store(value, std::memory_order_release);
+                    queue.waitFor(value);
+                    wakeLatency += std::chrono::steady_clock::now() - completionTime[value];
+                }
+                gpu.join();
+
+                auto stats = queue.getWaitStats();
+                std::cout << "gpu " << gpuTime.count() << " us, " << toString(strategy) << ": wake latency "
+                    << wakeLatency.count() / 1000.0 / iterations << " us, blocked " << stats.blockedCount
+                    << ", spin resolved " << stats.spinResolvedCount << ", histogram (log2 us)";
+                for (auto count : stats.durationHistogram)
+                    std::cout << ' ' << count;
+                std::cout << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "OrcFrameLimiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Runs about a second of frames with random CPU work at several caps and reports the achieved rate
+// and how far individual frame intervals stray from the target.
+int main()
+{
+    try
+    {
+        for (double frameRate : { 30.0, 60.0, 144.0, 240.0, 1000.0 })
+        {
+            Orc::FrameLimiter limiter(frameRate);
+            std::mt19937 random(7);
+            std::uniform_real_distribution<double> workFraction(0.0, 0.6);
+            const auto frameCount = static_cast<Orc::uint32>(frameRate);
+            const double target = 1e6 / frameRate;
+
+            std::vector<double> intervals;
+            intervals.reserve(frameCount);
+            limiter.wait();
+            auto last = Orc::FrameLimiter::Clock::now();
+            auto start = last;
+            for (Orc::uint32 i = 0; i < frameCount; ++i)
+            {
+                auto workEnd = Orc::FrameLimiter::Clock::now() + std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double, std::micro>(target * workFraction(random)));
+                while (Orc::FrameLimiter::Clock::now() < workEnd);
+                limiter.wait();
+                auto now = Orc::FrameLimiter::Clock::now();
+                intervals.push_back(std::chrono::duration<double, std::micro>(now - last).count());
+                last = now;
+            }
+            double elapsed = std::chrono::duration<double>(last - start).count();
+
+            double absoluteError = 0;
+            for (auto interval : intervals)
+                absoluteError += std::abs(interval - target);
+            std::sort(intervals.begin(), intervals.end());
+            std::cout << "cap " << frameRate << " fps: achieved " << frameCount / elapsed << " fps, mean interval error "
+                << absoluteError / frameCount << " us, interval p1/p50/p99 " << intervals[frameCount / 100] << '/' << intervals[frameCount / 2]
+                << '/' << intervals[frameCount * 99 / 100] << " us, sleep overshoot estimate "
+                << limiter.getSleepOvershootEstimate().count() / 1000.0 << " us" << std::endl;
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "OrcFramePacer.h"
+#include "OrcPresentClock.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <random>
+
+namespace
+{
+    const char* toString(Orc::FramePacingMode mode)
+    {
+        switch (mode)
+        {
+        case Orc::FramePacingMode::FPM_FENCE:
+            return "fence";
+        case Orc::FramePacingMode::FPM_LATENCY_WAITABLE:
+            return "latency waitable";
+        case Orc::FramePacingMode::FPM_JUST_IN_TIME:
+            return "just in time";
+        }
+        return "unknown";
+    }
+}
+
+// Paces frames with a jittery CPU cost against a simulated 60 Hz display and reports the average time
+// from the start of a frame's CPU work, when input would be sampled, to its flip.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 frameCount = 10000;
+        const std::chrono::microseconds refreshInterval(16667);
+        const std::chrono::microseconds frameCosts[] = { std::chrono::microseconds(3000), std::chrono::microseconds(8000), std::chrono::microseconds(14000) };
+
+        for (auto frameCost : frameCosts)
+        {
+            for (auto mode : { Orc::FramePacingMode::FPM_FENCE, Orc::FramePacingMode::FPM_LATENCY_WAITABLE, Orc::FramePacingMode::FPM_JUST_IN_TIME })
+            {
+                for (Orc::uint32 maxFrameLatency : { 1u, 2u })
+                {
+                    if (mode == Orc::FramePacingMode::FPM_FENCE && maxFrameLatency > 1)
+                        continue;
+
+                    Orc::SimulatedPresentClock clock(refreshInterval, mode == Orc::FramePacingMode::FPM_FENCE ? 3 : maxFrameLatency);
+                    Orc::FramePacer pacer(&clock, mode, std::chrono::microseconds(1000));
+                    std::mt19937 random(42);
+                    std::uniform_int_distribution<std::int64_t> jitter(-500, 500);
+
+                    for (Orc::uint32 i = 0; i < frameCount; ++i)
+                    {
+                        pacer.beginFrame();
+                        clock.advance(frameCost + std::chrono::microseconds(jitter(random)));
+                        pacer.endFrame();
+                    }
+
+                    auto flipped = clock.getFlippedFrameCount();
+                    std::cout << "cost " << frameCost.count() / 1000.0 << " ms, " << toString(mode);
+                    if (mode != Orc::FramePacingMode::FPM_FENCE)
+                        std::cout << " (latency " << maxFrameLatency << ")";
+                    std::cout << ": input to flip " << std::chrono::duration<double, std::milli>(clock.getTotalLatency()).count() / flipped
+                        << " ms, missed vblanks " << clock.getMissedVblankCount() << " of " << flipped + clock.getMissedVblankCount() << std::endl;
+                }
+            }
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
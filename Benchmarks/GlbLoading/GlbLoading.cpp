@@ -0,0 +1,187 @@
+#include "OrcGltfLoader.h"
+
+#define TINYGLTF_IMPLEMENTATION
+#define TINYGLTF_NO_STB_IMAGE
+#define TINYGLTF_NO_STB_IMAGE_WRITE
+#define TINYGLTF_NO_EXTERNAL_IMAGE
+#include "tiny_gltf.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif
+
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // On Linux the resident set, mapped file pages included, with the peak reset before each path. On
+    // Windows private commit, which mapped files do not add to; its peak cannot be reset.
+    struct MemoryUsage
+    {
+        double currentMegabytes = 0;
+        double peakMegabytes = 0;
+    };
+
+    // Returns the usage since the previous call, then resets the peak.
+    MemoryUsage resetPeakMemoryUsage()
+    {
+        MemoryUsage usage;
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        usage.currentMegabytes = counters.PagefileUsage / double(1 << 20);
+        usage.peakMegabytes = counters.PeakPagefileUsage / double(1 << 20);
+#else
+        {
+            std::ifstream status("/proc/self/status");
+            std::string line;
+            while (std::getline(status, line))
+            {
+                if (line.starts_with("VmRSS:"))
+                    usage.currentMegabytes = std::stod(line.substr(6)) / 1024;
+                else if (line.starts_with("VmHWM:"))
+                    usage.peakMegabytes = std::stod(line.substr(6)) / 1024;
+            }
+        }
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+        return usage;
+    }
+
+    // Writes a gridSize x gridSize vertex grid with interleaved attributes and 32-bit indices as a .glb.
+    void writeGlb(const std::string& path, Orc::uint32 gridSize, Orc::uint64& vertexBytes, Orc::uint64& indexBytes)
+    {
+        std::vector<float> vertices;
+        vertices.reserve(size_t(gridSize) * gridSize * 8);
+        for (Orc::uint32 y = 0; y < gridSize; ++y)
+        {
+            for (Orc::uint32 x = 0; x < gridSize; ++x)
+            {
+                float u = static_cast<float>(x) / (gridSize - 1);
+                float v = static_cast<float>(y) / (gridSize - 1);
+                vertices.insert(vertices.end(), { u, 0.0f, v, 0.0f, 1.0f, 0.0f, u, v });
+            }
+        }
+        std::vector<Orc::uint32> indices;
+        indices.reserve(size_t(gridSize - 1) * (gridSize - 1) * 6);
+        for (Orc::uint32 y = 0; y + 1 < gridSize; ++y)
+        {
+            for (Orc::uint32 x = 0; x + 1 < gridSize; ++x)
+            {
+                Orc::uint32 i = y * gridSize + x;
+                indices.insert(indices.end(), { i, i + gridSize, i + 1, i + 1, i + gridSize, i + gridSize + 1 });
+            }
+        }
+        vertexBytes = vertices.size() * sizeof(float);
+        indexBytes = indices.size() * sizeof(Orc::uint32);
+
+        auto vertexCount = std::to_string(gridSize * gridSize);
+        std::string json = R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0}],)"
+            R"("meshes":[{"primitives":[{"attributes":{"POSITION":0,"NORMAL":1,"TEXCOORD_0":2},"indices":3}]}],)"
+            R"("buffers":[{"byteLength":)" + std::to_string(vertexBytes + indexBytes) + "}],"
+            R"("bufferViews":[{"buffer":0,"byteLength":)" + std::to_string(vertexBytes) + R"(,"byteStride":32},)"
+            R"({"buffer":0,"byteOffset":)" + std::to_string(vertexBytes) + R"(,"byteLength":)" + std::to_string(indexBytes) + "}],"
+            R"("accessors":[{"bufferView":0,"componentType":5126,"count":)" + vertexCount + R"(,"type":"VEC3","min":[0,0,0],"max":[1,0,1]},)"
+            R"({"bufferView":0,"byteOffset":12,"componentType":5126,"count":)" + vertexCount + R"(,"type":"VEC3"},)"
+            R"({"bufferView":0,"byteOffset":24,"componentType":5126,"count":)" + vertexCount + R"(,"type":"VEC2"},)"
+            R"({"bufferView":1,"componentType":5125,"count":)" + std::to_string(indices.size()) + R"(,"type":"SCALAR"}]})";
+        json.resize((json.size() + 3) & ~size_t(3), ' ');
+
+        auto writeUint32 = [](std::ofstream& file, Orc::uint32 value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        std::ofstream file(path, std::ios::binary);
+        writeUint32(file, 0x46546C67);
+        writeUint32(file, 2);
+        writeUint32(file, static_cast<Orc::uint32>(12 + 8 + json.size() + 8 + vertexBytes + indexBytes));
+        writeUint32(file, static_cast<Orc::uint32>(json.size()));
+        writeUint32(file, 0x4E4F534A);
+        file.write(json.data(), json.size());
+        writeUint32(file, static_cast<Orc::uint32>(vertexBytes + indexBytes));
+        writeUint32(file, 0x004E4942);
+        file.write(reinterpret_cast<const char*>(vertices.data()), vertexBytes);
+        file.write(reinterpret_cast<const char*>(indices.data()), indexBytes);
+    }
+
+    bool skipImage(tinygltf::Image*, const int, std::string*, std::string*, int, int, const unsigned char*, int, void*)
+    {
+        return true;
+    }
+
+    void report(const char* name, std::chrono::duration<double> elapsed, Orc::uint64 bytes, const MemoryUsage& before)
+    {
+        std::cout << name << ": " << elapsed.count() * 1e3 << " ms, " << bytes / elapsed.count() / (1 << 20) << " MB/s, peak memory +"
+            << resetPeakMemoryUsage().peakMegabytes - before.currentMegabytes << " MB" << std::endl;
+    }
+}
+
+// Loads a large .glb into a buffer standing in for an upload heap, through the memory-mapped GltfAsset
+// and through tinygltf's LoadBinaryFromFile, which reads the file into memory and copies every buffer
+// again. Reports throughput and how far each path raised memory use above where it started.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 gridSize = 2048;
+
+        auto path = (std::filesystem::temp_directory_path() / "OrcGlbLoading.glb").string();
+        Orc::uint64 vertexBytes;
+        Orc::uint64 indexBytes;
+        writeGlb(path, gridSize, vertexBytes, indexBytes);
+        auto bytes = vertexBytes + indexBytes;
+        std::cout << bytes / double(1 << 20) << " MB of geometry" << std::endl;
+
+        // Allocated and touched up front so it does not count against any path.
+        std::vector<Orc::uint8> upload(bytes, 1);
+
+        auto memory = resetPeakMemoryUsage();
+        auto start = std::chrono::steady_clock::now();
+        {
+            Orc::GltfAsset asset(path);
+            auto vertexView = asset.getBufferView(0);
+            auto indexView = asset.getBufferView(1);
+            std::memcpy(upload.data(), vertexView.data(), vertexView.size());
+            std::memcpy(upload.data() + vertexView.size(), indexView.data(), indexView.size());
+        }
+        report("mapped, buffer views copied", std::chrono::steady_clock::now() - start, bytes, memory);
+
+        memory = resetPeakMemoryUsage();
+        start = std::chrono::steady_clock::now();
+        {
+            Orc::GltfAsset asset(path);
+            std::vector<Orc::Submesh> submeshes;
+            Orc::BoundingBox bounds;
+            asset.decode(reinterpret_cast<Orc::Vertex*>(upload.data()), reinterpret_cast<Orc::uint32*>(upload.data() + vertexBytes), submeshes, bounds);
+        }
+        report("mapped, decoded", std::chrono::steady_clock::now() - start, bytes, memory);
+
+        memory = resetPeakMemoryUsage();
+        start = std::chrono::steady_clock::now();
+        {
+            tinygltf::TinyGLTF loader;
+            loader.SetImageLoader(skipImage, nullptr);
+            tinygltf::Model model;
+            std::string error;
+            std::string warning;
+            if (!loader.LoadBinaryFromFile(&model, &error, &warning, path))
+                throw std::runtime_error(error);
+            const auto& buffer = model.buffers[0].data;
+            for (const auto& view : model.bufferViews)
+                std::memcpy(upload.data() + view.byteOffset, buffer.data() + view.byteOffset, view.byteLength);
+        }
+        report("tinygltf LoadBinaryFromFile, buffer views copied", std::chrono::steady_clock::now() - start, bytes, memory);
+
+        std::filesystem::remove(path);
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "OrcGltfDocument.h"
+
+#define TINYGLTF_IMPLEMENTATION
+#define TINYGLTF_NO_STB_IMAGE
+#define TINYGLTF_NO_STB_IMAGE_WRITE
+#define TINYGLTF_NO_EXTERNAL_IMAGE
+#include "tiny_gltf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct AllocationStats
+    {
+        size_t count = 0;
+        size_t liveBytes = 0;
+        size_t peakBytes = 0;
+    };
+
+    AllocationStats gAllocations;
+}
+
+// Every allocation is prefixed with its size so the live total can be tracked.
+void* operator new(size_t size)
+{
+    auto block = static_cast<size_t*>(std::malloc(size + 16));
+    if (!block)
+        throw std::bad_alloc();
+    *block = size;
+    ++gAllocations.count;
+    gAllocations.liveBytes += size;
+    gAllocations.peakBytes = std::max(gAllocations.peakBytes, gAllocations.liveBytes);
+    return reinterpret_cast<char*>(block) + 16;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (!pointer)
+        return;
+    auto block = reinterpret_cast<size_t*>(static_cast<char*>(pointer) - 16);
+    gAllocations.liveBytes -= *block;
+    std::free(block);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* pointer) noexcept { operator delete(pointer); }
+void operator delete(void* pointer, size_t) noexcept { operator delete(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { operator delete(pointer); }
+
+namespace
+{
+    // A scene of many small meshes, with the names, materials and extras real exports carry.
+    std::string makeScene(Orc::uint32 meshCount, const std::string& bufferUri, Orc::uint32 bufferLength)
+    {
+        std::ostringstream json;
+        json << R"({"asset":{"version":"2.0","generator":"OrcGltfParsing"},"scene":0,"scenes":[{"name":"Scene","nodes":[)";
+        for (Orc::uint32 i = 0; i < meshCount; ++i)
+            json << (i ? "," : "") << i * 2;
+        json << R"(]}],"nodes":[)";
+        for (Orc::uint32 i = 0; i < meshCount; ++i)
+        {
+            json << (i ? "," : "") << R"({"name":"Group)" << i << R"(","children":[)" << i * 2 + 1 << R"(],"translation":[)"
+                << i % 100 << ",0," << i / 100 << R"(],"rotation":[0,0.382683,0,0.92388]},)"
+                << R"({"name":"Mesh)" << i << R"(","mesh":)" << i << R"(,"scale":[1.5,1.5,1.5],"extras":{"lod":[0,1,2],"tag":"static"}})";
+        }
+        json << R"(],"meshes":[)";
+        for (Orc::uint32 i = 0; i < meshCount; ++i)
+        {
+            json << (i ? "," : "") << R"({"name":"Mesh)" << i << R"(","primitives":[{"attributes":{"POSITION":)" << i * 4
+                << R"(,"NORMAL":)" << i * 4 + 1 << R"(,"TEXCOORD_0":)" << i * 4 + 2 << R"(},"indices":)" << i * 4 + 3
+                << R"(,"material":)" << i % 16 << R"(,"mode":4}]})";
+        }
+        json << R"(],"accessors":[)";
+        for (Orc::uint32 i = 0; i < meshCount; ++i)
+        {
+            json << (i ? "," : "")
+                << R"({"bufferView":0,"componentType":5126,"count":24,"type":"VEC3","min":[-0.5,-0.5,-0.5],"max":[0.5,0.5,0.5]},)"
+                << R"({"bufferView":0,"byteOffset":12,"componentType":5126,"count":24,"type":"VEC3"},)"
+                << R"({"bufferView":0,"byteOffset":24,"componentType":5126,"count":24,"type":"VEC2"},)"
+                << R"({"bufferView":1,"componentType":5123,"count":36,"type":"SCALAR"})";
+        }
+        json << R"(],"bufferViews":[{"buffer":0,"byteLength":768,"byteStride":32,"target":34962},{"buffer":0,"byteOffset":768,"byteLength":72,"target":34963}],)"
+            << R"("buffers":[{"uri":")" << bufferUri << R"(","byteLength":)" << bufferLength << "}],"
+            << R"("materials":[)";
+        for (Orc::uint32 i = 0; i < 16; ++i)
+            json << (i ? "," : "") << R"({"name":"Material)" << i << R"(","pbrMetallicRoughness":{"baseColorFactor":[0.8,0.8,0.8,1],"metallicFactor":0.1}})";
+        json << "]}";
+        return json.str();
+    }
+
+    bool skipImage(tinygltf::Image*, const int, std::string*, std::string*, int, int, const unsigned char*, int, void*)
+    {
+        return true;
+    }
+
+    void measure(const char* name, Orc::uint32 iterations, const std::function<void()>& parse)
+    {
+        std::chrono::duration<double> best = std::chrono::duration<double>::max();
+        AllocationStats allocations;
+        for (Orc::uint32 i = 0; i < iterations; ++i)
+        {
+            auto before = gAllocations;
+            gAllocations.count = 0;
+            gAllocations.peakBytes = gAllocations.liveBytes;
+            auto start = std::chrono::steady_clock::now();
+            parse();
+            best = std::min<std::chrono::duration<double>>(best, std::chrono::steady_clock::now() - start);
+            allocations.count = gAllocations.count;
+            allocations.peakBytes = gAllocations.peakBytes - before.liveBytes;
+        }
+        std::cout << "  " << name << ": " << best.count() * 1e3 << " ms, " << allocations.count << " allocations, peak "
+            << allocations.peakBytes / double(1 << 20) << " MB" << std::endl;
+    }
+
+    void compare(const std::string& name, const std::string& json, const std::string& baseDirectory, Orc::uint32 iterations)
+    {
+        std::cout << name << " (" << json.size() / double(1 << 20) << " MB of JSON)" << std::endl;
+        measure("Orc SAX parse", iterations, [&]
+        {
+            auto document = Orc::parseGltfJson(json.data(), json.size());
+            if (document.accessors.empty() && document.nodes.empty())
+                throw std::runtime_error("Nothing parsed");
+        });
+        measure("nlohmann::json DOM only", iterations, [&]
+        {
+            auto document = nlohmann::json::parse(json);
+            if (!document.is_object())
+                throw std::runtime_error("Nothing parsed");
+        });
+        measure("tinygltf LoadASCIIFromString", iterations, [&]
+        {
+            tinygltf::TinyGLTF loader;
+            loader.SetImageLoader(skipImage, nullptr);
+            tinygltf::Model model;
+            std::string error;
+            std::string warning;
+            if (!loader.LoadASCIIFromString(&model, &error, &warning, json.data(), static_cast<unsigned int>(json.size()), baseDirectory))
+                throw std::runtime_error(error);
+        });
+    }
+}
+
+// Parses a generated scene with tens of thousands of nodes and accessors, and any .gltf files given on
+// the command line, with the engine's SAX parser, with the nlohmann::json DOM that it replaces, and
+// with tinygltf, which builds that DOM before converting it. Reports the best time over several runs,
+// the number of allocations and the peak of live allocated bytes during the parse.
+int main(int argc, char** argv)
+{
+    try
+    {
+        constexpr Orc::uint32 meshCount = 20000;
+        constexpr Orc::uint32 bufferLength = 840;
+        constexpr Orc::uint32 iterations = 5;
+
+        auto directory = std::filesystem::temp_directory_path() / "OrcGltfParsing";
+        std::filesystem::create_directories(directory);
+        std::ofstream(directory / "scene.bin", std::ios::binary) << std::string(bufferLength, '\0');
+        compare("generated scene", makeScene(meshCount, "scene.bin", bufferLength), directory.string(), iterations);
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::ifstream file(argv[i], std::ios::binary);
+            std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            compare(argv[i], json, std::filesystem::path(argv[i]).parent_path().string(), iterations);
+        }
+        std::filesystem::remove_all(directory);
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "OrcJobSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Recursive fork/join with one job per call, so nearly all of the time is scheduling overhead.
+    Orc::uint64 fibonacci(Orc::JobSystem& jobSystem, Orc::uint32 n)
+    {
+        if (n < 2)
+            return n;
+        Orc::uint64 left = 0;
+        Orc::JobCounter counter;
+        jobSystem.run([&] { left = fibonacci(jobSystem, n - 1); }, &counter);
+        auto right = fibonacci(jobSystem, n - 2);
+        jobSystem.wait(counter);
+        return left + right;
+    }
+
+    float work(Orc::uint32 i)
+    {
+        float x = static_cast<float>(i);
+        for (Orc::uint32 k = 0; k < 64; ++k)
+            x = std::sqrt(x * 1.0001f + 1.0f);
+        return x;
+    }
+}
+
+// Measures the cost of a job on its own, flat and recursive, and how parallelFor scales from one
+// thread to every hardware thread.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 flatJobCount = 1 << 20;
+        constexpr Orc::uint32 fibonacciN = 25;
+        constexpr Orc::uint32 itemCount = 1 << 20;
+        constexpr Orc::uint32 iterations = 10;
+
+        Orc::uint32 maxThreads = std::thread::hardware_concurrency();
+        if (maxThreads == 0)
+            maxThreads = 1;
+
+        std::vector<float> results(itemCount);
+        double singleThreadTime = 0;
+        for (Orc::uint32 threadCount = 1; ; threadCount = threadCount * 2 < maxThreads ? threadCount * 2 : maxThreads)
+        {
+            Orc::JobSystem jobSystem(threadCount);
+
+            std::atomic<Orc::uint32> executed{ 0 };
+            Orc::JobCounter counter;
+            auto start = std::chrono::steady_clock::now();
+            for (Orc::uint32 i = 0; i < flatJobCount; ++i)
+                jobSystem.run([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            jobSystem.wait(counter);
+            std::chrono::duration<double, std::nano> flatTime = std::chrono::steady_clock::now() - start;
+
+            jobSystem.resetStats();
+            start = std::chrono::steady_clock::now();
+            auto fibonacciResult = fibonacci(jobSystem, fibonacciN);
+            std::chrono::duration<double, std::nano> fibonacciTime = std::chrono::steady_clock::now() - start;
+            auto fibonacciStats = jobSystem.getStats();
+
+            jobSystem.resetStats();
+            std::chrono::duration<double> forTime{};
+            for (Orc::uint32 i = 0; i < iterations; ++i)
+            {
+                start = std::chrono::steady_clock::now();
+                jobSystem.parallelFor(itemCount, [&results](Orc::uint32 begin, Orc::uint32 end)
+                {
+                    for (Orc::uint32 j = begin; j < end; ++j)
+                        results[j] = work(j);
+                });
+                forTime += std::chrono::steady_clock::now() - start;
+            }
+            auto forStats = jobSystem.getStats();
+            if (threadCount == 1)
+                singleThreadTime = forTime.count();
+
+            std::cout << threadCount << " threads: " << flatTime.count() / flatJobCount << " ns/job flat, "
+                << fibonacciTime.count() / fibonacciStats.executedCount << " ns/job recursive (fib " << fibonacciN << " = "
+                << fibonacciResult << ", " << fibonacciStats.stolenCount << " stolen), parallelFor "
+                << itemCount * double(iterations) / forTime.count() / 1e6 << " M items/s (x" << singleThreadTime / forTime.count()
+                << ", " << forStats.executedCount / iterations << " jobs per call)" << std::endl;
+
+            if (threadCount == maxThreads)
+                break;
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "OrcLodSelector.h"
+#include "OrcMeshSimplifier.h"
+#include "OrcTestMeshes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int FRAME_COUNT = 240;
+    constexpr int MESH_COUNT = 16;
+    constexpr float WORLD_SIZE = 2000.0f;
+
+    // A mesh of 1k to 64k triangles with the levels generateLods makes by default, each with a quarter of
+    // the triangles of the previous one.
+    Orc::Mesh makeMesh(std::mt19937& random)
+    {
+        Orc::Mesh mesh;
+        float size = std::uniform_real_distribution<float>(0.5f, 8.0f)(random);
+        for (Orc::uint32 axis = 0; axis < 3; ++axis)
+        {
+            mesh.bounds.min[axis] = -size * 0.5f;
+            mesh.bounds.max[axis] = size * 0.5f;
+        }
+        Orc::uint32 indexCount = 3 * (1u << std::uniform_int_distribution<int>(10, 16)(random));
+        mesh.submeshes.push_back({ 0, indexCount, -1 });
+        Orc::uint32 indexOffset = indexCount;
+        for (float error : Orc::LodSettings().levelErrors)
+        {
+            indexCount = indexCount / 12 * 3;
+            mesh.lods.push_back({ { { indexOffset, indexCount, -1 } }, error * size });
+            indexOffset += indexCount;
+        }
+        mesh.indexCount = indexOffset;
+        return mesh;
+    }
+
+    // A camera walking slowly across the world at head height, looking ahead and slightly down.
+    Orc::Camera getCamera(int frame)
+    {
+        Orc::Camera camera;
+        float t = static_cast<float>(frame) / FRAME_COUNT;
+        float eye[3] = { -WORLD_SIZE * 0.25f + t * WORLD_SIZE * 0.05f, 2.0f, -WORLD_SIZE * 0.25f + t * WORLD_SIZE * 0.04f };
+        float target[3] = { eye[0] + 100.0f, 0.0f, eye[2] + 80.0f };
+        std::copy(eye, eye + 3, camera.position);
+        Orc::Test::makeViewProjection(eye, target, 0.1f, 5000.0f, camera.viewProjection);
+        camera.verticalFov = std::numbers::pi_v<float> / 3.0f;
+        camera.viewportHeight = 1080;
+        return camera;
+    }
+
+    void populate(Orc::LodSelector& selector, const std::vector<Orc::Mesh>& meshes, Orc::uint32 entityCount)
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> coordinate(-WORLD_SIZE * 0.5f, WORLD_SIZE * 0.5f), scale(0.5f, 2.0f);
+        std::uniform_int_distribution<int> mesh(0, MESH_COUNT - 1);
+        for (Orc::uint32 i = 0; i < entityCount; ++i)
+        {
+            Orc::uint32 slot = selector.add(meshes[mesh(random)]);
+            float position[3] = { coordinate(random), 0.0f, coordinate(random) };
+            selector.setTransform(slot, position, scale(random));
+        }
+    }
+
+    struct Run
+    {
+        double milliseconds = 0;
+        Orc::uint64 visibleCount = 0;
+        Orc::uint64 triangleCount = 0;
+        Orc::uint64 maxTriangleCount = 0;
+        Orc::uint64 fullDetailTriangleCount = 0;
+        // Visible entities whose level changed from the previous frame.
+        Orc::uint64 changeCount = 0;
+        double relaxation = 0;
+        Orc::uint64 passCount = 0;
+    };
+
+    Run run(Orc::LodSelector& selector, const Orc::LodSelectionSettings& settings)
+    {
+        Run result;
+        std::vector<Orc::uint32> previous(selector.getCount());
+        for (int frame = 0; frame < FRAME_COUNT; ++frame)
+        {
+            auto camera = getCamera(frame);
+            auto start = std::chrono::steady_clock::now();
+            auto stats = selector.select(camera, settings);
+            result.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            result.visibleCount += stats.visibleCount;
+            result.triangleCount += stats.triangleCount;
+            result.maxTriangleCount = std::max(result.maxTriangleCount, stats.triangleCount);
+            result.fullDetailTriangleCount += stats.fullDetailTriangleCount;
+            result.relaxation += stats.relaxation;
+            result.passCount += stats.passCount;
+            for (Orc::uint32 slot = 0; slot < selector.getCount(); ++slot)
+            {
+                if (frame && selector.isVisible(slot) && selector.getLod(slot) != previous[slot])
+                    ++result.changeCount;
+                previous[slot] = selector.getLod(slot);
+            }
+        }
+        return result;
+    }
+
+    void report(const char* name, const Run& result, Orc::uint32 entityCount)
+    {
+        std::cout << "    " << name << ": " << result.milliseconds / FRAME_COUNT << " ms/frame, " << entityCount * double(FRAME_COUNT) / result.milliseconds / 1e3
+            << " M entities/s, " << result.visibleCount / FRAME_COUNT << " visible, " << result.triangleCount / FRAME_COUNT / 1e6 << " M triangles (max "
+            << result.maxTriangleCount / 1e6 << " M, " << result.fullDetailTriangleCount / FRAME_COUNT / 1e6 << " M at full detail), "
+            << double(result.changeCount) / FRAME_COUNT << " level changes/frame, relaxation " << result.relaxation / FRAME_COUNT << ", "
+            << double(result.passCount) / FRAME_COUNT << " passes/frame" << std::endl;
+    }
+}
+
+// Selects levels of detail for synthetic scenes of 100k to 1M entities scattered over a 2 km square,
+// seen by a camera walking through them, and reports the time per frame with SSE2 and without, how many
+// entities change level each frame with and without hysteresis, and how a triangle budget of two thirds of the
+// unbudgeted count is held.
+int main()
+{
+    try
+    {
+        std::mt19937 random(1);
+        std::vector<Orc::Mesh> meshes;
+        for (int i = 0; i < MESH_COUNT; ++i)
+            meshes.push_back(makeMesh(random));
+
+        for (Orc::uint32 entityCount : { 100000u, 250000u, 1000000u })
+        {
+            std::cout << entityCount << " entities" << std::endl;
+            Orc::LodSelectionSettings settings;
+
+            Orc::LodSelector scalar;
+            populate(scalar, meshes, entityCount);
+            scalar.setVectorized(false);
+            auto scalarRun = run(scalar, settings);
+            report("scalar", scalarRun, entityCount);
+
+            Orc::LodSelector vectorized;
+            populate(vectorized, meshes, entityCount);
+            auto vectorizedRun = run(vectorized, settings);
+            report("SSE2", vectorizedRun, entityCount);
+            Orc::uint32 mismatchCount = 0;
+            for (Orc::uint32 slot = 0; slot < entityCount; ++slot)
+                mismatchCount += scalar.getLod(slot) != vectorized.getLod(slot) || scalar.isVisible(slot) != vectorized.isVisible(slot);
+            if (mismatchCount)
+            {
+                std::cerr << "    " << mismatchCount << " entities differ between scalar and SSE2" << std::endl;
+                return 1;
+            }
+
+            Orc::LodSelector noHysteresis;
+            populate(noHysteresis, meshes, entityCount);
+            settings.hysteresis = 0.0f;
+            report("no hysteresis", run(noHysteresis, settings), entityCount);
+
+            Orc::LodSelector budgeted;
+            populate(budgeted, meshes, entityCount);
+            settings = Orc::LodSelectionSettings();
+            settings.triangleBudget = vectorizedRun.triangleCount / FRAME_COUNT * 2 / 3;
+            std::cout << "    budget of " << settings.triangleBudget / 1e6 << " M triangles" << std::endl;
+            report("budgeted", run(budgeted, settings), entityCount);
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "OrcGltfLoader.h"
+#include "OrcMeshOptimizer.h"
+#include "OrcMeshlet.h"
+#include "OrcTestMeshes.h"
+
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int CAMERA_COUNT = 64;
+    constexpr float ORIGIN[3] = { 0.0f, 0.0f, 0.0f };
+
+    struct NamedMesh
+    {
+        std::string name;
+        Orc::MeshData mesh;
+    };
+
+}
+
+// Builds meshlets for generated meshes and the .gltf and .glb files given on the command line, after
+// optimizing them as the cooker does, and reports how full the meshlets are. Then culls them with the
+// CPU reference from cameras around and close to each mesh, reporting the share culled by the frustum
+// and by normal cones and the culling rate.
+int main(int argc, char** argv)
+{
+    try
+    {
+        std::vector<NamedMesh> meshes;
+        meshes.push_back({ "Sphere 256x512", Orc::Test::makeSphere(256, 512) });
+        meshes.push_back({ "Terrain 512", Orc::Test::makeTerrain(512) });
+        for (int i = 1; i < argc; ++i)
+        {
+            try
+            {
+                Orc::GltfAsset asset(argv[i]);
+                meshes.push_back({ std::filesystem::path(argv[i]).filename().string(), asset.decode() });
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << argv[i] << ": " << e.what() << std::endl;
+            }
+        }
+
+        std::vector<float> coneWeights = { 0.0f, 0.25f, 1.0f };
+        for (auto& named : meshes)
+        {
+            auto& mesh = named.mesh;
+            Orc::optimizeMesh(mesh, Orc::MeshOptimizationSettings());
+            std::cout << named.name << ": " << mesh.vertices.size() << " vertices, " << mesh.indices.size() / 3 << " triangles" << std::endl;
+
+            float center[3], extent = 0.0f;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                center[axis] = (mesh.bounds.min[axis] + mesh.bounds.max[axis]) * 0.5f;
+                extent = std::max(extent, mesh.bounds.max[axis] - mesh.bounds.min[axis]);
+            }
+
+            for (float coneWeight : coneWeights)
+            {
+                Orc::MeshletSettings settings;
+                settings.coneWeight = coneWeight;
+                auto start = std::chrono::steady_clock::now();
+                auto meshlets = Orc::buildMeshlets(mesh.vertices, mesh.indices, mesh.submeshes, settings);
+                double buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                auto stats = Orc::analyzeMeshlets(meshlets, static_cast<Orc::uint32>(mesh.vertices.size()), settings);
+
+                // Cameras on a spiral around the mesh, alternating between far enough to see it whole and
+                // close enough to see part of it.
+                Orc::uint64 frustumCulled = 0, coneCulled = 0, tested = 0;
+                std::vector<Orc::uint32> visible;
+                std::chrono::nanoseconds cullTime{};
+                for (int camera = 0; camera < CAMERA_COUNT; ++camera)
+                {
+                    float t = (camera + 0.5f) / CAMERA_COUNT;
+                    float height = 1.0f - 2.0f * t, ring = std::sqrt(1.0f - height * height);
+                    float angle = camera * 2.4f;
+                    float distance = extent * (camera % 2 ? 2.0f : 0.75f);
+                    float eye[3] = { center[0] + std::cos(angle) * ring * distance, center[1] + height * distance, center[2] + std::sin(angle) * ring * distance };
+                    float viewProjection[16];
+                    Orc::Test::makeViewProjection(eye, ORIGIN, 0.01f, 100.0f, viewProjection);
+                    auto frustum = Orc::makeFrustum(viewProjection);
+
+                    visible.clear();
+                    auto cullStart = std::chrono::steady_clock::now();
+                    auto cull = Orc::cullMeshlets(meshlets, frustum, eye, visible);
+                    cullTime += std::chrono::steady_clock::now() - cullStart;
+                    frustumCulled += cull.frustumCulledCount;
+                    coneCulled += cull.coneCulledCount;
+                    tested += meshlets.meshlets.size();
+                }
+
+                double cullSeconds = std::chrono::duration<double>(cullTime).count();
+                std::cout << "    cone weight " << coneWeight << ": " << stats.meshletCount << " meshlets in " << buildTime << " ms, " << stats.vertexFill * 100
+                    << "% vertex and " << stats.triangleFill * 100 << "% triangle fill, " << stats.vertexDuplication << "x vertices" << std::endl;
+                std::cout << "        culled " << 100.0 * frustumCulled / tested << "% by frustum and " << 100.0 * coneCulled / tested << "% by cone, "
+                    << tested / cullSeconds / 1e6 << " M meshlets/s" << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "OrcCommandList.h"
+#include "OrcGraphicsDevice.h"
+#include "OrcJobSystem.h"
+#include "OrcParallelCommandRecorder.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 drawCount = 1 << 20;
+        constexpr Orc::uint32 chunkCount = 256;
+        constexpr Orc::uint32 drawsPerChunk = drawCount / chunkCount;
+        constexpr Orc::uint32 iterations = 20;
+
+        Orc::GraphicsSettings settings;
+        settings.backend = Orc::GraphicsBackendType::GBT_NULL;
+        // Each run below records on a job system of its own size, so the device's one stays idle.
+        Orc::JobSystem deviceJobSystem(1);
+        auto device = Orc::GraphicsDevice::create(nullptr, 0, 0, settings, &deviceJobSystem);
+
+        auto recordChunk = [](Orc::CommandListContext& context, Orc::uint32 chunkIndex)
+        {
+            context.setViewport(0, 0, 1920, 1080);
+            for (Orc::uint32 i = 0; i < drawsPerChunk; ++i)
+                context.drawIndexedInstanced(36, 1, (chunkIndex * drawsPerChunk + i) * 36, 0, 0);
+        };
+
+        Orc::uint32 maxThreads = std::thread::hardware_concurrency();
+        if (maxThreads == 0)
+            maxThreads = 1;
+        double singleThreadTime = 0;
+        for (Orc::uint32 threadCount = 1; ; threadCount = threadCount * 2 < maxThreads ? threadCount * 2 : maxThreads)
+        {
+            Orc::JobSystem jobSystem(threadCount);
+            Orc::ParallelCommandRecorder recorder(device.get(), &jobSystem);
+            device->executeCommandListContexts(recorder.record(Orc::CommandListType::CLT_GRAPHICS, chunkCount, recordChunk));
+
+            std::chrono::duration<double> recordTime{};
+            std::chrono::duration<double> submitTime{};
+            for (Orc::uint32 i = 0; i < iterations; ++i)
+            {
+                auto start = std::chrono::steady_clock::now();
+                const auto& contexts = recorder.record(Orc::CommandListType::CLT_GRAPHICS, chunkCount, recordChunk);
+                auto recorded = std::chrono::steady_clock::now();
+                device->executeCommandListContexts(contexts);
+                recordTime += recorded - start;
+                submitTime += std::chrono::steady_clock::now() - recorded;
+            }
+            if (threadCount == 1)
+                singleThreadTime = recordTime.count();
+
+            std::cout << threadCount << " threads: record " << drawCount * double(iterations) / recordTime.count() / 1e6 << " M draws/s (x"
+                << singleThreadTime / recordTime.count() << "), ordered submit " << drawCount * double(iterations) / submitTime.count() / 1e6
+                << " M draws/s" << std::endl;
+
+            if (threadCount == maxThreads)
+                break;
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "OrcFrameSnapshot.h"
+#include "OrcRenderThread.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace
+{
+    void busyWait(std::chrono::microseconds duration)
+    {
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end);
+    }
+}
+
+// Simulates and renders frames of fixed cost, first serially on one thread and then pipelined through
+// a RenderThread, and reports how much of the two stages overlapped.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 frameCount = 500;
+        const std::chrono::microseconds stageCosts[][2] = {
+            { std::chrono::microseconds(1000), std::chrono::microseconds(1000) },
+            { std::chrono::microseconds(500), std::chrono::microseconds(1500) },
+            { std::chrono::microseconds(1500), std::chrono::microseconds(500) },
+        };
+
+        for (const auto& cost : stageCosts)
+        {
+            auto simulationCost = cost[0];
+            auto renderCost = cost[1];
+
+            Orc::FrameSnapshot snapshot;
+            auto start = std::chrono::steady_clock::now();
+            for (Orc::uint32 i = 0; i < frameCount; ++i)
+            {
+                busyWait(simulationCost);
+                snapshot.frameNumber = i;
+                busyWait(renderCost);
+            }
+            std::chrono::duration<double> serialTime = std::chrono::steady_clock::now() - start;
+
+            Orc::RenderThreadStats stats;
+            start = std::chrono::steady_clock::now();
+            {
+                Orc::RenderThread renderThread([&](const Orc::FrameSnapshot&) { busyWait(renderCost); });
+                for (Orc::uint32 i = 0; i < frameCount; ++i)
+                {
+                    auto& next = renderThread.beginSnapshot();
+                    busyWait(simulationCost);
+                    next.frameNumber = i;
+                    renderThread.submitSnapshot();
+                }
+                renderThread.waitForIdle();
+                stats = renderThread.getStats();
+            }
+            std::chrono::duration<double> pipelinedTime = std::chrono::steady_clock::now() - start;
+
+            auto overlap = stats.simulationTime + stats.renderTime - stats.wallTime;
+            std::cout << "simulate " << simulationCost.count() << " us, render " << renderCost.count() << " us: serial "
+                << serialTime.count() * 1000 << " ms, pipelined " << pipelinedTime.count() * 1000 << " ms, overlapped frames "
+                << stats.overlappedFrameCount << '/' << stats.submittedFrameCount << ", overlap "
+                << std::chrono::duration<double, std::milli>(overlap).count() << " ms, main waited "
+                << std::chrono::duration<double, std::milli>(stats.mainWaitTime).count() << " ms" << std::endl;
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "OrcGltfLoader.h"
+#include "OrcMeshOptimizer.h"
+#include "OrcMeshSimplifier.h"
+#include "OrcTestMeshes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct NamedMesh
+    {
+        std::string name;
+        Orc::MeshData mesh;
+    };
+
+    Orc::uint64 getTriangleCount(const std::vector<Orc::Submesh>& submeshes)
+    {
+        Orc::uint64 indexCount = 0;
+        for (const auto& submesh : submeshes)
+            indexCount += submesh.indexCount;
+        return indexCount / 3;
+    }
+}
+
+// Generates a chain of levels of detail for generated meshes and the .gltf and .glb files given on the
+// command line, then optimizes them as the cooker does, and reports each level's triangles and error
+// and the time both steps take.
+int main(int argc, char** argv)
+{
+    try
+    {
+        std::vector<NamedMesh> meshes;
+        meshes.push_back({ "Sphere 256x512", Orc::Test::makeSphere(256, 512) });
+        meshes.push_back({ "Terrain 512", Orc::Test::makeTerrain(512) });
+        for (int i = 1; i < argc; ++i)
+        {
+            try
+            {
+                Orc::GltfAsset asset(argv[i]);
+                meshes.push_back({ std::filesystem::path(argv[i]).filename().string(), asset.decode() });
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << argv[i] << ": " << e.what() << std::endl;
+            }
+        }
+
+        for (auto& named : meshes)
+        {
+            auto& mesh = named.mesh;
+            auto triangleCount = getTriangleCount(mesh.submeshes);
+            auto start = std::chrono::steady_clock::now();
+            Orc::generateLods(mesh);
+            auto simplified = std::chrono::steady_clock::now();
+            Orc::optimizeMesh(mesh, Orc::MeshOptimizationSettings());
+            auto optimized = std::chrono::steady_clock::now();
+
+            std::cout << named.name << ": " << mesh.vertices.size() << " vertices, " << triangleCount << " triangles, " << mesh.lods.size()
+                << " levels simplified in " << std::chrono::duration<double, std::milli>(simplified - start).count() << " ms and optimized in "
+                << std::chrono::duration<double, std::milli>(optimized - simplified).count() << " ms" << std::endl;
+            float extent = 0.0f;
+            for (int axis = 0; axis < 3; ++axis)
+                extent = std::max(extent, mesh.bounds.max[axis] - mesh.bounds.min[axis]);
+            for (size_t level = 0; level < mesh.lods.size(); ++level)
+            {
+                auto levelTriangleCount = getTriangleCount(mesh.lods[level].submeshes);
+                std::cout << "    LOD " << level + 1 << ": " << levelTriangleCount << " triangles (" << 100.0 * levelTriangleCount / triangleCount
+                    << "%), error " << mesh.lods[level].error << " (" << 100.0f * mesh.lods[level].error / extent << "% of extent)" << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+    return 0;
+}
\ No newline at end of file
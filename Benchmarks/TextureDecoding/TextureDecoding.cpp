@@ -0,0 +1,126 @@
+#include "OrcGltfLoader.h"
+#include "OrcJobSystem.h"
+#include "OrcTextureDecoder.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Writes imageCount size x size PNGs, smooth gradients with some noise on top like a photo-sourced
+    // albedo, and a .gltf referencing them.
+    void writeModel(const std::filesystem::path& directory, Orc::uint32 imageCount, Orc::uint32 size)
+    {
+        std::filesystem::create_directories(directory);
+        std::string json = R"({"asset":{"version":"2.0"},"images":[)";
+        std::vector<Orc::uint8> pixels(size_t(size) * size * 4);
+        Orc::uint32 seed = 1;
+        for (Orc::uint32 image = 0; image < imageCount; ++image)
+        {
+            for (Orc::uint32 y = 0; y < size; ++y)
+            {
+                for (Orc::uint32 x = 0; x < size; ++x)
+                {
+                    seed = seed * 1664525 + 1013904223;
+                    auto noise = static_cast<int>(seed >> 29);
+                    auto* texel = &pixels[(size_t(y) * size + x) * 4];
+                    texel[0] = static_cast<Orc::uint8>(std::clamp(static_cast<int>(x * 255 / size) + noise, 0, 255));
+                    texel[1] = static_cast<Orc::uint8>(std::clamp(static_cast<int>(y * 255 / size) + noise, 0, 255));
+                    texel[2] = static_cast<Orc::uint8>(128 + 127 * std::sin((x + y + image * 37) * 0.02));
+                    texel[3] = 255;
+                }
+            }
+            auto name = "Texture" + std::to_string(image) + ".png";
+            if (!stbi_write_png((directory / name).string().c_str(), size, size, 4, pixels.data(), size * 4))
+                throw std::runtime_error("Cannot write " + name);
+            if (image)
+                json += ",";
+            json += R"({"uri":")" + name + R"(","mimeType":"image/png"})";
+        }
+        json += "]}";
+        std::ofstream(directory / "Model.gltf", std::ios::binary) << json;
+    }
+
+    void report(const char* name, std::chrono::duration<double> elapsed, Orc::uint32 threadCount, Orc::uint64 decodedBytes, std::chrono::duration<double> serial)
+    {
+        auto megabytesPerSecond = decodedBytes / elapsed.count() / (1 << 20);
+        std::cout << name << ": " << elapsed.count() * 1e3 << " ms, " << megabytesPerSecond << " MB/s, " << megabytesPerSecond / threadCount
+            << " MB/s per core, " << serial / elapsed << "x serial" << std::endl;
+    }
+}
+
+// Decodes the 40 PNG images of a model and generates their mips, first one after another on the calling
+// thread as tinygltf's stb_image callback does during a load, then with a TextureDecoder running a job
+// per image on job systems of increasing size. Throughput counts the RGBA8 bytes of the first levels.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 imageCount = 40;
+        constexpr Orc::uint32 imageSize = 1024;
+        auto directory = std::filesystem::temp_directory_path() / "OrcTextureDecoding";
+        writeModel(directory, imageCount, imageSize);
+
+        Orc::GltfAsset asset((directory / "Model.gltf").string());
+        Orc::uint64 encodedBytes = 0;
+        for (Orc::int32 i = 0; i < static_cast<Orc::int32>(imageCount); ++i)
+            encodedBytes += asset.getImage(i).size();
+        Orc::uint64 decodedBytes = Orc::uint64(imageCount) * imageSize * imageSize * 4;
+        std::cout << imageCount << " images, " << encodedBytes / double(1 << 20) << " MB of PNG, " << decodedBytes / double(1 << 20)
+            << " MB decoded" << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<Orc::TextureData> textures(imageCount);
+            for (Orc::int32 i = 0; i < static_cast<Orc::int32>(imageCount); ++i)
+            {
+                textures[i] = Orc::decodeImage(asset.getImage(i));
+                Orc::generateMips(textures[i]);
+            }
+        }
+        std::chrono::duration<double> serial = std::chrono::steady_clock::now() - start;
+        report("serial", serial, 1, decodedBytes, serial);
+
+        auto hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<Orc::uint32> threadCounts;
+        for (Orc::uint32 count = 1; count < hardwareThreads; count *= 2)
+            threadCounts.push_back(count);
+        threadCounts.push_back(hardwareThreads);
+
+        for (auto threadCount : threadCounts)
+        {
+            Orc::JobSystem jobSystem(threadCount);
+            std::vector<Orc::TextureData> textures(imageCount);
+            Orc::TextureDecoder decoder(&jobSystem);
+            start = std::chrono::steady_clock::now();
+            for (Orc::int32 i = 0; i < static_cast<Orc::int32>(imageCount); ++i)
+                decoder.decode(asset.getImage(i), textures[i]);
+            decoder.wait();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            auto name = "job per image, " + std::to_string(threadCount) + " threads";
+            report(name.c_str(), elapsed, threadCount, decodedBytes, serial);
+            auto stats = decoder.getStats();
+            std::cout << "    decode jobs " << std::chrono::duration<double, std::milli>(stats.decodeTime).count() << " ms at "
+                << stats.decodedBytes / std::chrono::duration<double>(stats.decodeTime).count() / (1 << 20) << " MB/s, mip jobs "
+                << std::chrono::duration<double, std::milli>(stats.mipTime).count() << " ms" << std::endl;
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+    return 0;
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "OrcDefines.h"
+#include "OrcGraphicsSettings.h"
 #include "OrcRoot.h"
 #include "OrcTypes.h"
 
@@ -12,16 +13,23 @@ namespace Orc
     class ApplicationContext
     {
     public:
-        ApplicationContext(const std::wstring& windowTitle, uint32 width, uint32 height);
+        // workerThreadCount sizes the job system that parallel command list recording and other engine work run
+        // on, including the calling thread. 0 uses every hardware thread.
+        ApplicationContext(const std::wstring& windowTitle, uint32 width, uint32 height, const GraphicsSettings& settings = GraphicsSettings(),
+            uint32 workerThreadCount = 0);
         ~ApplicationContext() {}
 
         Root* getRoot() const;
+        const GraphicsSettings& getGraphicsSettings() const { return mGraphicsSettings; }
+        // Switches between vsync, uncapped and capped presentation while rendering.
+        void setPresentMode(PresentMode mode, uint32 frameRateCap = 60);
 
         ORC_DISABLE_COPY_AND_MOVE(ApplicationContext)
     private:
         std::wstring mWindowTitle;
         uint32 mWidth;
         uint32 mHeight;
+        GraphicsSettings mGraphicsSettings;
 
         std::shared_ptr<void> mRoot;
     };
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "OrcTypes.h"
+
+namespace Orc
+{
+    // The view a scene manager selects levels of detail for.
+    struct Camera
+    {
+        float position[3] = { 0.0f, 0.0f, 0.0f };
+        // Row-major view-projection that transforms row vectors, with depth mapped to [0, 1] as in Direct3D.
+        float viewProjection[16] = {
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f,
+        };
+        // Vertical field of view in radians and the height of the viewport it covers, in pixels.
+        float verticalFov = 1.0471976f;
+        uint32 viewportHeight = 1080;
+
+        bool operator==(const Camera& other) const = default;
+    };
+}
\ No newline at end of file
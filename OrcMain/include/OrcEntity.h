@@ -3,17 +3,51 @@
 #include "OrcDefines.h"
 #include "OrcTypes.h"
 
+#include <atomic>
+#include <memory>
+
 namespace Orc
 {
+    class SceneManager;
+
     class Entity
     {
     public:
+        const String& getName() const { return mName; }
+        // False until the entity's geometry has been uploaded to the GPU.
+        bool isReady() const { return mReady.load(std::memory_order_acquire); }
+
+        // Places the entity's mesh in the scene, uniformly scaled.
+        void setPosition(float x, float y, float z);
+        void setScale(float scale);
+        const float* getPosition() const { return mPosition; }
+        float getScale() const { return mScale; }
+        // Level of detail selected for the last frame built, 0 being full detail, and whether the entity
+        // was in the camera's frustum then.
+        uint32 getLod() const;
+        bool isVisible() const;
 
         ORC_DISABLE_COPY_AND_MOVE(Entity)
     protected:
         Entity(const String entName);
         ~Entity() {}
 
+        void _updateTransform();
+
+        static constexpr uint32 NO_LOD_SLOT = 0xFFFFFFFF;
+
         String mName;
+        // Cleared when the entity is removed from its scene manager.
+        SceneManager* mSceneManager = nullptr;
+        std::atomic<bool> mReady{ false };
+        // The uploaded Mesh, which releases its buffers when the entity is destroyed.
+        std::shared_ptr<void> mMesh;
+        float mPosition[3] = { 0.0f, 0.0f, 0.0f };
+        float mScale = 1.0f;
+        // Slot in its scene manager's LOD selector once ready.
+        uint32 mLodSlot = NO_LOD_SLOT;
+
+        friend class EntityLoader;
+        friend class SceneManager;
     };
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+
+namespace Orc
+{
+    class Entity;
+
+    enum class LoadState
+    {
+        // Waiting for a free load slot.
+        LS_QUEUED,
+        LS_READING,
+        LS_DECODING,
+        // Copying the geometry to GPU memory on the copy queue.
+        LS_UPLOADING,
+        LS_READY,
+        LS_FAILED,
+    };
+
+    // How glTF files become meshes. Each option decodes the geometry through an extra copy instead of
+    // straight into the upload buffer, so all are off by default; MeshCooker applies them offline.
+    struct MeshImportSettings
+    {
+        // Reorders triangles and vertices for the vertex cache, overdraw and vertex fetch.
+        bool optimize = false;
+        // Splits each primitive into meshlets with bounding spheres and normal cones for cluster culling,
+        // also for .orcmesh files cooked without them.
+        bool buildMeshlets = false;
+        // Simplifies glTF geometry into a chain of levels of detail sharing its vertices. .orcmesh files
+        // keep the levels they were cooked with.
+        bool generateLods = false;
+    };
+
+    // Progress of an entity whose geometry streams in over several frames, as returned by
+    // SceneManager::createEntityAsync. The entity exists, unready, from the start. State, progress and
+    // priority may be used from any thread.
+    class EntityLoad
+    {
+    public:
+        Entity* getEntity() const { return mEntity; }
+        LoadState getState() const { return mState.load(std::memory_order_acquire); }
+        bool isReady() const { return getState() == LoadState::LS_READY; }
+        bool isFinished() const { return getState() == LoadState::LS_READY || getState() == LoadState::LS_FAILED; }
+        // Between 0 and 1, advancing as the load moves through its states.
+        float getProgress() const { return mProgress.load(std::memory_order_relaxed); }
+        // Why the load failed; empty unless the state is LS_FAILED.
+        const String& getError() const { return mError; }
+
+        // Queued loads with a higher priority start first, and equal priorities start in creation order.
+        // Has no effect once the load has started.
+        void setPriority(int32 priority) { mPriority.store(priority, std::memory_order_relaxed); }
+        int32 getPriority() const { return mPriority.load(std::memory_order_relaxed); }
+
+        ORC_DISABLE_COPY_AND_MOVE(EntityLoad)
+    protected:
+        EntityLoad(Entity* entity, int32 priority) : mEntity(entity), mPriority(priority) {}
+        ~EntityLoad() {}
+
+        Entity* mEntity;
+        std::atomic<LoadState> mState{ LoadState::LS_QUEUED };
+        std::atomic<float> mProgress{ 0.0f };
+        std::atomic<int32> mPriority;
+        String mError;
+
+        friend class EntityLoader;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "OrcTypes.h"
+
+namespace Orc
+{
+    enum class GraphicsBackendType
+    {
+        GBT_D3D12,
+        GBT_NULL,
+    };
+
+    enum class WaitStrategy
+    {
+        // Parks the thread on the fence event right away.
+        WS_BLOCK,
+        // Polls the fence for up to waitSpinMicroseconds before parking on the event.
+        WS_SPIN_THEN_BLOCK,
+        // Polls the fence and yields the time slice between polls, never parking.
+        WS_YIELD,
+    };
+
+    enum class FramePacingMode
+    {
+        // The CPU only waits when it is about to reuse a back buffer the GPU may still be using.
+        FPM_FENCE,
+        // The CPU waits on the swap chain's frame latency waitable before each frame, so at most
+        // maxFrameLatency frames are queued for display.
+        FPM_LATENCY_WAITABLE,
+        // Like FPM_LATENCY_WAITABLE, then delays the start of the frame so it finishes just before the
+        // next vblank, minimizing the time from input sampling to display.
+        FPM_JUST_IN_TIME,
+    };
+
+    enum class PresentMode
+    {
+        // Presents on vertical blank.
+        PM_VSYNC,
+        // Presents immediately, tearing where the display and driver allow it.
+        PM_UNCAPPED,
+        // Like PM_UNCAPPED, with the frame rate held at frameRateCap by a CPU frame limiter.
+        PM_CAPPED,
+    };
+
+    struct GraphicsSettings
+    {
+#ifdef _WIN32
+        GraphicsBackendType backend = GraphicsBackendType::GBT_D3D12;
+#else
+        GraphicsBackendType backend = GraphicsBackendType::GBT_NULL;
+#endif
+        // How the CPU waits for fences, e.g. before reusing a back buffer. WS_SPIN_THEN_BLOCK trades a
+        // little CPU time for lower wake latency on short waits.
+        WaitStrategy waitStrategy = WaitStrategy::WS_BLOCK;
+        uint32 waitSpinMicroseconds = 50;
+        // Swap chain buffers. More buffers let the GPU render ahead of the display at the cost of memory.
+        uint32 backBufferCount = 3;
+        // Frames the CPU may record before waiting for the GPU to finish the oldest one. Per-frame
+        // resources are sized by this count, independent of the back buffer count.
+        uint32 framesInFlight = 2;
+        PresentMode presentMode = PresentMode::PM_VSYNC;
+        uint32 frameRateCap = 60;
+        // FPM_LATENCY_WAITABLE and FPM_JUST_IN_TIME lower input latency; the default keeps the swap chain
+        // as it was before pacing modes existed.
+        FramePacingMode framePacingMode = FramePacingMode::FPM_FENCE;
+        // Frames that may be queued for display with the waitable pacing modes, independent of the back
+        // buffer count.
+        uint32 maxFrameLatency = 2;
+        // Headroom FPM_JUST_IN_TIME keeps between the predicted end of a frame and the vblank.
+        uint32 justInTimeMarginMicroseconds = 1000;
+    };
+}
\ No newline at end of file
@@ -1,25 +1,96 @@
 #pragma once
 
+#include "OrcCamera.h"
 #include "OrcDefines.h"
 #include "OrcEntity.h"
+#include "OrcEntityLoad.h"
 #include "OrcTypes.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 namespace Orc
 {
+    class LodSelector;
+    class Root;
+    struct SceneSnapshot;
+
+    struct LodSelectionSettings
+    {
+        // Largest error, in pixels, a level of detail may project to before a finer one is drawn.
+        float pixelError = 1.0f;
+        // Fraction by which the projected error has to pass pixelError before an entity changes level, so
+        // entities hovering at a threshold do not pop back and forth.
+        float hysteresis = 0.25f;
+        // Triangles the visible entities may add up to, or 0 for no budget. Exceeding it raises the error
+        // allowed up to maxRelaxation times pixelError.
+        uint64 triangleBudget = 0;
+        float maxRelaxation = 64.0f;
+    };
+
+    struct LodSelectionStats
+    {
+        uint32 entityCount = 0;
+        uint32 visibleCount = 0;
+        uint64 triangleCount = 0;
+        // Triangles the visible entities would draw at full detail.
+        uint64 fullDetailTriangleCount = 0;
+        // Factor the triangle budget raised pixelError by, 1 while within it.
+        float relaxation = 1.0f;
+        uint32 passCount = 0;
+    };
+
     class SceneManager
     {
     public:
+        // Loads the entity's glTF or cooked .orcmesh file before returning. Throws OrcException if it cannot be loaded.
         Entity* createEntity(const String& entityName, const String& filePath);
+        // Returns at once with an entity that becomes ready once its geometry has been read, decoded and
+        // copied to the GPU over the following frames. Higher priorities are loaded first.
+        std::shared_ptr<EntityLoad> createEntityAsync(const String& entityName, const String& filePath, int32 priority = 0);
         void destroyEntity(Entity* ent);
+
+        // Marks the scene as changed so on-demand rendering draws a new frame. Safe to call from any thread.
+        void invalidate();
+        uint64 getGeneration() const { return mGeneration.load(std::memory_order_acquire); }
+
+        // Each frame, before its snapshot is built, every ready entity gets the level of detail this camera
+        // needs. Invalidates the scene if the camera changed, so on-demand rendering selects them again.
+        void setCamera(const Camera& camera);
+        const Camera& getCamera() const { return mCamera; }
+        void setLodSelectionSettings(const LodSelectionSettings& settings) { mLodSelectionSettings = settings; invalidate(); }
+        const LodSelectionSettings& getLodSelectionSettings() const { return mLodSelectionSettings; }
+        // Of the last frame built.
+        const LodSelectionStats& getLodSelectionStats() const { return mLodSelectionStats; }
+
         ORC_DISABLE_COPY_AND_MOVE(SceneManager)
     protected:
-        SceneManager(const String& sceneManagerName) : mName(sceneManagerName) {}
-        ~SceneManager() {}
+        SceneManager(Root* root, const String& sceneManagerName);
+        ~SceneManager();
+
+        std::shared_ptr<EntityLoad> _loadEntity(const String& entityName, const String& filePath, int32 priority, bool immediate);
+        // Called once the entity's mesh is uploaded.
+        void _addToLodSelection(Entity* entity);
+        void _selectLods();
+        void _buildSnapshot(SceneSnapshot& snapshot) const;
 
+        Root* mRoot;
         String mName;
         std::vector<std::shared_ptr<Entity>> mEntities;
+
+        std::atomic<uint64> mGeneration{ 0 };
+        uint64 mRenderedGeneration = 0;
+
+        Camera mCamera;
+        LodSelectionSettings mLodSelectionSettings;
+        LodSelectionStats mLodSelectionStats;
+        std::unique_ptr<LodSelector> mLodSelector;
+        // The entity in each slot of the selector.
+        std::vector<Entity*> mLodEntities;
+
+        friend class Entity;
+        friend class EntityLoader;
+        friend class Root;
     };
 }
\ No newline at end of file
@@ -1,18 +1,88 @@
 #pragma once
 
 #include "OrcDefines.h"
+#include "OrcGraphicsSettings.h"
 #include "OrcManager.h"
 #include "OrcTypes.h"
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace Orc
 {
+    class AsyncScheduler;
+    class EntityLoader;
+    struct FrameSnapshot;
+
+    enum class RenderMode
+    {
+        // Renders whenever no window message is pending.
+        RM_CONTINUOUS,
+        // Sleeps until input arrives, a scene manager changes or invalidate() is called, then renders one frame.
+        RM_ON_DEMAND,
+    };
+
+    struct RenderThreadStats
+    {
+        uint64 submittedFrameCount = 0;
+        uint64 renderedFrameCount = 0;
+        // Frames whose simulation finished while the render thread was still submitting an earlier frame.
+        uint64 overlappedFrameCount = 0;
+        // Main thread time spent building snapshots and render thread time spent submitting them. Their
+        // sum exceeds wallTime by the time both threads were busy at once.
+        std::chrono::nanoseconds simulationTime{};
+        std::chrono::nanoseconds renderTime{};
+        std::chrono::nanoseconds wallTime{};
+        // Time the main thread waited for the render thread to take a snapshot, and the render thread idled.
+        std::chrono::nanoseconds mainWaitTime{};
+        std::chrono::nanoseconds renderWaitTime{};
+    };
+
     class Root
     {
     public:
+        using FrameStartedCallback = std::function<void(uint64 frameNumber)>;
+
         void startRendering();
+        // Resumes coroutines whose fence or file read completed, runs the frame started callback and
+        // builds the frame snapshot on the calling thread, then renders it, or hands it to the render
+        // thread when enabled.
+        void renderOneFrame();
+        void queueEndRendering();
+
+        void setPresentMode(PresentMode mode, uint32 frameRateCap);
+
+        // Scene updates belong in this callback; it runs on the main thread before each frame's snapshot.
+        void setFrameStartedCallback(FrameStartedCallback callback) { mFrameStartedCallback = std::move(callback); }
+
+        // Moves GPU submission to a dedicated thread that renders frame snapshots while the main thread
+        // simulates the next frame.
+        void setRenderThreadEnabled(bool enabled);
+        bool isRenderThreadEnabled() const { return mRenderThread != nullptr; }
+        RenderThreadStats getRenderThreadStats() const;
+
+        void setRenderMode(RenderMode mode) { mRenderMode = mode; }
+        RenderMode getRenderMode() const { return mRenderMode; }
+        // Requests a frame in on-demand mode. Safe to call from any thread.
+        void invalidate();
+        uint64 getRenderedFrameCount() const { return mRenderedFrameCount; }
+
+        // While the window is minimized or its output occluded, the loop submits no GPU work and only
+        // checks visibility this often, or as soon as a window message arrives.
+        void setOcclusionProbeInterval(uint32 milliseconds) { mOcclusionProbeIntervalMilliseconds = milliseconds; }
+        bool isThrottled() const;
+        uint64 getOcclusionProbeCount() const { return mOcclusionProbeCount; }
+
+        // Entities created with createEntityAsync beyond this many wait in a queue until a load finishes.
+        void setMaxConcurrentEntityLoads(uint32 count);
+        uint32 getPendingEntityLoadCount() const;
+        // Applies to entity loads started afterwards.
+        void setMeshImportSettings(const MeshImportSettings& settings);
+        const MeshImportSettings& getMeshImportSettings() const;
 
         SceneManager* createSceneManager(const String& sceneManagerName);
         void destrotSceneManager(SceneManager* sceneManager)
@@ -22,6 +92,7 @@ namespace Orc
                 if (sceneManager == it->get())
                 {
                     mSceneManagers.erase(it);
+                    invalidate();
                     break;
                 }
             }
@@ -29,14 +100,47 @@ namespace Orc
 
         ORC_DISABLE_COPY_AND_MOVE(Root)
     protected:
-        Root(void* handle, uint32 w, uint32 h);
+        // The job system runs workerThreadCount threads including the one creating the root, which becomes
+        // its main thread. 0 uses every hardware thread.
+        Root(void* handle, uint32 w, uint32 h, const GraphicsSettings& settings, uint32 workerThreadCount);
 
-        ~Root() = default;
+        ~Root();
+
+        bool _processMessages();
+        bool _consumeInvalidation();
+        // Returns false if the wait timed out.
+        bool _waitForInvalidation(uint32 timeoutMilliseconds);
+        void _throttle();
+        void _buildSnapshot(FrameSnapshot& snapshot);
+        void _renderSnapshot(const FrameSnapshot& snapshot);
+        AsyncScheduler* _getAsyncScheduler() const { return static_cast<AsyncScheduler*>(mAsyncScheduler.get()); }
+        EntityLoader* _getEntityLoader() const { return static_cast<EntityLoader*>(mEntityLoader.get()); }
 
         uint32 mWidthForSwapChain;
         uint32 mHeightForSwapChain;
+        std::atomic<bool> mQueuedEndRendering{ false };
+
+        RenderMode mRenderMode = RenderMode::RM_CONTINUOUS;
+        std::atomic<bool> mInvalidated{ true };
+        uint64 mRenderedFrameCount = 0;
 
+        bool mMinimized = false;
+        uint32 mOcclusionProbeIntervalMilliseconds = 100;
+        uint64 mOcclusionProbeCount = 0;
+
+        // Parallel command recording, texture decoding and async jobs run on it, so it outlives their owners.
+        std::shared_ptr<void> mJobSystem;
         std::shared_ptr<void> mGraphicsDevice;
+        std::shared_ptr<void> mInvalidateEvent;
+        std::shared_ptr<void> mRenderThread;
+        std::shared_ptr<void> mInlineSnapshot;
+        // Load jobs call into the loader, so it outlives the scheduler, which waits for them.
+        std::shared_ptr<void> mEntityLoader;
+        // Declared after the graphics device and the event it wakes, so it is destroyed first.
+        std::shared_ptr<void> mAsyncScheduler;
+        FrameStartedCallback mFrameStartedCallback;
         std::vector<std::shared_ptr<SceneManager>> mSceneManagers;
+
+        friend class SceneManager;
     };
 }
\ No newline at end of file
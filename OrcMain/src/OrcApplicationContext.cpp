@@ -2,14 +2,23 @@
 
 #include "OrcApplicationContext.h"
 #include "OrcDetail.h"
+#include "OrcException.h"
 
 #include <memory>
 
 namespace Orc
 {
-    ApplicationContext::ApplicationContext(const std::wstring& windowTitle, uint32 width, uint32 height) : mWindowTitle(windowTitle),
-        mWidth(width), mHeight(height)
+    ApplicationContext::ApplicationContext(const std::wstring& windowTitle, uint32 width, uint32 height, const GraphicsSettings& settings,
+        uint32 workerThreadCount) : mWindowTitle(windowTitle),
+        mWidth(width), mHeight(height), mGraphicsSettings(settings)
     {
+        if (settings.backend == GraphicsBackendType::GBT_NULL)
+        {
+            mRoot = std::make_shared<detail::Root>(nullptr, mWidth, mHeight, settings, workerThreadCount);
+            return;
+        }
+
+#ifdef _WIN32
         WNDCLASSEXW wcex{};
         wcex.cbSize = sizeof(WNDCLASSEXW);
         wcex.style = CS_HREDRAW | CS_VREDRAW;
@@ -28,7 +37,19 @@ namespace Orc
         auto hwnd = CreateWindowExW(0, L"Orc", mWindowTitle.c_str(), stype, CW_USEDEFAULT, CW_USEDEFAULT, rc.right - rc.left, rc.bottom - rc.top, nullptr, nullptr, wcex.hInstance, nullptr);
         ShowWindow(hwnd, SW_SHOWDEFAULT);
 
-        mRoot = std::make_shared<detail::Root>(&hwnd, mWidth, mHeight);
+        auto root = std::make_shared<detail::Root>(&hwnd, mWidth, mHeight, settings, workerThreadCount);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(root.get()));
+        mRoot = root;
+#else
+        throw OrcException("Windowed rendering is not supported on this platform");
+#endif
+    }
+
+    void ApplicationContext::setPresentMode(PresentMode mode, uint32 frameRateCap)
+    {
+        getRoot()->setPresentMode(mode, frameRateCap);
+        mGraphicsSettings.presentMode = mode;
+        mGraphicsSettings.frameRateCap = frameRateCap;
     }
 
     Root* ApplicationContext::getRoot() const
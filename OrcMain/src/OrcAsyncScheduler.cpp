@@ -0,0 +1,193 @@
+#include "OrcAsyncScheduler.h"
+#include "OrcException.h"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+namespace Orc
+{
+    bool FenceAwaitable::await_ready()
+    {
+        ++mScheduler->mStats.fenceWaitCount;
+        if (!mQueue->isComplete(mValue))
+            return false;
+        ++mScheduler->mStats.fenceReadyCount;
+        return true;
+    }
+
+    void FenceAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        mScheduler->_addFenceWait(mQueue, mValue, handle);
+    }
+
+    void FileReadAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        mScheduler->_startRead(this, handle);
+    }
+
+    std::vector<uint8> FileReadAwaitable::await_resume()
+    {
+        if (mException)
+            std::rethrow_exception(mException);
+        mScheduler->mStats.bytesRead += mData.size();
+        return std::move(mData);
+    }
+
+    void JobAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        mScheduler->_startJob(this, handle);
+    }
+
+    void JobAwaitable::await_resume()
+    {
+        if (mException)
+            std::rethrow_exception(mException);
+    }
+
+    void YieldAwaitable::await_suspend(std::coroutine_handle<> handle)
+    {
+        mScheduler->_enqueueReady(handle);
+    }
+
+    AsyncScheduler::AsyncScheduler(JobSystem* jobSystem) : mJobSystem(jobSystem)
+    {
+    }
+
+    AsyncScheduler::~AsyncScheduler()
+    {
+        // Reads and jobs write into the frames of their coroutines, which are destroyed with the tasks.
+        mJobSystem->wait(mJobCounter);
+    }
+
+    void AsyncScheduler::spawn(Task<void> task)
+    {
+        ++mStats.spawnedCount;
+        auto handle = task.getHandle();
+        mTasks.push_back(std::move(task));
+        handle.resume();
+    }
+
+    uint32 AsyncScheduler::poll()
+    {
+        // Without worker threads nothing else would ever run the reads and jobs. One per poll keeps a
+        // burst of them from stalling a single frame.
+        if (mJobSystem->getThreadCount() == 1 && !mJobCounter.isDone())
+            mJobSystem->tryRunJob();
+
+        // Coroutines made ready while resuming wait for the next poll, so a yield loop cannot starve the frame.
+        {
+            std::lock_guard<std::mutex> lock(mReadyMutex);
+            mResuming.swap(mReady);
+        }
+        for (auto it = mFenceWaits.begin(); it != mFenceWaits.end();)
+        {
+            if (it->queue->isComplete(it->value))
+            {
+                mResuming.push_back(it->handle);
+                it = mFenceWaits.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        auto resumed = static_cast<uint32>(mResuming.size());
+        for (auto handle : mResuming)
+            handle.resume();
+        mResuming.clear();
+        mStats.resumedCount += resumed;
+
+        std::exception_ptr exception;
+        auto completed = std::remove_if(mTasks.begin(), mTasks.end(), [&](const Task<void>& task)
+        {
+            if (!task.isDone())
+                return false;
+            try
+            {
+                task.getHandle().promise().takeResult();
+            }
+            catch (...)
+            {
+                if (!exception)
+                    exception = std::current_exception();
+            }
+            return true;
+        });
+        mStats.completedCount += mTasks.end() - completed;
+        mTasks.erase(completed, mTasks.end());
+
+        if (exception)
+            std::rethrow_exception(exception);
+        return resumed;
+    }
+
+    void AsyncScheduler::wait()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mReadyMutex);
+            if (!mReady.empty())
+                return;
+        }
+        if (!mFenceWaits.empty())
+            mFenceWaits.front().queue->waitFor(mFenceWaits.front().value);
+        // Without worker threads the reads and jobs only run in poll.
+        else if (mJobSystem->getThreadCount() > 1 && !mJobCounter.isDone())
+            mReadyEvent.wait();
+    }
+
+    void AsyncScheduler::_addFenceWait(Queue* queue, uint64 value, std::coroutine_handle<> handle)
+    {
+        mFenceWaits.push_back({ queue, value, handle });
+    }
+
+    void AsyncScheduler::_startRead(FileReadAwaitable* read, std::coroutine_handle<> handle)
+    {
+        ++mStats.fileReadCount;
+        mJobSystem->run([this, read, handle]
+        {
+            try
+            {
+                std::ifstream file(read->mPath, std::ios::binary | std::ios::ate);
+                if (!file)
+                    throw OrcException("Failed to open " + read->mPath);
+                read->mData.resize(static_cast<size_t>(file.tellg()));
+                file.seekg(0);
+                if (!file.read(reinterpret_cast<char*>(read->mData.data()), read->mData.size()))
+                    throw OrcException("Failed to read " + read->mPath);
+            }
+            catch (...)
+            {
+                read->mException = std::current_exception();
+            }
+            _enqueueReady(handle);
+        }, &mJobCounter);
+    }
+
+    void AsyncScheduler::_startJob(JobAwaitable* job, std::coroutine_handle<> handle)
+    {
+        ++mStats.jobCount;
+        mJobSystem->run([this, job, handle]
+        {
+            try
+            {
+                job->mFunction();
+            }
+            catch (...)
+            {
+                job->mException = std::current_exception();
+            }
+            _enqueueReady(handle);
+        }, &mJobCounter);
+    }
+
+    void AsyncScheduler::_enqueueReady(std::coroutine_handle<> handle)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mReadyMutex);
+            mReady.push_back(handle);
+        }
+        mReadyEvent.set();
+        if (mWake)
+            mWake();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcEvent.h"
+#include "OrcJobSystem.h"
+#include "OrcQueue.h"
+#include "OrcTask.h"
+#include "OrcTypes.h"
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Orc
+{
+    class AsyncScheduler;
+
+    struct AsyncSchedulerStats
+    {
+        uint64 spawnedCount = 0;
+        uint64 completedCount = 0;
+        uint64 resumedCount = 0;
+        uint64 fenceWaitCount = 0;
+        // Fence waits that had already completed when awaited, so the coroutine never suspended.
+        uint64 fenceReadyCount = 0;
+        uint64 fileReadCount = 0;
+        uint64 bytesRead = 0;
+        uint64 jobCount = 0;
+    };
+
+    // Resumes the awaiting coroutine once queue reaches value.
+    class FenceAwaitable
+    {
+    public:
+        FenceAwaitable(AsyncScheduler* scheduler, Queue* queue, uint64 value) : mScheduler(scheduler), mQueue(queue), mValue(value) {}
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() {}
+    private:
+        AsyncScheduler* mScheduler;
+        Queue* mQueue;
+        uint64 mValue;
+    };
+
+    // Reads a whole file on the job system and resumes the awaiting coroutine with its contents. Throws
+    // OrcException if the file cannot be read.
+    class FileReadAwaitable
+    {
+    public:
+        FileReadAwaitable(AsyncScheduler* scheduler, String path) : mScheduler(scheduler), mPath(std::move(path)) {}
+
+        bool await_ready() { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        std::vector<uint8> await_resume();
+    private:
+        friend class AsyncScheduler;
+
+        AsyncScheduler* mScheduler;
+        String mPath;
+        std::vector<uint8> mData;
+        std::exception_ptr mException;
+    };
+
+    // Runs a function on the job system and resumes the awaiting coroutine at the next poll. Rethrows
+    // whatever the function threw.
+    class JobAwaitable
+    {
+    public:
+        JobAwaitable(AsyncScheduler* scheduler, std::function<void()> function) : mScheduler(scheduler), mFunction(std::move(function)) {}
+
+        bool await_ready() { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume();
+    private:
+        friend class AsyncScheduler;
+
+        AsyncScheduler* mScheduler;
+        std::function<void()> mFunction;
+        std::exception_ptr mException;
+    };
+
+    // Resumes the awaiting coroutine at the next poll, to spread work over frames.
+    class YieldAwaitable
+    {
+    public:
+        YieldAwaitable(AsyncScheduler* scheduler) : mScheduler(scheduler) {}
+
+        bool await_ready() { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() {}
+    private:
+        AsyncScheduler* mScheduler;
+    };
+
+    // Runs coroutines that wait on GPU fences and file I/O without blocking the caller. Coroutines only
+    // ever resume inside poll(), on the thread that calls it, so they can touch the scene like any
+    // other frame code; the root polls at the start of every frame. Fence waits are checked against the
+    // queue's completed value on each poll, and file reads run as jobs that queue their coroutine for
+    // the next poll when done.
+    class AsyncScheduler
+    {
+    public:
+        using WakeFunction = std::function<void()>;
+
+        AsyncScheduler(JobSystem* jobSystem);
+        // Waits for reads and jobs in flight, then destroys unfinished tasks without resuming them.
+        ~AsyncScheduler();
+
+        // Runs the task up to its first suspension and keeps it alive until it completes.
+        void spawn(Task<void> task);
+        // Resumes every coroutine whose wait is over and releases completed tasks. Rethrows the first
+        // exception that escaped a spawned task. Returns the number of coroutines resumed.
+        uint32 poll();
+        // Blocks until the next poll has something to resume: on a pending fence wait's queue, or until a
+        // read or job finishes. For callers that have to see a task through before returning.
+        void wait();
+
+        FenceAwaitable waitForFence(Queue& queue, uint64 value) { return FenceAwaitable(this, &queue, value); }
+        FileReadAwaitable readFile(String path) { return FileReadAwaitable(this, std::move(path)); }
+        JobAwaitable runJob(std::function<void()> function) { return JobAwaitable(this, std::move(function)); }
+        YieldAwaitable yield() { return YieldAwaitable(this); }
+
+        // Called from any thread when a coroutine becomes ready, so an idle frame loop can wake up and poll.
+        void setWakeFunction(WakeFunction wake) { mWake = std::move(wake); }
+
+        uint32 getPendingTaskCount() const { return static_cast<uint32>(mTasks.size()); }
+        bool hasFenceWaits() const { return !mFenceWaits.empty(); }
+        const AsyncSchedulerStats& getStats() const { return mStats; }
+
+        ORC_DISABLE_COPY_AND_MOVE(AsyncScheduler)
+    private:
+        friend class FenceAwaitable;
+        friend class FileReadAwaitable;
+        friend class JobAwaitable;
+        friend class YieldAwaitable;
+
+        struct FenceWait
+        {
+            Queue* queue;
+            uint64 value;
+            std::coroutine_handle<> handle;
+        };
+
+        void _addFenceWait(Queue* queue, uint64 value, std::coroutine_handle<> handle);
+        void _startRead(FileReadAwaitable* read, std::coroutine_handle<> handle);
+        void _startJob(JobAwaitable* job, std::coroutine_handle<> handle);
+        // Thread safe.
+        void _enqueueReady(std::coroutine_handle<> handle);
+
+        JobSystem* mJobSystem;
+        std::vector<Task<void>> mTasks;
+        std::vector<FenceWait> mFenceWaits;
+        std::vector<std::coroutine_handle<>> mResuming;
+
+        std::mutex mReadyMutex;
+        std::vector<std::coroutine_handle<>> mReady;
+        // Set whenever a coroutine becomes ready.
+        Event mReadyEvent;
+        // Counts reads and jobs in flight.
+        JobCounter mJobCounter;
+        WakeFunction mWake;
+
+        AsyncSchedulerStats mStats;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <deque>
+#include <functional>
+#include <utility>
+
+namespace Orc
+{
+    struct CommandAllocatorPoolStats
+    {
+        uint64 acquireCount = 0;
+        uint64 createdCount = 0;
+        uint64 reusedCount = 0;
+        uint64 destroyedCount = 0;
+        uint32 liveCount = 0;
+        uint32 peakLiveCount = 0;
+        uint32 idleCount = 0;
+    };
+
+    // Hands out command allocators tagged with the fence value of their last submission. Fence values
+    // of one queue only grow, so the pool is a FIFO and only its oldest entry needs to be checked
+    // against the completed value. Allocator is any movable handle; tests can drive the pool with
+    // plain integers and a simulated completed value.
+    template <typename Allocator>
+    class CommandAllocatorPool
+    {
+    public:
+        using CreateFunction = std::function<Allocator()>;
+        using ResetFunction = std::function<void(Allocator&)>;
+
+        CommandAllocatorPool(CreateFunction create, ResetFunction reset) : mCreate(std::move(create)), mReset(std::move(reset)) {}
+        ~CommandAllocatorPool() = default;
+
+        // Returns a reset allocator whose last submission has completed, creating one if none is free.
+        Allocator acquire(uint64 completedFenceValue)
+        {
+            ++mStats.acquireCount;
+            if (!mIdle.empty() && mIdle.front().first <= completedFenceValue)
+            {
+                Allocator allocator = std::move(mIdle.front().second);
+                mIdle.pop_front();
+                mStats.idleCount = static_cast<uint32>(mIdle.size());
+                mReset(allocator);
+                ++mStats.reusedCount;
+                return allocator;
+            }
+
+            ++mStats.createdCount;
+            if (++mStats.liveCount > mStats.peakLiveCount)
+                mStats.peakLiveCount = mStats.liveCount;
+            return mCreate();
+        }
+
+        // Gives back an allocator whose commands complete once fenceValue is reached.
+        void release(Allocator allocator, uint64 fenceValue)
+        {
+            mIdle.emplace_back(fenceValue, std::move(allocator));
+            mStats.idleCount = static_cast<uint32>(mIdle.size());
+        }
+
+        // Destroys completed idle allocators, oldest first, until at most keepCount remain idle.
+        uint32 shrink(uint64 completedFenceValue, uint32 keepCount)
+        {
+            uint32 destroyed = 0;
+            while (mIdle.size() > keepCount && mIdle.front().first <= completedFenceValue)
+            {
+                mIdle.pop_front();
+                ++destroyed;
+            }
+            mStats.destroyedCount += destroyed;
+            mStats.liveCount -= destroyed;
+            mStats.idleCount = static_cast<uint32>(mIdle.size());
+            return destroyed;
+        }
+
+        // Meant to be called once per frame: keeps as many idle allocators as framesInFlight frames
+        // acquire at the rate observed since the previous call.
+        uint32 trim(uint64 completedFenceValue, uint32 framesInFlight)
+        {
+            auto acquired = static_cast<uint32>(mStats.acquireCount - mAcquireCountAtTrim);
+            mAcquireCountAtTrim = mStats.acquireCount;
+            return shrink(completedFenceValue, acquired * framesInFlight);
+        }
+
+        const CommandAllocatorPoolStats& getStats() const { return mStats; }
+
+        ORC_DISABLE_COPY_AND_MOVE(CommandAllocatorPool)
+    private:
+        CreateFunction mCreate;
+        ResetFunction mReset;
+        std::deque<std::pair<uint64, Allocator>> mIdle;
+        CommandAllocatorPoolStats mStats;
+        uint64 mAcquireCountAtTrim = 0;
+    };
+}
\ No newline at end of file
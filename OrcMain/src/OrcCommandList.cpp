@@ -1,50 +1,60 @@
 #include "OrcCommandList.h"
-#include "OrcGraphicsDevice.h"
-#include "OrcTypes.h"
+#include "OrcException.h"
 
 namespace Orc
 {
-    CommandListContext::CommandListContext(void* device, CommandListType type) : mType(type)
-    {
-        auto d3d12Device = static_cast<GraphicsDevice*>(device)->getRawGraphicsDevice();
-        mDevice = device;
-        D3D12_COMMAND_LIST_TYPE d3d12Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-        switch (type)
-        {
-        case CommandListType::CLT_GRAPHICS:
-            d3d12Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-            break;
-        case CommandListType::CLT_COPY:
-            d3d12Type = D3D12_COMMAND_LIST_TYPE_COPY;
-            break;
-        case CommandListType::CLT_COMPUTE:
-            d3d12Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
-            break;
-        }
-
-        for (uint32 i = 0;i < ORC_SWAPCHAIN_COUNT; ++i)
-        {
-            d3d12Device->CreateCommandAllocator(d3d12Type, IID_PPV_ARGS(&mCommandAllocator[i]));
-            d3d12Device->CreateCommandList1(1, d3d12Type, D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&mCommandList[i]));
-        }
-    }
-
     void CommandListContext::begin()
     {
-        auto currentIndex = static_cast<GraphicsDevice*>(mDevice)->getCurrentFrameIndex();
-        mCommandAllocator[currentIndex]->Reset();
-        mCommandList[currentIndex]->Reset(mCommandAllocator[currentIndex].Get(), nullptr);
+        if (mRecording)
+            throw OrcException("Command list is already recording");
+        mStream.reset();
+        mRecording = true;
     }
 
     void CommandListContext::end()
     {
-        auto currentIndex = static_cast<GraphicsDevice*>(mDevice)->getCurrentFrameIndex();
-        mCommandList[currentIndex]->Close();
+        if (!mRecording)
+            throw OrcException("Command list is not recording");
+        mRecording = false;
+    }
+
+    void CommandListContext::resourceBarrier(ResourceHandle resource, ResourceState before, ResourceState after)
+    {
+        mStream.record(ResourceBarrierCommand{ resource, before, after });
+    }
+
+    void CommandListContext::clearRenderTarget(ResourceHandle renderTarget, float r, float g, float b, float a)
+    {
+        mStream.record(ClearRenderTargetCommand{ renderTarget, { r, g, b, a } });
+    }
+
+    void CommandListContext::setViewport(float x, float y, float width, float height, float minDepth, float maxDepth)
+    {
+        mStream.record(SetViewportCommand{ x, y, width, height, minDepth, maxDepth });
+    }
+
+    void CommandListContext::setScissorRect(int32 left, int32 top, int32 right, int32 bottom)
+    {
+        mStream.record(SetScissorRectCommand{ left, top, right, bottom });
+    }
+
+    void CommandListContext::drawInstanced(uint32 vertexCountPerInstance, uint32 instanceCount, uint32 startVertex, uint32 startInstance)
+    {
+        mStream.record(DrawInstancedCommand{ vertexCountPerInstance, instanceCount, startVertex, startInstance });
+    }
+
+    void CommandListContext::drawIndexedInstanced(uint32 indexCountPerInstance, uint32 instanceCount, uint32 startIndex, int32 baseVertex, uint32 startInstance)
+    {
+        mStream.record(DrawIndexedInstancedCommand{ indexCountPerInstance, instanceCount, startIndex, baseVertex, startInstance });
+    }
+
+    void CommandListContext::dispatch(uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ)
+    {
+        mStream.record(DispatchCommand{ threadGroupCountX, threadGroupCountY, threadGroupCountZ });
     }
 
-    ID3D12GraphicsCommandList* CommandListContext::getRawCommandList() const
+    void CommandListContext::copyBufferRegion(ResourceHandle destination, uint64 destinationOffset, ResourceHandle source, uint64 sourceOffset, uint64 numBytes)
     {
-        auto currentIndex = static_cast<GraphicsDevice*>(mDevice)->getCurrentFrameIndex();
-        return mCommandList[currentIndex].Get();
+        mStream.record(CopyBufferRegionCommand{ destination, source, destinationOffset, sourceOffset, numBytes });
     }
 }
\ No newline at end of file
@@ -2,6 +2,12 @@
 
 #include "OrcPrerequisites.h"
 
+#include "OrcCommandStream.h"
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#define ORC_COMMAND_LIST_TYPE_COUNT 3
+
 namespace Orc
 {
     enum class CommandListType
@@ -16,16 +22,27 @@ namespace Orc
     public:
         void begin();
         void end();
-        ID3D12GraphicsCommandList* getRawCommandList() const;
 
-        CommandListContext(void* device, CommandListType type);
+        void resourceBarrier(ResourceHandle resource, ResourceState before, ResourceState after);
+        void clearRenderTarget(ResourceHandle renderTarget, float r, float g, float b, float a);
+        void setViewport(float x, float y, float width, float height, float minDepth = 0.0f, float maxDepth = 1.0f);
+        void setScissorRect(int32 left, int32 top, int32 right, int32 bottom);
+        void drawInstanced(uint32 vertexCountPerInstance, uint32 instanceCount, uint32 startVertex, uint32 startInstance);
+        void drawIndexedInstanced(uint32 indexCountPerInstance, uint32 instanceCount, uint32 startIndex, int32 baseVertex, uint32 startInstance);
+        void dispatch(uint32 threadGroupCountX, uint32 threadGroupCountY, uint32 threadGroupCountZ);
+        void copyBufferRegion(ResourceHandle destination, uint64 destinationOffset, ResourceHandle source, uint64 sourceOffset, uint64 numBytes);
+
+        CommandListContext(CommandListType type) : mType(type) {}
         ~CommandListContext() = default;
 
         CommandListType getCommandListType() const { return mType; }
+        bool isRecording() const { return mRecording; }
+        const CommandStream& getCommandStream() const { return mStream; }
+
+        ORC_DISABLE_COPY_AND_MOVE(CommandListContext)
     private:
-        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> mCommandList[ORC_SWAPCHAIN_COUNT];
-        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> mCommandAllocator[ORC_SWAPCHAIN_COUNT];
-        void* mDevice;
+        CommandStream mStream;
         CommandListType mType;
+        bool mRecording = false;
     };
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "OrcCommandStream.h"
+#include "OrcException.h"
+
+#include <cstring>
+#include <memory>
+
+namespace Orc
+{
+    namespace
+    {
+        constexpr uint32 alignPayload(size_t size)
+        {
+            return static_cast<uint32>((size + ORC_COMMAND_STREAM_ALIGNMENT - 1) & ~size_t(ORC_COMMAND_STREAM_ALIGNMENT - 1));
+        }
+
+        constexpr uint32 ExpectedPayloadSize[static_cast<uint32>(CommandOpcode::CO_COUNT)] =
+        {
+            alignPayload(sizeof(ResourceBarrierCommand)),
+            alignPayload(sizeof(ClearRenderTargetCommand)),
+            alignPayload(sizeof(SetViewportCommand)),
+            alignPayload(sizeof(SetScissorRectCommand)),
+            alignPayload(sizeof(DrawInstancedCommand)),
+            alignPayload(sizeof(DrawIndexedInstancedCommand)),
+            alignPayload(sizeof(DispatchCommand)),
+            alignPayload(sizeof(CopyBufferRegionCommand)),
+        };
+    }
+
+    void CommandStream::_reserve(size_t capacity)
+    {
+        capacity = (capacity + sizeof(uint64) - 1) & ~(sizeof(uint64) - 1);
+        if (capacity <= mCapacity)
+            return;
+        auto storage = std::make_unique_for_overwrite<uint64[]>(capacity / sizeof(uint64));
+        if (mSize)
+            std::memcpy(storage.get(), mStorage.get(), mSize);
+        mStorage = std::move(storage);
+        mCapacity = capacity;
+    }
+
+    void CommandStream::assign(const uint8* data, size_t size)
+    {
+        uint32 commandCount = 0;
+        size_t offset = 0;
+        while (offset < size)
+        {
+            if (size - offset < sizeof(CommandHeader))
+                throw OrcException("Truncated command header");
+            CommandHeader header;
+            std::memcpy(&header, data + offset, sizeof(CommandHeader));
+            auto opcode = static_cast<uint32>(header.opcode);
+            if (opcode >= static_cast<uint32>(CommandOpcode::CO_COUNT) || header.size != ExpectedPayloadSize[opcode])
+                throw OrcException("Malformed command in stream");
+            offset += sizeof(CommandHeader) + header.size;
+            if (offset > size)
+                throw OrcException("Truncated command payload");
+            ++commandCount;
+        }
+
+        reset();
+        _reserve(size);
+        if (size)
+            std::memcpy(_bytes(), data, size);
+        mSize = size;
+        mCommandCount = commandCount;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcException.h"
+#include "OrcTypes.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#define ORC_COMMAND_STREAM_ALIGNMENT 8
+
+namespace Orc
+{
+    using ResourceHandle = uint32;
+
+    enum class ResourceState : uint32
+    {
+        RS_COMMON,
+        RS_PRESENT,
+        RS_RENDER_TARGET,
+        RS_COPY_SOURCE,
+        RS_COPY_DEST,
+        RS_VERTEX_AND_CONSTANT_BUFFER,
+        RS_INDEX_BUFFER,
+        RS_SHADER_RESOURCE,
+        RS_UNORDERED_ACCESS,
+    };
+
+    enum class CommandOpcode : uint32
+    {
+        CO_RESOURCE_BARRIER,
+        CO_CLEAR_RENDER_TARGET,
+        CO_SET_VIEWPORT,
+        CO_SET_SCISSOR_RECT,
+        CO_DRAW_INSTANCED,
+        CO_DRAW_INDEXED_INSTANCED,
+        CO_DISPATCH,
+        CO_COPY_BUFFER_REGION,
+        CO_COUNT,
+    };
+
+    struct CommandHeader
+    {
+        CommandOpcode opcode;
+        uint32 size;
+    };
+
+    struct ResourceBarrierCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_RESOURCE_BARRIER;
+        ResourceHandle resource;
+        ResourceState before;
+        ResourceState after;
+    };
+
+    struct ClearRenderTargetCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_CLEAR_RENDER_TARGET;
+        ResourceHandle renderTarget;
+        float color[4];
+    };
+
+    struct SetViewportCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_SET_VIEWPORT;
+        float x;
+        float y;
+        float width;
+        float height;
+        float minDepth;
+        float maxDepth;
+    };
+
+    struct SetScissorRectCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_SET_SCISSOR_RECT;
+        int32 left;
+        int32 top;
+        int32 right;
+        int32 bottom;
+    };
+
+    struct DrawInstancedCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_DRAW_INSTANCED;
+        uint32 vertexCountPerInstance;
+        uint32 instanceCount;
+        uint32 startVertex;
+        uint32 startInstance;
+    };
+
+    struct DrawIndexedInstancedCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_DRAW_INDEXED_INSTANCED;
+        uint32 indexCountPerInstance;
+        uint32 instanceCount;
+        uint32 startIndex;
+        int32 baseVertex;
+        uint32 startInstance;
+    };
+
+    struct DispatchCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_DISPATCH;
+        uint32 threadGroupCountX;
+        uint32 threadGroupCountY;
+        uint32 threadGroupCountZ;
+    };
+
+    struct CopyBufferRegionCommand
+    {
+        static constexpr CommandOpcode Opcode = CommandOpcode::CO_COPY_BUFFER_REGION;
+        ResourceHandle destination;
+        ResourceHandle source;
+        uint64 destinationOffset;
+        uint64 sourceOffset;
+        uint64 numBytes;
+    };
+
+    // Commands are stored back to back as a header followed by their POD payload, both padded
+    // to ORC_COMMAND_STREAM_ALIGNMENT. The storage is kept across reset() so steady-state
+    // recording never touches the heap, and the bytes can be copied out and assigned back as is.
+    class CommandStream
+    {
+    public:
+        CommandStream(size_t initialCapacity = 16 * 1024) { _reserve(initialCapacity); }
+        ~CommandStream() = default;
+
+        template <typename T>
+        void record(const T& command)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Commands must be POD");
+            constexpr uint32 payloadSize = _alignUp(sizeof(T));
+            constexpr size_t commandSize = sizeof(CommandHeader) + payloadSize;
+            if (mSize + commandSize > mCapacity)
+                _reserve(mCapacity * 2 > mSize + commandSize ? mCapacity * 2 : mSize + commandSize);
+
+            uint8* dst = _bytes() + mSize;
+            CommandHeader header{ T::Opcode, payloadSize };
+            std::memcpy(dst, &header, sizeof(CommandHeader));
+            std::memcpy(dst + sizeof(CommandHeader), &command, sizeof(T));
+            mSize += commandSize;
+            ++mCommandCount;
+        }
+
+        // Handler must be callable with every command type declared above.
+        template <typename Handler>
+        void replay(Handler&& handler) const
+        {
+            const uint8* cursor = _bytes();
+            const uint8* end = cursor + mSize;
+            while (cursor < end)
+            {
+                const CommandHeader& header = *reinterpret_cast<const CommandHeader*>(cursor);
+                const uint8* payload = cursor + sizeof(CommandHeader);
+                switch (header.opcode)
+                {
+                case CommandOpcode::CO_RESOURCE_BARRIER:
+                    handler(*reinterpret_cast<const ResourceBarrierCommand*>(payload));
+                    break;
+                case CommandOpcode::CO_CLEAR_RENDER_TARGET:
+                    handler(*reinterpret_cast<const ClearRenderTargetCommand*>(payload));
+                    break;
+                case CommandOpcode::CO_SET_VIEWPORT:
+                    handler(*reinterpret_cast<const SetViewportCommand*>(payload));
+                    break;
+                case CommandOpcode::CO_SET_SCISSOR_RECT:
+                    handler(*reinterpret_cast<const SetScissorRectCommand*>(payload));
+                    break;
+                case CommandOpcode::CO_DRAW_INSTANCED:
+                    handler(*reinterpret_cast<const DrawInstancedCommand*>(payload));
+                    break;
+                case CommandOpcode::CO_DRAW_INDEXED_INSTANCED:
+                    handler(*reinterpret_cast<const DrawIndexedInstancedCommand*>(payload));
+                    break;
+                case CommandOpcode::CO_DISPATCH:
+                    handler(*reinterpret_cast<const DispatchCommand*>(payload));
+                    break;
+                case CommandOpcode::CO_COPY_BUFFER_REGION:
+                    handler(*reinterpret_cast<const CopyBufferRegionCommand*>(payload));
+                    break;
+                default:
+                    throw OrcException("Unknown command opcode");
+                }
+                cursor = payload + header.size;
+            }
+        }
+
+        void reset()
+        {
+            mSize = 0;
+            mCommandCount = 0;
+        }
+
+        // Replaces the contents with a previously serialized stream after validating its framing.
+        void assign(const uint8* data, size_t size);
+
+        const uint8* getData() const { return _bytes(); }
+        size_t getSize() const { return mSize; }
+        size_t getCapacity() const { return mCapacity; }
+        uint32 getCommandCount() const { return mCommandCount; }
+
+        ORC_DISABLE_COPY_AND_MOVE(CommandStream)
+    private:
+        static constexpr uint32 _alignUp(size_t size)
+        {
+            return static_cast<uint32>((size + ORC_COMMAND_STREAM_ALIGNMENT - 1) & ~size_t(ORC_COMMAND_STREAM_ALIGNMENT - 1));
+        }
+
+        uint8* _bytes() { return reinterpret_cast<uint8*>(mStorage.get()); }
+        const uint8* _bytes() const { return reinterpret_cast<const uint8*>(mStorage.get()); }
+        void _reserve(size_t capacity);
+
+        std::unique_ptr<uint64[]> mStorage;
+        size_t mCapacity = 0;
+        size_t mSize = 0;
+        uint32 mCommandCount = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include "OrcCookedMesh.h"
+#include "OrcException.h"
+#include "OrcGltfLoader.h"
+#include "OrcTextureDecoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace Orc
+{
+    namespace
+    {
+        struct Blob
+        {
+            CookedSectionType type;
+            uint32 elementCount;
+            const void* data;
+            uint64 size;
+        };
+
+        uint64 alignOffset(uint64 offset)
+        {
+            return (offset + ORC_COOKED_MESH_ALIGNMENT - 1) & ~uint64(ORC_COOKED_MESH_ALIGNMENT - 1);
+        }
+
+        template <typename T>
+        std::vector<T> copySection(std::span<const uint8> bytes)
+        {
+            std::vector<T> elements(bytes.size() / sizeof(T));
+            if (!bytes.empty())
+                std::memcpy(elements.data(), bytes.data(), bytes.size());
+            return elements;
+        }
+    }
+
+    void writeCookedMesh(const String& path, const MeshData& mesh, const MeshletData& meshlets, const std::vector<TextureData>& images)
+    {
+        std::vector<CookedImage> imageTable;
+        for (const auto& image : images)
+            imageTable.push_back({ image.width, image.height });
+        std::vector<CookedLod> lodTable;
+        std::vector<Submesh> lodSubmeshes;
+        for (const auto& lod : mesh.lods)
+        {
+            lodTable.push_back({ static_cast<uint32>(lod.submeshes.size()), lod.error });
+            lodSubmeshes.insert(lodSubmeshes.end(), lod.submeshes.begin(), lod.submeshes.end());
+        }
+
+        std::vector<Blob> blobs = {
+            { CookedSectionType::CST_VERTICES, static_cast<uint32>(mesh.vertices.size()), mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex) },
+            { CookedSectionType::CST_INDICES, static_cast<uint32>(mesh.indices.size()), mesh.indices.data(), mesh.indices.size() * sizeof(uint32) },
+            { CookedSectionType::CST_SUBMESHES, static_cast<uint32>(mesh.submeshes.size()), mesh.submeshes.data(), mesh.submeshes.size() * sizeof(Submesh) },
+            { CookedSectionType::CST_BOUNDS, 1, &mesh.bounds, sizeof(BoundingBox) },
+            { CookedSectionType::CST_IMAGES, static_cast<uint32>(imageTable.size()), imageTable.data(), imageTable.size() * sizeof(CookedImage) },
+        };
+        if (!lodTable.empty())
+        {
+            blobs.insert(blobs.end(), {
+                { CookedSectionType::CST_LODS, static_cast<uint32>(lodTable.size()), lodTable.data(), lodTable.size() * sizeof(CookedLod) },
+                { CookedSectionType::CST_LOD_SUBMESHES, static_cast<uint32>(lodSubmeshes.size()), lodSubmeshes.data(), lodSubmeshes.size() * sizeof(Submesh) },
+            });
+        }
+        if (!meshlets.submeshOffsets.empty())
+        {
+            blobs.insert(blobs.end(), {
+                { CookedSectionType::CST_MESHLETS, static_cast<uint32>(meshlets.meshlets.size()), meshlets.meshlets.data(), meshlets.meshlets.size() * sizeof(Meshlet) },
+                { CookedSectionType::CST_MESHLET_BOUNDS, static_cast<uint32>(meshlets.bounds.size()), meshlets.bounds.data(), meshlets.bounds.size() * sizeof(MeshletBounds) },
+                { CookedSectionType::CST_MESHLET_VERTICES, static_cast<uint32>(meshlets.vertices.size()), meshlets.vertices.data(), meshlets.vertices.size() * sizeof(uint32) },
+                { CookedSectionType::CST_MESHLET_TRIANGLES, static_cast<uint32>(meshlets.triangles.size()), meshlets.triangles.data(), meshlets.triangles.size() },
+                { CookedSectionType::CST_MESHLET_SUBMESHES, static_cast<uint32>(meshlets.submeshOffsets.size()), meshlets.submeshOffsets.data(),
+                    meshlets.submeshOffsets.size() * sizeof(uint32) },
+            });
+        }
+        for (const auto& image : images)
+            blobs.push_back({ CookedSectionType::CST_TEXELS, static_cast<uint32>(image.mips.size()), image.texels.data(), image.texels.size() });
+
+        std::vector<CookedSection> sections;
+        uint64 offset = alignOffset(sizeof(CookedMeshHeader) + blobs.size() * sizeof(CookedSection));
+        for (const auto& blob : blobs)
+        {
+            sections.push_back({ blob.type, blob.elementCount, offset, blob.size });
+            offset = alignOffset(offset + blob.size);
+        }
+        CookedMeshHeader header{ ORC_COOKED_MESH_MAGIC, ORC_COOKED_MESH_VERSION, static_cast<uint32>(sections.size()), 0, offset };
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw OrcException("Cannot create " + path);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(sections.data()), sections.size() * sizeof(CookedSection));
+        uint64 written = sizeof(header) + sections.size() * sizeof(CookedSection);
+        const char padding[ORC_COOKED_MESH_ALIGNMENT]{};
+        for (size_t i = 0; i < blobs.size(); ++i)
+        {
+            file.write(padding, sections[i].offset - written);
+            file.write(static_cast<const char*>(blobs[i].data), blobs[i].size);
+            written = sections[i].offset + blobs[i].size;
+        }
+        file.write(padding, offset - written);
+        if (!file.flush())
+            throw OrcException("Cannot write " + path);
+    }
+
+    MeshCookStats cookMesh(const String& sourcePath, const String& cookedPath, JobSystem* jobSystem, const MeshCookSettings& settings)
+    {
+        GltfAsset asset(sourcePath);
+        std::vector<TextureData> images(asset.getDocument().images.size());
+        TextureDecoder textureDecoder(jobSystem);
+        for (int32 i = 0; i < static_cast<int32>(images.size()); ++i)
+            textureDecoder.decode(asset.getImage(i), images[i]);
+        auto mesh = asset.decode();
+        MeshCookStats stats;
+        if (settings.generateLods)
+            generateLods(mesh, settings.lods);
+        stats.optimization = optimizeMesh(mesh, settings.optimization);
+        stats.lods = mesh.lods;
+        MeshletData meshlets;
+        if (settings.buildMeshlets)
+        {
+            meshlets = buildMeshlets(mesh.vertices, mesh.indices, mesh.submeshes, settings.meshlets);
+            stats.meshlets = analyzeMeshlets(meshlets, static_cast<uint32>(mesh.vertices.size()), settings.meshlets);
+        }
+        textureDecoder.wait();
+        writeCookedMesh(cookedPath, mesh, meshlets, images);
+        return stats;
+    }
+
+    CookedMesh::CookedMesh(const String& path) : mFile(std::make_unique<MappedFile>(path))
+    {
+        const uint8* data = mFile->getData();
+        uint64 size = mFile->getSize();
+        CookedMeshHeader header;
+        if (size < sizeof(header))
+            throw OrcException(path + " is not an .orcmesh file");
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != ORC_COOKED_MESH_MAGIC)
+            throw OrcException(path + " is not an .orcmesh file");
+        if (header.version != ORC_COOKED_MESH_VERSION)
+            throw OrcException(path + " was cooked for version " + std::to_string(header.version) + " of the .orcmesh format instead of " +
+                std::to_string(ORC_COOKED_MESH_VERSION) + "; cook it again");
+        if (header.fileSize != size || header.sectionCount > (size - sizeof(header)) / sizeof(CookedSection))
+            throw OrcException(path + " is truncated");
+
+        bool hasVertices = false, hasIndices = false, hasBounds = false;
+        uint32 meshletSectionCount = 0;
+        std::vector<CookedLod> lodTable;
+        std::vector<Submesh> lodSubmeshes;
+        std::vector<CookedImage> imageTable;
+        std::vector<std::span<const uint8>> texels;
+        for (uint32 i = 0; i < header.sectionCount; ++i)
+        {
+            CookedSection section;
+            std::memcpy(&section, data + sizeof(header) + i * sizeof(CookedSection), sizeof(section));
+            if (section.offset % ORC_COOKED_MESH_ALIGNMENT || section.offset > size || section.size > size - section.offset)
+                throw OrcException(path + " has a section outside the file");
+            std::span<const uint8> bytes(data + section.offset, section.size);
+
+            switch (section.type)
+            {
+            case CookedSectionType::CST_VERTICES:
+                if (section.size != uint64(section.elementCount) * sizeof(Vertex))
+                    throw OrcException(path + " has a malformed vertex section");
+                mVertices = bytes;
+                hasVertices = true;
+                break;
+            case CookedSectionType::CST_INDICES:
+                if (section.size != uint64(section.elementCount) * sizeof(uint32) || section.elementCount % 3)
+                    throw OrcException(path + " has a malformed index section");
+                mIndices = bytes;
+                hasIndices = true;
+                break;
+            case CookedSectionType::CST_SUBMESHES:
+                if (section.size != uint64(section.elementCount) * sizeof(Submesh))
+                    throw OrcException(path + " has a malformed submesh section");
+                mSubmeshes.resize(section.elementCount);
+                if (!bytes.empty())
+                    std::memcpy(mSubmeshes.data(), bytes.data(), bytes.size());
+                break;
+            case CookedSectionType::CST_BOUNDS:
+                if (section.size != sizeof(BoundingBox))
+                    throw OrcException(path + " has a malformed bounds section");
+                std::memcpy(&mBounds, bytes.data(), sizeof(BoundingBox));
+                hasBounds = true;
+                break;
+            case CookedSectionType::CST_IMAGES:
+                if (section.size != uint64(section.elementCount) * sizeof(CookedImage))
+                    throw OrcException(path + " has a malformed image section");
+                imageTable.resize(section.elementCount);
+                if (!bytes.empty())
+                    std::memcpy(imageTable.data(), bytes.data(), bytes.size());
+                break;
+            case CookedSectionType::CST_TEXELS:
+                texels.push_back(bytes);
+                break;
+            case CookedSectionType::CST_LODS:
+                if (section.size != uint64(section.elementCount) * sizeof(CookedLod))
+                    throw OrcException(path + " has a malformed level of detail section");
+                lodTable = copySection<CookedLod>(bytes);
+                break;
+            case CookedSectionType::CST_LOD_SUBMESHES:
+                if (section.size != uint64(section.elementCount) * sizeof(Submesh))
+                    throw OrcException(path + " has a malformed level of detail section");
+                lodSubmeshes = copySection<Submesh>(bytes);
+                break;
+            case CookedSectionType::CST_MESHLETS:
+                if (section.size != uint64(section.elementCount) * sizeof(Meshlet))
+                    throw OrcException(path + " has a malformed meshlet section");
+                mMeshlets = bytes;
+                ++meshletSectionCount;
+                break;
+            case CookedSectionType::CST_MESHLET_BOUNDS:
+                if (section.size != uint64(section.elementCount) * sizeof(MeshletBounds))
+                    throw OrcException(path + " has a malformed meshlet section");
+                mMeshletBounds = bytes;
+                ++meshletSectionCount;
+                break;
+            case CookedSectionType::CST_MESHLET_VERTICES:
+                if (section.size != uint64(section.elementCount) * sizeof(uint32))
+                    throw OrcException(path + " has a malformed meshlet section");
+                mMeshletVertices = bytes;
+                ++meshletSectionCount;
+                break;
+            case CookedSectionType::CST_MESHLET_TRIANGLES:
+                if (section.size != section.elementCount)
+                    throw OrcException(path + " has a malformed meshlet section");
+                mMeshletTriangles = bytes;
+                ++meshletSectionCount;
+                break;
+            case CookedSectionType::CST_MESHLET_SUBMESHES:
+                if (section.size != uint64(section.elementCount) * sizeof(uint32) || section.elementCount == 0)
+                    throw OrcException(path + " has a malformed meshlet section");
+                mMeshletSubmeshOffsets = bytes;
+                ++meshletSectionCount;
+                break;
+            default:
+                // Unknown sections are skipped, so later cookers can add optional data.
+                break;
+            }
+        }
+
+        if (!hasVertices || !hasIndices || !hasBounds)
+            throw OrcException(path + " is missing geometry sections");
+        uint64 lodSubmeshCount = 0;
+        for (const auto& lod : lodTable)
+            lodSubmeshCount += lod.submeshCount;
+        if (lodSubmeshCount != lodSubmeshes.size())
+            throw OrcException(path + " has a malformed level of detail section");
+        auto nextLodSubmesh = lodSubmeshes.begin();
+        for (const auto& lod : lodTable)
+        {
+            mLods.push_back({ std::vector<Submesh>(nextLodSubmesh, nextLodSubmesh + lod.submeshCount), lod.error });
+            nextLodSubmesh += lod.submeshCount;
+        }
+        auto checkSubmesh = [&](const Submesh& submesh)
+        {
+            if (submesh.indexOffset > getIndexCount() || submesh.indexCount > getIndexCount() - submesh.indexOffset)
+                throw OrcException(path + " has a submesh outside its index section");
+        };
+        std::for_each(mSubmeshes.begin(), mSubmeshes.end(), checkSubmesh);
+        std::for_each(lodSubmeshes.begin(), lodSubmeshes.end(), checkSubmesh);
+        if (imageTable.size() != texels.size())
+            throw OrcException(path + " has a malformed image section");
+        for (size_t i = 0; i < imageTable.size(); ++i)
+        {
+            TextureData layout;
+            layout.width = imageTable[i].width;
+            layout.height = imageTable[i].height;
+            if (!layout.width || !layout.height || layoutMips(layout) != texels[i].size())
+                throw OrcException(path + " has a malformed image section");
+            mImages.push_back({ layout.width, layout.height, texels[i] });
+        }
+        if (meshletSectionCount != 0 && meshletSectionCount != 5)
+            throw OrcException(path + " has incomplete meshlet sections");
+        if (meshletSectionCount)
+            _validateMeshlets(path);
+    }
+
+    void CookedMesh::_validateMeshlets(const String& path) const
+    {
+        // Meshlet vertices and triangles are read by the GPU without bounds checks, so every index is checked here.
+        auto meshlets = copySection<Meshlet>(mMeshlets);
+        auto offsets = copySection<uint32>(mMeshletSubmeshOffsets);
+        if (mMeshletBounds.size() / sizeof(MeshletBounds) != meshlets.size() || offsets.size() != std::max<size_t>(mSubmeshes.size(), 1) + 1 ||
+            offsets.front() != 0 || offsets.back() != meshlets.size() || !std::is_sorted(offsets.begin(), offsets.end()))
+            throw OrcException(path + " has a malformed meshlet section");
+
+        auto vertices = copySection<uint32>(mMeshletVertices);
+        for (uint32 vertex : vertices)
+        {
+            if (vertex >= getVertexCount())
+                throw OrcException(path + " has a meshlet vertex outside its vertex section");
+        }
+        for (const auto& meshlet : meshlets)
+        {
+            if (meshlet.vertexCount > 256 || meshlet.vertexOffset > vertices.size() || meshlet.vertexCount > vertices.size() - meshlet.vertexOffset ||
+                meshlet.triangleOffset > mMeshletTriangles.size() || meshlet.triangleCount * 3ull > mMeshletTriangles.size() - meshlet.triangleOffset)
+                throw OrcException(path + " has a meshlet outside its meshlet sections");
+            for (uint32 i = 0; i < meshlet.triangleCount * 3; ++i)
+            {
+                if (mMeshletTriangles[meshlet.triangleOffset + i] >= meshlet.vertexCount)
+                    throw OrcException(path + " has a meshlet triangle outside its meshlet");
+            }
+        }
+    }
+
+    TextureData CookedMesh::getImage(uint32 index) const
+    {
+        if (index >= mImages.size())
+            throw OrcException("Cooked image index out of range");
+        const auto& image = mImages[index];
+        TextureData texture;
+        texture.width = image.width;
+        texture.height = image.height;
+        layoutMips(texture);
+        texture.texels.assign(image.texels.begin(), image.texels.end());
+        return texture;
+    }
+
+    MeshletData CookedMesh::getMeshlets() const
+    {
+        MeshletData meshlets;
+        meshlets.meshlets = copySection<Meshlet>(mMeshlets);
+        meshlets.bounds = copySection<MeshletBounds>(mMeshletBounds);
+        meshlets.vertices = copySection<uint32>(mMeshletVertices);
+        meshlets.triangles.assign(mMeshletTriangles.begin(), mMeshletTriangles.end());
+        meshlets.submeshOffsets = copySection<uint32>(mMeshletSubmeshOffsets);
+        return meshlets;
+    }
+}
\ No newline at end of file
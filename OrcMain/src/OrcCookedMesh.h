@@ -0,0 +1,155 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcMappedFile.h"
+#include "OrcMesh.h"
+#include "OrcMeshOptimizer.h"
+#include "OrcMeshlet.h"
+#include "OrcMeshSimplifier.h"
+#include "OrcTexture.h"
+#include "OrcTypes.h"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#define ORC_COOKED_MESH_MAGIC 0x4D43524F
+#define ORC_COOKED_MESH_VERSION 2
+// Every section starts at a multiple of this, which also satisfies the placement alignment of texture
+// data in D3D12 upload buffers.
+#define ORC_COOKED_MESH_ALIGNMENT 512
+
+namespace Orc
+{
+    class JobSystem;
+
+    // The .orcmesh container, little-endian throughout. A header and a table of sections are followed by
+    // the sections themselves. Vertices and indices are stored exactly as they are uploaded, and images
+    // as RGBA8 mip chains laid out like TextureData, so loading is a copy from the mapped file.
+    enum class CookedSectionType
+    {
+        CST_VERTICES = 1,
+        CST_INDICES = 2,
+        CST_SUBMESHES = 3,
+        CST_BOUNDS = 4,
+        // A CookedImage per image; their texels are sections of type CST_TEXELS in the same order.
+        CST_IMAGES = 5,
+        CST_TEXELS = 6,
+        // Optional; either all present or none. The last holds MeshletData::submeshOffsets.
+        CST_MESHLETS = 7,
+        CST_MESHLET_BOUNDS = 8,
+        CST_MESHLET_VERTICES = 9,
+        CST_MESHLET_TRIANGLES = 10,
+        CST_MESHLET_SUBMESHES = 11,
+        // Optional; a CookedLod per level of detail, whose submeshes follow each other in CST_LOD_SUBMESHES.
+        CST_LODS = 12,
+        CST_LOD_SUBMESHES = 13,
+    };
+
+    struct CookedMeshHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint32 sectionCount;
+        uint32 reserved;
+        uint64 fileSize;
+    };
+
+    struct CookedSection
+    {
+        CookedSectionType type;
+        uint32 elementCount;
+        uint64 offset;
+        uint64 size;
+    };
+
+    struct CookedImage
+    {
+        uint32 width;
+        uint32 height;
+    };
+
+    struct CookedLod
+    {
+        uint32 submeshCount;
+        float error;
+    };
+
+    static_assert(sizeof(CookedMeshHeader) == 24 && sizeof(CookedSection) == 24 && sizeof(CookedImage) == 8 && sizeof(CookedLod) == 8);
+    static_assert(sizeof(Vertex) == 32 && sizeof(Submesh) == 12 && sizeof(BoundingBox) == 24);
+    static_assert(sizeof(Meshlet) == 16 && sizeof(MeshletBounds) == 44);
+
+    struct MeshCookSettings
+    {
+        MeshOptimizationSettings optimization;
+        bool buildMeshlets = true;
+        MeshletSettings meshlets;
+        bool generateLods = false;
+        LodSettings lods;
+    };
+
+    struct MeshCookStats
+    {
+        MeshOptimizationStats optimization;
+        MeshletStats meshlets;
+        std::vector<MeshLod> lods;
+    };
+
+    // Writes mesh with its levels of detail, its meshlets unless there are none, and images to path.
+    // Throws OrcException if the file cannot be written.
+    void writeCookedMesh(const String& path, const MeshData& mesh, const MeshletData& meshlets, const std::vector<TextureData>& images);
+    // Decodes a .gltf or .glb, images and mips included, generates levels of detail if asked to, optimizes
+    // its geometry, builds its meshlets and writes it to cookedPath.
+    MeshCookStats cookMesh(const String& sourcePath, const String& cookedPath, JobSystem* jobSystem,
+        const MeshCookSettings& settings = MeshCookSettings());
+
+    // A memory-mapped .orcmesh file. The table of sections is validated when it is opened, after which
+    // vertices, indices and texels are spans into the mapping. Throws OrcException on malformed files
+    // and on files cooked with another version.
+    class CookedMesh
+    {
+    public:
+        CookedMesh(const String& path);
+        ~CookedMesh() = default;
+
+        uint32 getVertexCount() const { return static_cast<uint32>(mVertices.size() / sizeof(Vertex)); }
+        uint32 getIndexCount() const { return static_cast<uint32>(mIndices.size() / sizeof(uint32)); }
+        std::span<const uint8> getVertexData() const { return mVertices; }
+        std::span<const uint8> getIndexData() const { return mIndices; }
+        const std::vector<Submesh>& getSubmeshes() const { return mSubmeshes; }
+        const BoundingBox& getBounds() const { return mBounds; }
+        const std::vector<MeshLod>& getLods() const { return mLods; }
+
+        uint32 getImageCount() const { return static_cast<uint32>(mImages.size()); }
+        // Copies an image's texels out of the mapping.
+        TextureData getImage(uint32 index) const;
+
+        // False for files cooked without meshlets.
+        bool hasMeshlets() const { return !mMeshletSubmeshOffsets.empty(); }
+        MeshletData getMeshlets() const;
+
+        ORC_DISABLE_COPY_AND_MOVE(CookedMesh)
+    private:
+        void _validateMeshlets(const String& path) const;
+
+        struct Image
+        {
+            uint32 width;
+            uint32 height;
+            std::span<const uint8> texels;
+        };
+
+        std::unique_ptr<MappedFile> mFile;
+        std::span<const uint8> mVertices;
+        std::span<const uint8> mIndices;
+        std::vector<Submesh> mSubmeshes;
+        BoundingBox mBounds;
+        std::vector<MeshLod> mLods;
+        std::vector<Image> mImages;
+        std::span<const uint8> mMeshlets;
+        std::span<const uint8> mMeshletBounds;
+        std::span<const uint8> mMeshletVertices;
+        std::span<const uint8> mMeshletTriangles;
+        std::span<const uint8> mMeshletSubmeshOffsets;
+    };
+}
\ No newline at end of file
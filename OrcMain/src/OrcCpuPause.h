@@ -0,0 +1,14 @@
+#pragma once
+
+// Hint to the CPU that the calling thread is spinning on a value another thread will change.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ORC_CPU_PAUSE() _mm_pause()
+#elif defined(_M_ARM64)
+#include <intrin.h>
+#define ORC_CPU_PAUSE() __yield()
+#elif defined(__aarch64__)
+#define ORC_CPU_PAUSE() asm volatile("yield")
+#else
+#define ORC_CPU_PAUSE() ((void)0)
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "OrcD3D12CommandList.h"
+#include "OrcD3D12GraphicsDevice.h"
+#include "OrcTypes.h"
+
+namespace Orc
+{
+    D3D12_COMMAND_LIST_TYPE toD3D12CommandListType(CommandListType type)
+    {
+        switch (type)
+        {
+        case CommandListType::CLT_GRAPHICS:
+            return D3D12_COMMAND_LIST_TYPE_DIRECT;
+        case CommandListType::CLT_COPY:
+            return D3D12_COMMAND_LIST_TYPE_COPY;
+        case CommandListType::CLT_COMPUTE:
+            return D3D12_COMMAND_LIST_TYPE_COMPUTE;
+        }
+        return D3D12_COMMAND_LIST_TYPE_DIRECT;
+    }
+
+    namespace
+    {
+        D3D12_RESOURCE_STATES toD3D12ResourceState(ResourceState state)
+        {
+            switch (state)
+            {
+            case ResourceState::RS_COMMON:
+                return D3D12_RESOURCE_STATE_COMMON;
+            case ResourceState::RS_PRESENT:
+                return D3D12_RESOURCE_STATE_PRESENT;
+            case ResourceState::RS_RENDER_TARGET:
+                return D3D12_RESOURCE_STATE_RENDER_TARGET;
+            case ResourceState::RS_COPY_SOURCE:
+                return D3D12_RESOURCE_STATE_COPY_SOURCE;
+            case ResourceState::RS_COPY_DEST:
+                return D3D12_RESOURCE_STATE_COPY_DEST;
+            case ResourceState::RS_VERTEX_AND_CONSTANT_BUFFER:
+                return D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+            case ResourceState::RS_INDEX_BUFFER:
+                return D3D12_RESOURCE_STATE_INDEX_BUFFER;
+            case ResourceState::RS_SHADER_RESOURCE:
+                return D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE;
+            case ResourceState::RS_UNORDERED_ACCESS:
+                return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+            }
+            return D3D12_RESOURCE_STATE_COMMON;
+        }
+
+        struct D3D12CommandTranslator
+        {
+            ID3D12GraphicsCommandList* list;
+            D3D12GraphicsDevice* device;
+
+            void operator()(const ResourceBarrierCommand& cmd)
+            {
+                D3D12_RESOURCE_BARRIER barrier{};
+                barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                barrier.Transition.pResource = device->getRawResource(cmd.resource);
+                barrier.Transition.StateBefore = toD3D12ResourceState(cmd.before);
+                barrier.Transition.StateAfter = toD3D12ResourceState(cmd.after);
+                barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                list->ResourceBarrier(1, &barrier);
+            }
+
+            void operator()(const ClearRenderTargetCommand& cmd)
+            {
+                list->ClearRenderTargetView(device->getRenderTargetView(cmd.renderTarget), cmd.color, 0, nullptr);
+            }
+
+            void operator()(const SetViewportCommand& cmd)
+            {
+                D3D12_VIEWPORT viewport{ cmd.x, cmd.y, cmd.width, cmd.height, cmd.minDepth, cmd.maxDepth };
+                list->RSSetViewports(1, &viewport);
+            }
+
+            void operator()(const SetScissorRectCommand& cmd)
+            {
+                D3D12_RECT rect{ cmd.left, cmd.top, cmd.right, cmd.bottom };
+                list->RSSetScissorRects(1, &rect);
+            }
+
+            void operator()(const DrawInstancedCommand& cmd)
+            {
+                list->DrawInstanced(cmd.vertexCountPerInstance, cmd.instanceCount, cmd.startVertex, cmd.startInstance);
+            }
+
+            void operator()(const DrawIndexedInstancedCommand& cmd)
+            {
+                list->DrawIndexedInstanced(cmd.indexCountPerInstance, cmd.instanceCount, cmd.startIndex, cmd.baseVertex, cmd.startInstance);
+            }
+
+            void operator()(const DispatchCommand& cmd)
+            {
+                list->Dispatch(cmd.threadGroupCountX, cmd.threadGroupCountY, cmd.threadGroupCountZ);
+            }
+
+            void operator()(const CopyBufferRegionCommand& cmd)
+            {
+                list->CopyBufferRegion(device->getRawResource(cmd.destination), cmd.destinationOffset,
+                    device->getRawResource(cmd.source), cmd.sourceOffset, cmd.numBytes);
+            }
+        };
+    }
+
+    D3D12CommandRecorder::D3D12CommandRecorder(D3D12GraphicsDevice* device, CommandListType type) : mDevice(device), mType(type)
+    {
+    }
+
+    ID3D12CommandList* D3D12CommandRecorder::translate(const CommandStream& stream, ID3D12CommandAllocator* allocator, uint32 listIndex)
+    {
+        while (mCommandLists.size() <= listIndex)
+        {
+            Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
+            mDevice->getRawGraphicsDevice()->CreateCommandList1(1, toD3D12CommandListType(mType), D3D12_COMMAND_LIST_FLAG_NONE, IID_PPV_ARGS(&commandList));
+            mCommandLists.push_back(commandList);
+        }
+
+        auto commandList = mCommandLists[listIndex].Get();
+        commandList->Reset(allocator, nullptr);
+        stream.replay(D3D12CommandTranslator{ commandList, mDevice });
+        commandList->Close();
+        return commandList;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcCommandList.h"
+#include "OrcCommandStream.h"
+#include "OrcTypes.h"
+
+#include <vector>
+
+namespace Orc
+{
+    class D3D12GraphicsDevice;
+
+    D3D12_COMMAND_LIST_TYPE toD3D12CommandListType(CommandListType type);
+
+    // Translates recorded command streams into native command lists of one queue type. Lists are
+    // indexed so a whole batch can be translated before a single ExecuteCommandLists.
+    class D3D12CommandRecorder
+    {
+    public:
+        ID3D12CommandList* translate(const CommandStream& stream, ID3D12CommandAllocator* allocator, uint32 listIndex);
+
+        D3D12CommandRecorder(D3D12GraphicsDevice* device, CommandListType type);
+        ~D3D12CommandRecorder() = default;
+    private:
+        std::vector<Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>> mCommandLists;
+        D3D12GraphicsDevice* mDevice;
+        CommandListType mType;
+    };
+}
\ No newline at end of file
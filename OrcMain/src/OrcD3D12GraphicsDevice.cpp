@@ -0,0 +1,215 @@
+#include "OrcD3D12CommandList.h"
+#include "OrcD3D12GraphicsDevice.h"
+#include "OrcD3D12PresentClock.h"
+#include "OrcException.h"
+#include "OrcTypes.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Orc
+{
+    D3D12GraphicsDevice::D3D12GraphicsDevice(HWND hwnd, uint32 width, uint32 height, const GraphicsSettings& settings, JobSystem* jobSystem) :
+        GraphicsDevice(GraphicsBackendType::GBT_D3D12, settings, jobSystem)
+    {
+        uint32 factoryFlag = 0;
+#ifdef _DEBUG
+        if (mHD3D12Debug == NULL)
+            mHD3D12Debug = LoadLibraryW(L"D3D12SDKLayers.dll");
+        if (mHDXGIDebug == NULL)
+            mHDXGIDebug = LoadLibraryW(L"dxgidebug.dll");
+        if (mHD3D12Debug)
+        {
+            D3D12GetDebugInterface(IID_PPV_ARGS(&mDebugController));
+            mDebugController->EnableDebugLayer();
+        }
+        if (mHDXGIDebug)
+            factoryFlag = DXGI_CREATE_FACTORY_DEBUG;
+#endif
+        CreateDXGIFactory2(factoryFlag, IID_PPV_ARGS(&mFactory));
+        mFactory->EnumAdapterByGpuPreference(0, DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE, IID_PPV_ARGS(&mAdapter));
+        D3D12CreateDevice(mAdapter.Get(), D3D_FEATURE_LEVEL_12_0, IID_PPV_ARGS(&mDevice));
+
+        for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+        {
+            mQueues[i] = std::make_unique<D3D12Queue>(mDevice.Get(), static_cast<CommandListType>(i));
+            mQueues[i]->setWaitStrategy(settings.waitStrategy, std::chrono::microseconds(settings.waitSpinMicroseconds));
+        }
+
+        mTearingSupported = _checkTearingSupport();
+        _createSwapChain(hwnd, width, height);
+
+        mBackBufferIndex = mSwapChain->GetCurrentBackBufferIndex();
+        mResources.resize(ORC_MAX_RESOURCE_COUNT);
+        mMappedData.resize(ORC_MAX_RESOURCE_COUNT);
+        _createRTV();
+        _setPresentClock(std::make_unique<D3D12PresentClock>(mSwapChain.Get(), settings.framePacingMode != FramePacingMode::FPM_FENCE));
+
+        for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+        {
+            auto type = static_cast<CommandListType>(i);
+            mCommandRecorder[i] = std::make_unique<D3D12CommandRecorder>(this, type);
+            mCommandAllocatorPool[i] = std::make_unique<CommandAllocatorPool<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>>>(
+                [this, type]()
+                {
+                    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
+                    mDevice->CreateCommandAllocator(toD3D12CommandListType(type), IID_PPV_ARGS(&allocator));
+                    return allocator;
+                },
+                [](Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& allocator) { allocator->Reset(); });
+        }
+    }
+
+    D3D12GraphicsDevice::~D3D12GraphicsDevice()
+    {
+        _waitForIdle();
+    }
+
+    void D3D12GraphicsDevice::_createSwapChain(HWND hwnd, uint32 width, uint32 height)
+    {
+        DXGI_SWAP_CHAIN_DESC1 scDesc{};
+        scDesc.BufferCount = mSettings.backBufferCount;
+        scDesc.Width = width;
+        scDesc.Height = height;
+        scDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        scDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+        scDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+        scDesc.SampleDesc.Count = 1;
+        scDesc.SampleDesc.Quality = 0;
+        scDesc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
+        scDesc.Scaling = DXGI_SCALING_STRETCH;
+        if (mSettings.framePacingMode != FramePacingMode::FPM_FENCE)
+            mSwapChainFlags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+        if (mTearingSupported)
+            mSwapChainFlags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+        scDesc.Flags = mSwapChainFlags;
+        DXGI_SWAP_CHAIN_FULLSCREEN_DESC fsSwapChainDesc{};
+        fsSwapChainDesc.Windowed = TRUE;
+        Microsoft::WRL::ComPtr<IDXGISwapChain1> swapChain;
+        mFactory->CreateSwapChainForHwnd(_getQueue(CommandListType::CLT_GRAPHICS)->getRawCommandQueue(), hwnd, &scDesc, &fsSwapChainDesc, nullptr, &swapChain);
+        mFactory->MakeWindowAssociation(hwnd, DXGI_MWA_NO_WINDOW_CHANGES | DXGI_MWA_NO_ALT_ENTER);
+        swapChain.As(&mSwapChain);
+        if (mSettings.framePacingMode != FramePacingMode::FPM_FENCE)
+            mSwapChain->SetMaximumFrameLatency(mSettings.maxFrameLatency);
+    }
+
+    bool D3D12GraphicsDevice::_checkTearingSupport() const
+    {
+        BOOL allowTearing = FALSE;
+        if (FAILED(mFactory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))))
+            return false;
+        return allowTearing == TRUE;
+    }
+
+    void D3D12GraphicsDevice::_createRTV()
+    {
+        D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc{};
+        rtvHeapDesc.NumDescriptors = mSettings.backBufferCount;
+        rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+        rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        mDevice->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&mRtvHeap));
+        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = mRtvHeap->GetCPUDescriptorHandleForHeapStart();
+        mRtvDescriptorSize = mDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+        for (uint32 i = 0; i < mSettings.backBufferCount; ++i)
+        {
+            Microsoft::WRL::ComPtr<ID3D12Resource> renderTarget;
+            mSwapChain->GetBuffer(i, IID_PPV_ARGS(&renderTarget));
+            mDevice->CreateRenderTargetView(renderTarget.Get(), nullptr, rtvHandle);
+            rtvHandle.ptr += mRtvDescriptorSize;
+            mResources[i] = renderTarget;
+        }
+    }
+
+    void D3D12GraphicsDevice::_executeCommandLists(CommandListType type, const std::vector<CommandListContext*>& contexts, uint64 fenceValue)
+    {
+        if (contexts.empty())
+            return;
+
+        auto index = static_cast<uint32>(type);
+        auto queue = _getQueue(type);
+        auto allocator = mCommandAllocatorPool[index]->acquire(queue->getCompletedValue());
+        mNativeCommandLists.clear();
+        for (uint32 i = 0; i < contexts.size(); ++i)
+            mNativeCommandLists.push_back(mCommandRecorder[index]->translate(contexts[i]->getCommandStream(), allocator.Get(), i));
+        queue->getRawCommandQueue()->ExecuteCommandLists(static_cast<UINT>(mNativeCommandLists.size()), mNativeCommandLists.data());
+        mCommandAllocatorPool[index]->release(std::move(allocator), fenceValue);
+    }
+
+    ID3D12Resource* D3D12GraphicsDevice::getRawResource(ResourceHandle handle) const
+    {
+        if (handle >= mResources.size() || !mResources[handle])
+            throw OrcException("Invalid resource handle");
+        return mResources[handle].Get();
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE D3D12GraphicsDevice::getRenderTargetView(ResourceHandle handle) const
+    {
+        if (handle >= mSettings.backBufferCount)
+            throw OrcException("Resource is not a render target");
+        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = mRtvHeap->GetCPUDescriptorHandleForHeapStart();
+        rtvHandle.ptr += handle * mRtvDescriptorSize;
+        return rtvHandle;
+    }
+
+    void D3D12GraphicsDevice::_present()
+    {
+        HRESULT result;
+        if (mSettings.presentMode == PresentMode::PM_VSYNC)
+            result = mSwapChain->Present(1, 0);
+        else
+            result = mSwapChain->Present(0, mTearingSupported ? DXGI_PRESENT_ALLOW_TEARING : 0);
+        mOccluded = result == DXGI_STATUS_OCCLUDED;
+        _moveToNextFrame(mSwapChain->GetCurrentBackBufferIndex());
+
+        std::lock_guard<std::mutex> lock(mSubmitMutex);
+        for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+            mCommandAllocatorPool[i]->trim(mQueues[i]->getCompletedValue(), mSettings.framesInFlight);
+    }
+
+    void D3D12GraphicsDevice::_createBuffer(ResourceHandle handle, uint64 size, HeapType heapType)
+    {
+        D3D12_HEAP_PROPERTIES heapProperties{};
+        heapProperties.Type = heapType == HeapType::HT_UPLOAD ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_DEFAULT;
+
+        D3D12_RESOURCE_DESC desc{};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width = size;
+        desc.Height = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels = 1;
+        desc.Format = DXGI_FORMAT_UNKNOWN;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        // Buffers are promoted out of the common state implicitly, which is what copy queues need.
+        auto initialState = heapType == HeapType::HT_UPLOAD ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COMMON;
+        Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+        if (FAILED(mDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, initialState, nullptr, IID_PPV_ARGS(&resource))))
+            throw OrcException("Failed to create buffer");
+
+        uint8* mappedData = nullptr;
+        if (heapType == HeapType::HT_UPLOAD)
+        {
+            D3D12_RANGE readRange{};
+            if (FAILED(resource->Map(0, &readRange, reinterpret_cast<void**>(&mappedData))))
+                throw OrcException("Failed to map upload buffer");
+        }
+        mResources[handle] = std::move(resource);
+        mMappedData[handle] = mappedData;
+    }
+
+    void D3D12GraphicsDevice::_releaseResource(ResourceHandle handle)
+    {
+        mResources[handle].Reset();
+        mMappedData[handle] = nullptr;
+    }
+
+    uint8* D3D12GraphicsDevice::_getMappedData(ResourceHandle handle)
+    {
+        if (!mMappedData[handle])
+            throw OrcException("Only upload buffers can be mapped");
+        return mMappedData[handle];
+    }
+}
\ No newline at end of file
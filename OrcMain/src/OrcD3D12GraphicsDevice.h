@@ -0,0 +1,66 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcCommandAllocatorPool.h"
+#include "OrcD3D12CommandList.h"
+#include "OrcD3D12Queue.h"
+#include "OrcGraphicsDevice.h"
+#include "OrcTypes.h"
+
+#include <memory>
+#include <vector>
+
+namespace Orc
+{
+    class D3D12GraphicsDevice : public GraphicsDevice
+    {
+    public:
+        ID3D12Device4* getRawGraphicsDevice() const { return mDevice.Get(); }
+
+        ID3D12Resource* getRawResource(ResourceHandle handle) const;
+        D3D12_CPU_DESCRIPTOR_HANDLE getRenderTargetView(ResourceHandle handle) const;
+
+        D3D12GraphicsDevice(HWND hwnd, uint32 width, uint32 height, const GraphicsSettings& settings, JobSystem* jobSystem);
+        ~D3D12GraphicsDevice();
+
+        CommandAllocatorPoolStats getCommandAllocatorPoolStats(CommandListType type) const override { return mCommandAllocatorPool[static_cast<uint32>(type)]->getStats(); }
+    protected:
+        void _present() override;
+        bool _testOcclusion() override { return mSwapChain->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED; }
+        void _executeCommandLists(CommandListType type, const std::vector<CommandListContext*>& contexts, uint64 fenceValue) override;
+        void _createBuffer(ResourceHandle handle, uint64 size, HeapType heapType) override;
+        void _releaseResource(ResourceHandle handle) override;
+        uint8* _getMappedData(ResourceHandle handle) override;
+    private:
+        void _createSwapChain(HWND hwnd, uint32 width, uint32 height);
+        bool _checkTearingSupport() const;
+        void _createRTV();
+
+        D3D12Queue* _getQueue(CommandListType type) const { return static_cast<D3D12Queue*>(getQueue(type)); }
+
+        Microsoft::WRL::ComPtr<IDXGIAdapter4> mAdapter;
+        Microsoft::WRL::ComPtr<ID3D12Debug> mDebugController;
+        Microsoft::WRL::ComPtr<IDXGIFactory7> mFactory;
+        Microsoft::WRL::ComPtr<ID3D12Device4> mDevice;
+        Microsoft::WRL::ComPtr<IDXGISwapChain4> mSwapChain;
+
+        Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mRtvHeap;
+
+        uint32 mRtvDescriptorSize;
+        uint32 mSwapChainFlags = 0;
+        bool mTearingSupported = false;
+
+        // Indexed by resource handle and sized up front, so resources can be created while another
+        // thread translates command lists that reference others.
+        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> mResources;
+        std::vector<uint8*> mMappedData;
+        std::vector<ID3D12CommandList*> mNativeCommandLists;
+
+        std::unique_ptr<D3D12CommandRecorder> mCommandRecorder[ORC_COMMAND_LIST_TYPE_COUNT];
+        std::unique_ptr<CommandAllocatorPool<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>>> mCommandAllocatorPool[ORC_COMMAND_LIST_TYPE_COUNT];
+
+        inline static HMODULE mHD3D12Debug = NULL;
+        inline static HMODULE mHDXGIDebug = NULL;
+    };
+}
\ No newline at end of file
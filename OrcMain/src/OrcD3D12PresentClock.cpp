@@ -0,0 +1,50 @@
+#include "OrcD3D12PresentClock.h"
+#include "OrcException.h"
+
+#include <thread>
+
+namespace Orc
+{
+    D3D12PresentClock::D3D12PresentClock(IDXGISwapChain4* swapChain, bool latencyWaitable) : mSwapChain(swapChain)
+    {
+        if (latencyWaitable)
+            mFrameLatencyWaitable = mSwapChain->GetFrameLatencyWaitableObject();
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        mQpcFrequency = static_cast<uint64>(frequency.QuadPart);
+    }
+
+    D3D12PresentClock::~D3D12PresentClock()
+    {
+        if (mFrameLatencyWaitable)
+            CloseHandle(mFrameLatencyWaitable);
+    }
+
+    void D3D12PresentClock::sleepUntil(TimePoint time)
+    {
+        std::this_thread::sleep_until(time);
+    }
+
+    void D3D12PresentClock::waitForPresentSlot()
+    {
+        if (!mFrameLatencyWaitable)
+            return;
+        // Bounded so a display that stops flipping, e.g. while minimized, cannot hang the frame loop.
+        if (WaitForSingleObjectEx(mFrameLatencyWaitable, 1000, FALSE) == WAIT_FAILED)
+            throw OrcException("Fail to call WaitForSingleObjectEx");
+    }
+
+    bool D3D12PresentClock::getLastVblank(TimePoint& time, uint64& count) const
+    {
+        DXGI_FRAME_STATISTICS stats{};
+        if (FAILED(mSwapChain->GetFrameStatistics(&stats)) || stats.SyncQPCTime.QuadPart == 0)
+            return false;
+
+        // steady_clock counts from the same origin as QueryPerformanceCounter on Windows.
+        auto ticks = static_cast<uint64>(stats.SyncQPCTime.QuadPart);
+        auto nanoseconds = ticks / mQpcFrequency * 1000000000 + ticks % mQpcFrequency * 1000000000 / mQpcFrequency;
+        time = TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(nanoseconds)));
+        count = stats.SyncRefreshCount;
+        return true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcPresentClock.h"
+#include "OrcTypes.h"
+
+namespace Orc
+{
+    // Real-time clock paced by a swap chain. waitForPresentSlot() waits on the frame latency waitable
+    // when the swap chain was created with one, and vblanks come from the swap chain's frame statistics.
+    class D3D12PresentClock : public PresentClock
+    {
+    public:
+        D3D12PresentClock(IDXGISwapChain4* swapChain, bool latencyWaitable);
+        ~D3D12PresentClock();
+
+        TimePoint now() const override { return std::chrono::steady_clock::now(); }
+        void sleepUntil(TimePoint time) override;
+        void waitForPresentSlot() override;
+        void onPresent(TimePoint) override {}
+        bool getLastVblank(TimePoint& time, uint64& count) const override;
+
+        ORC_DISABLE_COPY_AND_MOVE(D3D12PresentClock)
+    private:
+        IDXGISwapChain4* mSwapChain;
+        HANDLE mFrameLatencyWaitable = NULL;
+        uint64 mQpcFrequency;
+    };
+}
\ No newline at end of file
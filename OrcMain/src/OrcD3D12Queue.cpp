@@ -0,0 +1,38 @@
+#include "OrcD3D12CommandList.h"
+#include "OrcD3D12Queue.h"
+#include "OrcEvent.h"
+#include "OrcException.h"
+
+namespace Orc
+{
+    D3D12Queue::D3D12Queue(ID3D12Device4* device, CommandListType type) : Queue(type)
+    {
+        D3D12_COMMAND_QUEUE_DESC queueDesc{};
+        queueDesc.Type = toD3D12CommandListType(type);
+        device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&mQueue));
+        device->CreateFence(mLastSignaledValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mFence));
+    }
+
+    uint64 D3D12Queue::signal()
+    {
+        mQueue->Signal(mFence.Get(), ++mLastSignaledValue);
+        return mLastSignaledValue;
+    }
+
+    void D3D12Queue::_waitFor(uint64 value)
+    {
+        // An event of the calling thread's own, since an auto-reset event shared between waiters lets
+        // one of them take the set meant for another.
+        thread_local Event sEvent;
+        while (mFence->GetCompletedValue() < value)
+        {
+            mFence->SetEventOnCompletion(value, sEvent.getNativeHandle());
+            sEvent.wait();
+        }
+    }
+
+    void D3D12Queue::gpuWait(Queue& other, uint64 value)
+    {
+        mQueue->Wait(static_cast<D3D12Queue&>(other).getRawFence(), value);
+    }
+}
\ No newline at end of file
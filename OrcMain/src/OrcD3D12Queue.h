@@ -0,0 +1,29 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcQueue.h"
+#include "OrcTypes.h"
+
+namespace Orc
+{
+    // A native command queue paired with the fence that carries its timeline.
+    class D3D12Queue : public Queue
+    {
+    public:
+        D3D12Queue(ID3D12Device4* device, CommandListType type);
+        ~D3D12Queue() = default;
+
+        uint64 signal() override;
+        uint64 getCompletedValue() const override { return mFence->GetCompletedValue(); }
+        void gpuWait(Queue& other, uint64 value) override;
+
+        ID3D12CommandQueue* getRawCommandQueue() const { return mQueue.Get(); }
+        ID3D12Fence1* getRawFence() const { return mFence.Get(); }
+    protected:
+        void _waitFor(uint64 value) override;
+    private:
+        Microsoft::WRL::ComPtr<ID3D12CommandQueue> mQueue;
+        Microsoft::WRL::ComPtr<ID3D12Fence1> mFence;
+    };
+}
\ No newline at end of file
@@ -1,17 +1,59 @@
 #pragma once
 
 #include "OrcPrerequisites.h"
+#include "OrcEntity.h"
+#include "OrcEntityLoad.h"
+#include "OrcManager.h"
 #include "OrcRoot.h"
 
 namespace Orc
 {
 	namespace detail
 	{
-        LRESULT CALLBACK wndProc(HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam)
+        struct Root : public Orc::Root
+        {
+            Root(void* handle, uint32 width, uint32 height, const GraphicsSettings& settings, uint32 workerThreadCount) :
+                Orc::Root(handle, width, height, settings, workerThreadCount) {}
+
+#ifdef _WIN32
+            void onSize(WPARAM type)
+            {
+                bool minimized = type == SIZE_MINIMIZED;
+                if (mMinimized && !minimized)
+                    invalidate();
+                mMinimized = minimized;
+            }
+#endif
+        };
+
+        struct SceneManager : public Orc::SceneManager
+        {
+            SceneManager(Orc::Root* root, const String& name) : Orc::SceneManager(root, name) {}
+        };
+
+        struct Entity : public Orc::Entity
+        {
+            Entity(const String& name) : Orc::Entity(name) {}
+        };
+
+        struct EntityLoad : public Orc::EntityLoad
+        {
+            EntityLoad(Orc::Entity* entity, int32 priority) : Orc::EntityLoad(entity, priority) {}
+        };
+
+#ifdef _WIN32
+        // The window's GWLP_USERDATA holds its detail::Root once the root is created.
+        inline LRESULT CALLBACK wndProc(HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam)
         {
+            auto root = reinterpret_cast<Root*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
             LRESULT result;
             switch (message)
             {
+            case WM_SIZE:
+                if (root)
+                    root->onSize(wparam);
+                result = 0;
+                break;
             case WM_DESTROY:
                 PostQuitMessage(0);
                 result = 0;
@@ -22,10 +64,6 @@ namespace Orc
             }
             return result;
         }
-
-        struct Root : public Orc::Root
-        {
-            Root(void* handle, uint32 width, uint32 height) : Orc::Root(handle, width, height) {}
-        };
+#endif
 	}
 } 
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "OrcEmulatedQueue.h"
+#include "OrcException.h"
+
+#include <mutex>
+
+namespace Orc
+{
+    uint64 EmulatedQueue::signal()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.push_back({ nullptr, ++mLastSignaledValue });
+        if (mAutoComplete)
+            _retireLocked(false);
+        return mLastSignaledValue;
+    }
+
+    void EmulatedQueue::gpuWait(Queue& other, uint64 value)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.push_back({ &other, value });
+    }
+
+    uint64 EmulatedQueue::process()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        _retireLocked(false);
+        return getCompletedValue();
+    }
+
+    bool EmulatedQueue::retireNext()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return _retireLocked(true);
+    }
+
+    bool EmulatedQueue::_retireLocked(bool retireOne)
+    {
+        bool retired = false;
+        while (!mPending.empty())
+        {
+            const auto& entry = mPending.front();
+            if (entry.waitQueue)
+            {
+                if (!entry.waitQueue->isComplete(entry.value))
+                    break;
+            }
+            else
+            {
+                if (retireOne && retired)
+                    break;
+                mCompletedValue.store(entry.value, std::memory_order_release);
+                retired = true;
+            }
+            mPending.pop_front();
+        }
+        if (retired)
+            mCompletedCondition.notify_all();
+        return retired;
+    }
+
+    void EmulatedQueue::_waitFor(uint64 value)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (value > mLastSignaledValue)
+            throw OrcException("Waiting on a fence value that was never signaled");
+        if (mAutoComplete)
+        {
+            _retireLocked(false);
+            if (getCompletedValue() < value)
+                throw OrcException("Emulated queue is blocked by a GPU wait that can never complete");
+        }
+        mCompletedCondition.wait(lock, [this, value]() { return getCompletedValue() >= value; });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcQueue.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Orc
+{
+    // CPU-emulated timeline. With auto-complete every signal completes as soon as the GPU waits queued
+    // before it are satisfied; otherwise the timeline only advances through process()/retireNext(),
+    // which lets a test or a simulated GPU thread decide when work finishes.
+    class EmulatedQueue : public Queue
+    {
+    public:
+        EmulatedQueue(CommandListType type, bool autoComplete = true) : Queue(type), mAutoComplete(autoComplete) {}
+        ~EmulatedQueue() = default;
+
+        uint64 signal() override;
+        uint64 getCompletedValue() const override { return mCompletedValue.load(std::memory_order_acquire); }
+        void gpuWait(Queue& other, uint64 value) override;
+
+        // Completes pending signals in order until one is blocked by an unsatisfied GPU wait.
+        uint64 process();
+        // Completes at most one pending signal. Returns false if none could complete.
+        bool retireNext();
+
+        void setAutoComplete(bool autoComplete) { mAutoComplete = autoComplete; }
+        bool isAutoComplete() const { return mAutoComplete; }
+    protected:
+        void _waitFor(uint64 value) override;
+    private:
+        struct PendingEntry
+        {
+            Queue* waitQueue;
+            uint64 value;
+        };
+
+        bool _retireLocked(bool retireOne);
+
+        std::deque<PendingEntry> mPending;
+        std::atomic<uint64> mCompletedValue{ 0 };
+        std::mutex mMutex;
+        // Notifies every blocked waiter when a signal completes, each of which rechecks its own value.
+        std::condition_variable mCompletedCondition;
+        bool mAutoComplete;
+    };
+}
\ No newline at end of file
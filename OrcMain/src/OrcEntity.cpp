@@ -1,8 +1,47 @@
 #include "OrcEntity.h"
+#include "OrcLodSelector.h"
+#include "OrcManager.h"
 
 namespace Orc
 {
     Entity::Entity(const String entName) : mName(entName)
     {
     }
+
+    void Entity::setPosition(float x, float y, float z)
+    {
+        mPosition[0] = x;
+        mPosition[1] = y;
+        mPosition[2] = z;
+        _updateTransform();
+    }
+
+    void Entity::setScale(float scale)
+    {
+        mScale = scale;
+        _updateTransform();
+    }
+
+    uint32 Entity::getLod() const
+    {
+        if (!mSceneManager || mLodSlot == NO_LOD_SLOT)
+            return 0;
+        return mSceneManager->mLodSelector->getLod(mLodSlot);
+    }
+
+    bool Entity::isVisible() const
+    {
+        if (!mSceneManager || mLodSlot == NO_LOD_SLOT)
+            return false;
+        return mSceneManager->mLodSelector->isVisible(mLodSlot);
+    }
+
+    void Entity::_updateTransform()
+    {
+        if (!mSceneManager)
+            return;
+        if (mLodSlot != NO_LOD_SLOT)
+            mSceneManager->mLodSelector->setTransform(mLodSlot, mPosition, mScale);
+        mSceneManager->invalidate();
+    }
 }
\ No newline at end of file
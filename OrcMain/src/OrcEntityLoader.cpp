@@ -0,0 +1,245 @@
+#include "OrcAsyncScheduler.h"
+#include "OrcCommandList.h"
+#include "OrcCookedMesh.h"
+#include "OrcDetail.h"
+#include "OrcEntity.h"
+#include "OrcEntityLoader.h"
+#include "OrcException.h"
+#include "OrcGltfLoader.h"
+#include "OrcGraphicsDevice.h"
+#include "OrcManager.h"
+#include "OrcMeshOptimizer.h"
+#include "OrcMeshSimplifier.h"
+#include "OrcMeshlet.h"
+#include "OrcSubmissionBatch.h"
+#include "OrcTextureDecoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <utility>
+
+namespace Orc
+{
+    namespace
+    {
+        // Progress at which each state starts.
+        constexpr float DECODING_PROGRESS = 0.1f;
+        constexpr float UPLOADING_PROGRESS = 0.8f;
+    }
+
+    EntityLoader::EntityLoader(GraphicsDevice* device, JobSystem* jobSystem, AsyncScheduler* scheduler) : mDevice(device), mJobSystem(jobSystem),
+        mScheduler(scheduler)
+    {
+    }
+
+    std::shared_ptr<EntityLoad> EntityLoader::load(std::shared_ptr<Entity> entity, const String& filePath, int32 priority, bool immediate)
+    {
+        auto load = std::make_shared<detail::EntityLoad>(entity.get(), priority);
+        Request request{ load, std::move(entity), filePath, mNextSequence++ };
+        if (immediate)
+            _start(std::move(request));
+        else
+        {
+            mQueue.push_back(std::move(request));
+            _startQueued();
+        }
+        return load;
+    }
+
+    void EntityLoader::setMaxConcurrentLoads(uint32 count)
+    {
+        if (count == 0)
+            throw OrcException("At least one entity load must be allowed at a time");
+        mMaxConcurrentLoads = count;
+        _startQueued();
+    }
+
+    void EntityLoader::_startQueued()
+    {
+        while (mActiveCount < mMaxConcurrentLoads && !mQueue.empty())
+        {
+            // Priorities can change at any time, so the queue is searched rather than kept sorted.
+            auto next = std::max_element(mQueue.begin(), mQueue.end(), [](const Request& a, const Request& b)
+            {
+                auto priorityA = a.load->getPriority();
+                auto priorityB = b.load->getPriority();
+                return priorityA != priorityB ? priorityA < priorityB : a.sequence > b.sequence;
+            });
+            Request request = std::move(*next);
+            mQueue.erase(next);
+            _start(std::move(request));
+        }
+    }
+
+    void EntityLoader::_start(Request request)
+    {
+        ++mActiveCount;
+        ++mStats.startedCount;
+        mScheduler->spawn(_run(std::move(request)));
+    }
+
+    Task<void> EntityLoader::_run(Request request)
+    {
+        auto load = request.load.get();
+        auto entity = request.entity.get();
+        ResourceHandle uploadBuffer = 0;
+        try
+        {
+            if (!entity->mSceneManager)
+                throw OrcException("Entity was destroyed before its load started");
+
+            load->mState.store(LoadState::LS_READING, std::memory_order_release);
+            std::shared_ptr<Mesh> mesh;
+            auto settings = mImportSettings;
+            co_await mScheduler->runJob([&]
+            {
+                if (std::filesystem::path(request.filePath).extension() == ".orcmesh")
+                    mesh = _loadCooked(request.filePath, load, settings, uploadBuffer);
+                else
+                    mesh = _loadGltf(request.filePath, load, settings, uploadBuffer);
+            });
+
+            uint64 vertexBytes = mesh->vertexCount * sizeof(Vertex);
+            uint64 indexBytes = mesh->indexCount * sizeof(uint32);
+            auto context = mDevice->createCommandListContext(CommandListType::CLT_COPY);
+            context->begin();
+            context->copyBufferRegion(mesh->vertexBuffer, 0, uploadBuffer, 0, vertexBytes);
+            context->copyBufferRegion(mesh->indexBuffer, 0, uploadBuffer, vertexBytes, indexBytes);
+            context->end();
+            SubmissionBatch batch;
+            batch.addCommandListContext(context.get());
+            auto fenceValue = mDevice->submitBatch(batch).getFenceValue(CommandListType::CLT_COPY);
+            load->mState.store(LoadState::LS_UPLOADING, std::memory_order_release);
+            load->mProgress.store(UPLOADING_PROGRESS, std::memory_order_relaxed);
+
+            co_await mScheduler->waitForFence(*mDevice->getQueue(CommandListType::CLT_COPY), fenceValue);
+            mDevice->releaseResource(uploadBuffer);
+            uploadBuffer = 0;
+            mStats.uploadedBytes += vertexBytes + indexBytes;
+            for (const auto& image : mesh->images)
+                mStats.decodedImageBytes += image.texels.size();
+
+            entity->mMesh = mesh;
+            entity->mReady.store(true, std::memory_order_release);
+            load->mProgress.store(1.0f, std::memory_order_relaxed);
+            load->mState.store(LoadState::LS_READY, std::memory_order_release);
+            ++mStats.readyCount;
+            if (entity->mSceneManager)
+            {
+                entity->mSceneManager->_addToLodSelection(entity);
+                entity->mSceneManager->invalidate();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // Nothing reads the upload buffer unless the copy was submitted, and a submitted copy cannot fail.
+            if (uploadBuffer)
+                mDevice->releaseResource(uploadBuffer);
+            load->mError = e.what();
+            load->mState.store(LoadState::LS_FAILED, std::memory_order_release);
+            ++mStats.failedCount;
+        }
+
+        --mActiveCount;
+        _startQueued();
+    }
+
+    std::shared_ptr<Mesh> EntityLoader::_loadGltf(const String& path, EntityLoad* load, const MeshImportSettings& settings, ResourceHandle& uploadBuffer)
+    {
+        // Only the JSON is read here; geometry pages are faulted in while decoding.
+        GltfAsset asset(path);
+        if (asset.getIndexCount() == 0)
+            throw OrcException("No triangles in " + path);
+        load->mState.store(LoadState::LS_DECODING, std::memory_order_release);
+        load->mProgress.store(DECODING_PROGRESS, std::memory_order_relaxed);
+
+        // Images decode on jobs of their own while this one decodes the geometry.
+        std::vector<TextureData> images(asset.getDocument().images.size());
+        TextureDecoder textureDecoder(mJobSystem);
+        for (int32 i = 0; i < static_cast<int32>(images.size()); ++i)
+            textureDecoder.decode(asset.getImage(i), images[i]);
+
+        std::shared_ptr<Mesh> mesh;
+        if (settings.optimize || settings.buildMeshlets || settings.generateLods)
+        {
+            // These read the geometry back, so it goes through memory the CPU can read first.
+            auto data = asset.decode();
+            if (settings.generateLods)
+                generateLods(data);
+            if (settings.optimize)
+                optimizeMesh(data, MeshOptimizationSettings());
+            mesh = _createMesh(static_cast<uint32>(data.vertices.size()), static_cast<uint32>(data.indices.size()), uploadBuffer);
+            uint8* mapped = mDevice->getMappedData(uploadBuffer);
+            std::memcpy(mapped, data.vertices.data(), data.vertices.size() * sizeof(Vertex));
+            std::memcpy(mapped + data.vertices.size() * sizeof(Vertex), data.indices.data(), data.indices.size() * sizeof(uint32));
+            if (settings.buildMeshlets)
+                mesh->meshlets = buildMeshlets(data.vertices, data.indices, data.submeshes);
+            mesh->submeshes = std::move(data.submeshes);
+            mesh->lods = std::move(data.lods);
+            mesh->bounds = data.bounds;
+        }
+        else
+        {
+            mesh = _createMesh(asset.getVertexCount(), asset.getIndexCount(), uploadBuffer);
+            // Decoding writes straight into the upload buffer, the only copy before the GPU's.
+            uint8* mapped = mDevice->getMappedData(uploadBuffer);
+            asset.decode(reinterpret_cast<Vertex*>(mapped), reinterpret_cast<uint32*>(mapped + mesh->vertexCount * sizeof(Vertex)), mesh->submeshes, mesh->bounds);
+        }
+        textureDecoder.wait();
+        mesh->images = std::move(images);
+        return mesh;
+    }
+
+    std::shared_ptr<Mesh> EntityLoader::_loadCooked(const String& path, EntityLoad* load, const MeshImportSettings& settings, ResourceHandle& uploadBuffer)
+    {
+        CookedMesh cooked(path);
+        if (cooked.getIndexCount() == 0)
+            throw OrcException("No triangles in " + path);
+        load->mState.store(LoadState::LS_DECODING, std::memory_order_release);
+        load->mProgress.store(DECODING_PROGRESS, std::memory_order_relaxed);
+
+        // Already in the upload layout, so the mapped file is copied as is.
+        auto mesh = _createMesh(cooked.getVertexCount(), cooked.getIndexCount(), uploadBuffer);
+        uint8* mapped = mDevice->getMappedData(uploadBuffer);
+        std::memcpy(mapped, cooked.getVertexData().data(), cooked.getVertexData().size());
+        std::memcpy(mapped + cooked.getVertexData().size(), cooked.getIndexData().data(), cooked.getIndexData().size());
+        mesh->submeshes = cooked.getSubmeshes();
+        mesh->lods = cooked.getLods();
+        mesh->bounds = cooked.getBounds();
+        if (cooked.hasMeshlets())
+            mesh->meshlets = cooked.getMeshlets();
+        else if (settings.buildMeshlets)
+        {
+            std::span<const Vertex> vertices(reinterpret_cast<const Vertex*>(cooked.getVertexData().data()), cooked.getVertexCount());
+            std::span<const uint32> indices(reinterpret_cast<const uint32*>(cooked.getIndexData().data()), cooked.getIndexCount());
+            mesh->meshlets = buildMeshlets(vertices, indices, mesh->submeshes);
+        }
+        for (uint32 i = 0; i < cooked.getImageCount(); ++i)
+            mesh->images.push_back(cooked.getImage(i));
+        return mesh;
+    }
+
+    std::shared_ptr<Mesh> EntityLoader::_createMesh(uint32 vertexCount, uint32 indexCount, ResourceHandle& uploadBuffer)
+    {
+        auto device = mDevice;
+        auto mesh = std::shared_ptr<Mesh>(new Mesh(), [device](Mesh* mesh)
+        {
+            if (mesh->vertexBuffer)
+                device->releaseResourceAfter(mesh->vertexBuffer, CommandListType::CLT_GRAPHICS, mesh->lastFrameFenceValue);
+            if (mesh->indexBuffer)
+                device->releaseResourceAfter(mesh->indexBuffer, CommandListType::CLT_GRAPHICS, mesh->lastFrameFenceValue);
+            delete mesh;
+        });
+        mesh->vertexCount = vertexCount;
+        mesh->indexCount = indexCount;
+
+        uint64 vertexBytes = mesh->vertexCount * sizeof(Vertex);
+        uint64 indexBytes = mesh->indexCount * sizeof(uint32);
+        mesh->vertexBuffer = mDevice->createBuffer(vertexBytes, HeapType::HT_DEFAULT);
+        mesh->indexBuffer = mDevice->createBuffer(indexBytes, HeapType::HT_DEFAULT);
+        uploadBuffer = mDevice->createBuffer(vertexBytes + indexBytes, HeapType::HT_UPLOAD);
+        return mesh;
+    }
+}
\ No newline at end of file
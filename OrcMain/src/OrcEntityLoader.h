@@ -0,0 +1,84 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcEntityLoad.h"
+#include "OrcMesh.h"
+#include "OrcTask.h"
+#include "OrcTypes.h"
+
+#include <memory>
+#include <vector>
+
+namespace Orc
+{
+    class AsyncScheduler;
+    class Entity;
+    class GraphicsDevice;
+    class JobSystem;
+
+    struct EntityLoaderStats
+    {
+        uint64 startedCount = 0;
+        uint64 readyCount = 0;
+        uint64 failedCount = 0;
+        uint64 uploadedBytes = 0;
+        // RGBA8 bytes of decoded images, mips included.
+        uint64 decodedImageBytes = 0;
+    };
+
+    // Streams entity geometry in with one coroutine per load on the async scheduler. On the job system, a
+    // glTF file is mapped and decoded straight into an upload buffer, unless the import settings need the
+    // geometry on the CPU first, while each of its images is decoded by a job of its own. Cooked .orcmesh
+    // files are mapped and copied into the upload buffer as they are. The main thread then records the
+    // copy to default heap buffers on the copy queue, and the entity becomes ready in the first poll
+    // after the copy fence passes. At most maxConcurrentLoads loads run at once; the others wait in a
+    // queue ordered by priority. Only used from the thread that polls the scheduler.
+    class EntityLoader
+    {
+    public:
+        EntityLoader(GraphicsDevice* device, JobSystem* jobSystem, AsyncScheduler* scheduler);
+        ~EntityLoader() = default;
+
+        // An immediate load starts right away, regardless of the queue and the concurrency limit.
+        std::shared_ptr<EntityLoad> load(std::shared_ptr<Entity> entity, const String& filePath, int32 priority, bool immediate);
+
+        void setMaxConcurrentLoads(uint32 count);
+        uint32 getMaxConcurrentLoads() const { return mMaxConcurrentLoads; }
+        // Applies to loads started afterwards.
+        void setImportSettings(const MeshImportSettings& settings) { mImportSettings = settings; }
+        const MeshImportSettings& getImportSettings() const { return mImportSettings; }
+        uint32 getQueuedLoadCount() const { return static_cast<uint32>(mQueue.size()); }
+        uint32 getActiveLoadCount() const { return mActiveCount; }
+        const EntityLoaderStats& getStats() const { return mStats; }
+
+        ORC_DISABLE_COPY_AND_MOVE(EntityLoader)
+    private:
+        struct Request
+        {
+            std::shared_ptr<EntityLoad> load;
+            std::shared_ptr<Entity> entity;
+            String filePath;
+            uint64 sequence;
+        };
+
+        void _startQueued();
+        void _start(Request request);
+        Task<void> _run(Request request);
+        // Create the mesh and fill the upload buffer with its vertices followed by its indices. Run on
+        // the job system.
+        std::shared_ptr<Mesh> _loadGltf(const String& path, EntityLoad* load, const MeshImportSettings& settings, ResourceHandle& uploadBuffer);
+        std::shared_ptr<Mesh> _loadCooked(const String& path, EntityLoad* load, const MeshImportSettings& settings, ResourceHandle& uploadBuffer);
+        // Creates the default heap buffers of a mesh and an upload buffer large enough for both.
+        std::shared_ptr<Mesh> _createMesh(uint32 vertexCount, uint32 indexCount, ResourceHandle& uploadBuffer);
+
+        GraphicsDevice* mDevice;
+        JobSystem* mJobSystem;
+        AsyncScheduler* mScheduler;
+        std::vector<Request> mQueue;
+        uint32 mMaxConcurrentLoads = 8;
+        MeshImportSettings mImportSettings;
+        uint32 mActiveCount = 0;
+        uint64 mNextSequence = 0;
+        EntityLoaderStats mStats;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "OrcEvent.h"
+#include "OrcException.h"
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <thread>
+#endif
+
+namespace Orc
+{
+#ifdef _WIN32
+    Event::Event() : mHandle(CreateEventW(nullptr, FALSE, FALSE, nullptr))
+    {
+        if (mHandle == NULL)
+            throw OrcException("Fail to call CreateEventW");
+    }
+
+    Event::~Event()
+    {
+        CloseHandle(mHandle);
+    }
+
+    void Event::set()
+    {
+        SetEvent(mHandle);
+    }
+
+    void Event::wait()
+    {
+        if (WaitForSingleObjectEx(mHandle, INFINITE, FALSE) == WAIT_FAILED)
+            throw OrcException("Fail to call WaitForSingleObjectEx");
+    }
+
+    bool Event::wait(std::chrono::nanoseconds timeout)
+    {
+        auto milliseconds = std::chrono::ceil<std::chrono::milliseconds>(timeout).count();
+        auto result = WaitForSingleObjectEx(mHandle, static_cast<DWORD>(milliseconds), FALSE);
+        if (result == WAIT_FAILED)
+            throw OrcException("Fail to call WaitForSingleObjectEx");
+        return result == WAIT_OBJECT_0;
+    }
+#else
+    Event::Event() = default;
+    Event::~Event() = default;
+
+#if defined(__linux__)
+    namespace
+    {
+        long futex(std::atomic<uint32>* address, int op, uint32 value, const timespec* timeout)
+        {
+            return syscall(SYS_futex, reinterpret_cast<uint32*>(address), op | FUTEX_PRIVATE_FLAG, value, timeout, nullptr, 0);
+        }
+    }
+
+    void Event::set()
+    {
+        if (mState.exchange(1, std::memory_order_release) == 0)
+            futex(&mState, FUTEX_WAKE, 1, nullptr);
+    }
+
+    void Event::wait()
+    {
+        while (mState.exchange(0, std::memory_order_acquire) == 0)
+            futex(&mState, FUTEX_WAIT, 0, nullptr);
+    }
+
+    bool Event::wait(std::chrono::nanoseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (mState.exchange(0, std::memory_order_acquire) == 0)
+        {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds::zero())
+                return false;
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+            timespec relative{ static_cast<time_t>(seconds.count()), static_cast<long>((remaining - seconds).count()) };
+            futex(&mState, FUTEX_WAIT, 0, &relative);
+        }
+        return true;
+    }
+#else
+    void Event::set()
+    {
+        mState.store(1, std::memory_order_release);
+        mState.notify_one();
+    }
+
+    void Event::wait()
+    {
+        while (mState.exchange(0, std::memory_order_acquire) == 0)
+            mState.wait(0, std::memory_order_relaxed);
+    }
+
+    bool Event::wait(std::chrono::nanoseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (mState.exchange(0, std::memory_order_acquire) == 0)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+#endif
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace Orc
+{
+    // Auto-reset event: set() releases one wait(), or the next one if nobody is waiting. Backed by a
+    // Win32 event on Windows, so it can be handed to APIs such as ID3D12Fence::SetEventOnCompletion,
+    // and by a futex on Linux.
+    class Event
+    {
+    public:
+        Event();
+        ~Event();
+
+        void set();
+        void wait();
+        // Returns false if the timeout elapsed before the event was set.
+        bool wait(std::chrono::nanoseconds timeout);
+
+#ifdef _WIN32
+        HANDLE getNativeHandle() const { return mHandle; }
+#endif
+
+        ORC_DISABLE_COPY_AND_MOVE(Event)
+    private:
+#ifdef _WIN32
+        HANDLE mHandle;
+#else
+        std::atomic<uint32> mState{ 0 };
+#endif
+    };
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "OrcException.h"
+#include "OrcFrameLimiter.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace Orc
+{
+    void FrameLimiter::setFrameRate(double framesPerSecond)
+    {
+        if (!(framesPerSecond > 0.0))
+            throw OrcException("Frame rate cap must be positive");
+        mInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / framesPerSecond));
+        mHasDeadline = false;
+    }
+
+    void FrameLimiter::wait()
+    {
+        auto now = Clock::now();
+        ++mFrameCount;
+        if (!mHasDeadline || now - mDeadline > mInterval)
+        {
+            mDeadline = now + mInterval;
+            mHasDeadline = true;
+            return;
+        }
+
+        auto start = now;
+        while (mDeadline - now > mSleepOvershoot)
+        {
+            auto sleepTime = mDeadline - now - mSleepOvershoot;
+            std::this_thread::sleep_for(sleepTime);
+            auto woke = Clock::now();
+            // Track the worst recent overshoot, decaying slowly so one hiccup does not waste CPU forever.
+            auto overshoot = std::chrono::duration_cast<std::chrono::nanoseconds>(woke - now - sleepTime);
+            mSleepOvershoot = std::max(overshoot, mSleepOvershoot - mSleepOvershoot / 64);
+            now = woke;
+        }
+        while (now < mDeadline)
+        {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+
+        mWaitTime += now - start;
+        mLateness += now - mDeadline;
+        mDeadline += mInterval;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <chrono>
+
+namespace Orc
+{
+    // Caps the frame rate by holding each frame until its deadline. The thread sleeps while the deadline
+    // is further away than the sleep overshoot observed so far, then spins for the rest, so the cap is
+    // precise even where the OS sleep granularity is coarse. Deadlines advance by whole intervals to
+    // keep the average rate exact; a frame that falls more than one interval behind restarts the cadence.
+    class FrameLimiter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        FrameLimiter(double framesPerSecond = 60.0) { setFrameRate(framesPerSecond); }
+        ~FrameLimiter() = default;
+
+        void setFrameRate(double framesPerSecond);
+        double getFrameRate() const { return 1.0 / std::chrono::duration<double>(mInterval).count(); }
+
+        // Blocks until the current frame's deadline and starts the next frame.
+        void wait();
+        void reset() { mHasDeadline = false; }
+
+        uint64 getFrameCount() const { return mFrameCount; }
+        // Total time the limiter held frames back, and how late past the deadline it released them.
+        std::chrono::nanoseconds getWaitTime() const { return mWaitTime; }
+        std::chrono::nanoseconds getLateness() const { return mLateness; }
+        std::chrono::nanoseconds getSleepOvershootEstimate() const { return mSleepOvershoot; }
+
+        ORC_DISABLE_COPY_AND_MOVE(FrameLimiter)
+    private:
+        std::chrono::nanoseconds mInterval{};
+        Clock::time_point mDeadline{};
+        bool mHasDeadline = false;
+        std::chrono::nanoseconds mSleepOvershoot{ std::chrono::microseconds(200) };
+
+        uint64 mFrameCount = 0;
+        std::chrono::nanoseconds mWaitTime{};
+        std::chrono::nanoseconds mLateness{};
+    };
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "OrcFramePacer.h"
+
+namespace Orc
+{
+    FramePacer::FramePacer(PresentClock* clock, FramePacingMode mode, std::chrono::microseconds justInTimeMargin)
+        : mClock(clock), mMode(mode), mMargin(justInTimeMargin)
+    {
+    }
+
+    void FramePacer::beginFrame()
+    {
+        if (mMode != FramePacingMode::FPM_FENCE)
+            mClock->waitForPresentSlot();
+
+        if (mMode == FramePacingMode::FPM_JUST_IN_TIME)
+        {
+            _updateRefreshInterval();
+            if (mHasVblank && mRefreshInterval.count() > 0)
+            {
+                // Start on the latest point that still lets the frame, at its estimated cost, make a vblank.
+                auto now = mClock->now();
+                auto start = mLastVblankTime - mFrameCost - mMargin;
+                while (start < now)
+                    start += mRefreshInterval;
+                mJustInTimeDelay += start - now;
+                mClock->sleepUntil(start);
+            }
+        }
+        mFrameStart = mClock->now();
+    }
+
+    void FramePacer::endFrame()
+    {
+        auto cost = mClock->now() - mFrameStart;
+        // Rise immediately on spikes and decay slowly, so one slow frame is not followed by a miss.
+        if (cost > mFrameCost)
+            mFrameCost = cost;
+        else
+            mFrameCost -= (mFrameCost - cost) / 16;
+        mClock->onPresent(mFrameStart);
+    }
+
+    void FramePacer::_updateRefreshInterval()
+    {
+        PresentClock::TimePoint time;
+        uint64 count;
+        if (!mClock->getLastVblank(time, count))
+            return;
+
+        if (mHasVblank && count > mLastVblankCount)
+        {
+            auto interval = (time - mLastVblankTime) / static_cast<int64>(count - mLastVblankCount);
+            if (mRefreshInterval.count() == 0)
+                mRefreshInterval = interval;
+            else
+                mRefreshInterval += (interval - mRefreshInterval) / 8;
+        }
+        if (!mHasVblank || count > mLastVblankCount)
+        {
+            mLastVblankTime = time;
+            mLastVblankCount = count;
+            mHasVblank = true;
+        }
+    }
+}
\ No newline at end of file
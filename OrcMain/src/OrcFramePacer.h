@@ -0,0 +1,48 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcDefines.h"
+#include "OrcGraphicsSettings.h"
+#include "OrcPresentClock.h"
+#include "OrcTypes.h"
+
+#include <chrono>
+
+namespace Orc
+{
+    // Decides when the CPU starts working on a frame. beginFrame() blocks according to the pacing mode
+    // and endFrame() is called right before the frame is presented; the cost of a frame is the time
+    // between the two, which FPM_JUST_IN_TIME uses to start the next one as late as the vblank allows.
+    class FramePacer
+    {
+    public:
+        FramePacer(PresentClock* clock, FramePacingMode mode, std::chrono::microseconds justInTimeMargin);
+        ~FramePacer() = default;
+
+        void beginFrame();
+        void endFrame();
+
+        FramePacingMode getMode() const { return mMode; }
+        PresentClock::Duration getFrameCostEstimate() const { return mFrameCost; }
+        PresentClock::Duration getRefreshIntervalEstimate() const { return mRefreshInterval; }
+        // Total time beginFrame() held back CPU work on purpose, waits on the latency waitable excluded.
+        PresentClock::Duration getJustInTimeDelay() const { return mJustInTimeDelay; }
+
+        ORC_DISABLE_COPY_AND_MOVE(FramePacer)
+    private:
+        void _updateRefreshInterval();
+
+        PresentClock* mClock;
+        FramePacingMode mMode;
+        PresentClock::Duration mMargin;
+
+        PresentClock::TimePoint mFrameStart{};
+        PresentClock::Duration mFrameCost{};
+        PresentClock::Duration mRefreshInterval{};
+        PresentClock::TimePoint mLastVblankTime{};
+        uint64 mLastVblankCount = 0;
+        bool mHasVblank = false;
+        PresentClock::Duration mJustInTimeDelay{};
+    };
+}
\ No newline at end of file
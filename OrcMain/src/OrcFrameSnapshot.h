@@ -0,0 +1,38 @@
+#pragma once
+
+#include "OrcMesh.h"
+#include "OrcTypes.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Orc
+{
+    // A ready entity in the camera's frustum, as the main thread left it when the snapshot was built.
+    // Nothing binds pipelines or geometry yet, so the render thread records no draws for it.
+    struct DrawItem
+    {
+        // Shared with the entity, so the mesh outlives it until the snapshot is recycled. The render thread
+        // tags the mesh with the frame's fence value, past which its buffers are released.
+        std::shared_ptr<Mesh> mesh;
+        // Level of detail selected for the frame, 0 being full detail.
+        uint32 lod;
+    };
+
+    struct SceneSnapshot
+    {
+        uint64 generation = 0;
+        std::vector<DrawItem> drawItems;
+    };
+
+    // Everything the render thread needs from the main thread to draw one frame. Built by the main
+    // thread and immutable once handed off, so the next frame's simulation can run while it renders.
+    struct FrameSnapshot
+    {
+        uint64 frameNumber = 0;
+        std::chrono::steady_clock::time_point simulationStart{};
+        // One per scene manager, in creation order. Kept across frames so their draw lists reuse their storage.
+        std::vector<SceneSnapshot> scenes;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,700 @@
+#include "OrcException.h"
+#include "OrcGltfDocument.h"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Orc
+{
+    namespace
+    {
+        using Json = nlohmann::json;
+
+        enum class Key
+        {
+            K_UNKNOWN,
+            K_ACCESSORS,
+            K_ATTRIBUTES,
+            K_BUFFER,
+            K_BUFFER_VIEW,
+            K_BUFFER_VIEWS,
+            K_BUFFERS,
+            K_BYTE_LENGTH,
+            K_BYTE_OFFSET,
+            K_BYTE_STRIDE,
+            K_CHILDREN,
+            K_COMPONENT_TYPE,
+            K_COUNT,
+            K_IMAGES,
+            K_INDICES,
+            K_MATERIAL,
+            K_MATRIX,
+            K_MESH,
+            K_MESHES,
+            K_MIME_TYPE,
+            K_MODE,
+            K_NODES,
+            K_NORMAL,
+            K_NORMALIZED,
+            K_POSITION,
+            K_PRIMITIVES,
+            K_ROTATION,
+            K_SCALE,
+            K_SCENE,
+            K_SCENES,
+            K_SPARSE,
+            K_TEXCOORD_0,
+            K_TRANSLATION,
+            K_TYPE,
+            K_URI,
+        };
+
+        // What the innermost open object or array holds.
+        enum class Context
+        {
+            C_ROOT,
+            C_BUFFERS,
+            C_BUFFER,
+            C_BUFFER_VIEWS,
+            C_BUFFER_VIEW,
+            C_ACCESSORS,
+            C_ACCESSOR,
+            C_MESHES,
+            C_MESH,
+            C_PRIMITIVES,
+            C_PRIMITIVE,
+            C_ATTRIBUTES,
+            C_NODES,
+            C_NODE,
+            C_SCENES,
+            C_SCENE,
+            C_IMAGES,
+            C_IMAGE,
+            // A fixed-size array of numbers, such as a node's matrix.
+            C_NUMBERS,
+            // An array of indices, such as a node's children.
+            C_INDICES,
+        };
+
+        Key findKey(const std::string& name)
+        {
+            static const std::unordered_map<std::string_view, Key> keys = {
+                { "accessors", Key::K_ACCESSORS },
+                { "attributes", Key::K_ATTRIBUTES },
+                { "buffer", Key::K_BUFFER },
+                { "bufferView", Key::K_BUFFER_VIEW },
+                { "bufferViews", Key::K_BUFFER_VIEWS },
+                { "buffers", Key::K_BUFFERS },
+                { "byteLength", Key::K_BYTE_LENGTH },
+                { "byteOffset", Key::K_BYTE_OFFSET },
+                { "byteStride", Key::K_BYTE_STRIDE },
+                { "children", Key::K_CHILDREN },
+                { "componentType", Key::K_COMPONENT_TYPE },
+                { "count", Key::K_COUNT },
+                { "images", Key::K_IMAGES },
+                { "indices", Key::K_INDICES },
+                { "material", Key::K_MATERIAL },
+                { "matrix", Key::K_MATRIX },
+                { "mesh", Key::K_MESH },
+                { "meshes", Key::K_MESHES },
+                { "mimeType", Key::K_MIME_TYPE },
+                { "mode", Key::K_MODE },
+                { "nodes", Key::K_NODES },
+                { "NORMAL", Key::K_NORMAL },
+                { "normalized", Key::K_NORMALIZED },
+                { "POSITION", Key::K_POSITION },
+                { "primitives", Key::K_PRIMITIVES },
+                { "rotation", Key::K_ROTATION },
+                { "scale", Key::K_SCALE },
+                { "scene", Key::K_SCENE },
+                { "scenes", Key::K_SCENES },
+                { "sparse", Key::K_SPARSE },
+                { "TEXCOORD_0", Key::K_TEXCOORD_0 },
+                { "translation", Key::K_TRANSLATION },
+                { "type", Key::K_TYPE },
+                { "uri", Key::K_URI },
+            };
+            auto it = keys.find(name);
+            return it != keys.end() ? it->second : Key::K_UNKNOWN;
+        }
+
+        uint32 getComponentCount(const String& type)
+        {
+            if (type == "SCALAR")
+                return 1;
+            if (type == "VEC2")
+                return 2;
+            if (type == "VEC3")
+                return 3;
+            if (type == "VEC4" || type == "MAT2")
+                return 4;
+            if (type == "MAT3")
+                return 9;
+            if (type == "MAT4")
+                return 16;
+            return 0;
+        }
+
+        // Fills a GltfDocument from nlohmann::json's SAX events, so no DOM is ever built. Containers the
+        // document does not need are skipped without being stored. Errors end the parse with a message.
+        class SaxHandler
+        {
+        public:
+            SaxHandler(GltfDocument& document) : mDocument(document) {}
+
+            bool null() { return _scalar(); }
+
+            bool boolean(bool value)
+            {
+                if (_inObject(Context::C_ACCESSOR, Key::K_NORMALIZED))
+                {
+                    mDocument.accessors.back().normalized = value;
+                    return true;
+                }
+                return _scalar();
+            }
+
+            bool number_integer(Json::number_integer_t value)
+            {
+                if (!mSkipDepth && mFrames.size() && mFrames.back().context == Context::C_NUMBERS)
+                    return _number(static_cast<double>(value));
+                return _scalar();
+            }
+
+            bool number_unsigned(Json::number_unsigned_t value)
+            {
+                if (mSkipDepth || mFrames.empty())
+                    return _scalar();
+                auto& frame = mFrames.back();
+                switch (frame.context)
+                {
+                case Context::C_NUMBERS:
+                    return _number(static_cast<double>(value));
+                case Context::C_INDICES:
+                    if (value > static_cast<uint64>(std::numeric_limits<int32>::max()))
+                        return _fail("glTF index is out of range");
+                    mIndices->push_back(static_cast<int32>(value));
+                    return true;
+                default:
+                    break;
+                }
+
+                if (int32* index = _findIndex())
+                {
+                    if (value > static_cast<uint64>(std::numeric_limits<int32>::max()))
+                        return _fail("glTF index is out of range");
+                    *index = static_cast<int32>(value);
+                    return true;
+                }
+                switch (frame.context)
+                {
+                case Context::C_BUFFER:
+                    if (frame.key == Key::K_BYTE_LENGTH)
+                        return _set(mDocument.buffers.back().byteLength, value);
+                    break;
+                case Context::C_BUFFER_VIEW:
+                    if (frame.key == Key::K_BYTE_OFFSET)
+                        return _set(mDocument.bufferViews.back().byteOffset, value);
+                    if (frame.key == Key::K_BYTE_LENGTH)
+                        return _set(mDocument.bufferViews.back().byteLength, value);
+                    if (frame.key == Key::K_BYTE_STRIDE)
+                        return _set(mDocument.bufferViews.back().byteStride, static_cast<uint32>(value));
+                    break;
+                case Context::C_ACCESSOR:
+                    if (frame.key == Key::K_BYTE_OFFSET)
+                        return _set(mDocument.accessors.back().byteOffset, value);
+                    if (frame.key == Key::K_COUNT)
+                        return _set(mDocument.accessors.back().count, value);
+                    if (frame.key == Key::K_COMPONENT_TYPE)
+                        return _set(mDocument.accessors.back().componentType, static_cast<GltfComponentType>(value));
+                    break;
+                case Context::C_PRIMITIVE:
+                    if (frame.key == Key::K_MODE)
+                        return _set(mDocument.meshes.back().primitives.back().mode, static_cast<int32>(std::min<uint64>(value, std::numeric_limits<int32>::max())));
+                    break;
+                default:
+                    break;
+                }
+                return _scalar();
+            }
+
+            bool number_float(Json::number_float_t value, const Json::string_t&)
+            {
+                if (!mSkipDepth && mFrames.size() && mFrames.back().context == Context::C_NUMBERS)
+                    return _number(value);
+                return _scalar();
+            }
+
+            bool string(Json::string_t& value)
+            {
+                if (_inObject(Context::C_BUFFER, Key::K_URI))
+                {
+                    mDocument.buffers.back().uri = std::move(value);
+                    return true;
+                }
+                if (_inObject(Context::C_IMAGE, Key::K_URI))
+                {
+                    mDocument.images.back().uri = std::move(value);
+                    return true;
+                }
+                if (_inObject(Context::C_IMAGE, Key::K_MIME_TYPE))
+                {
+                    mDocument.images.back().mimeType = std::move(value);
+                    return true;
+                }
+                if (_inObject(Context::C_ACCESSOR, Key::K_TYPE))
+                {
+                    mDocument.accessors.back().componentCount = getComponentCount(value);
+                    if (!mDocument.accessors.back().componentCount)
+                        return _fail("Unknown glTF accessor type " + value);
+                    return true;
+                }
+                return _scalar();
+            }
+
+            bool binary(Json::binary_t&) { return _scalar(); }
+
+            bool key(Json::string_t& name)
+            {
+                if (!mSkipDepth)
+                    mFrames.back().key = findKey(name);
+                return true;
+            }
+
+            bool start_object(size_t)
+            {
+                if (mSkipDepth)
+                {
+                    ++mSkipDepth;
+                    return true;
+                }
+                if (mFrames.empty())
+                {
+                    mFrames.push_back({ Context::C_ROOT });
+                    return true;
+                }
+
+                auto& frame = mFrames.back();
+                switch (frame.context)
+                {
+                case Context::C_BUFFERS:
+                    mDocument.buffers.emplace_back();
+                    return _push(Context::C_BUFFER);
+                case Context::C_BUFFER_VIEWS:
+                    mDocument.bufferViews.emplace_back();
+                    return _push(Context::C_BUFFER_VIEW);
+                case Context::C_ACCESSORS:
+                    // Left invalid so a missing componentType is caught.
+                    mDocument.accessors.emplace_back().componentType = static_cast<GltfComponentType>(0);
+                    return _push(Context::C_ACCESSOR);
+                case Context::C_MESHES:
+                    mDocument.meshes.emplace_back();
+                    return _push(Context::C_MESH);
+                case Context::C_PRIMITIVES:
+                    mDocument.meshes.back().primitives.emplace_back();
+                    mHasAttributes = false;
+                    return _push(Context::C_PRIMITIVE);
+                case Context::C_NODES:
+                    mDocument.nodes.emplace_back();
+                    return _push(Context::C_NODE);
+                case Context::C_SCENES:
+                    mDocument.scenes.emplace_back();
+                    return _push(Context::C_SCENE);
+                case Context::C_IMAGES:
+                    mDocument.images.emplace_back();
+                    return _push(Context::C_IMAGE);
+                case Context::C_PRIMITIVE:
+                    if (frame.key == Key::K_ATTRIBUTES)
+                    {
+                        mHasAttributes = true;
+                        return _push(Context::C_ATTRIBUTES);
+                    }
+                    break;
+                case Context::C_ACCESSOR:
+                    if (frame.key == Key::K_SPARSE)
+                        mDocument.accessors.back().sparse = true;
+                    break;
+                case Context::C_NUMBERS:
+                case Context::C_INDICES:
+                    return _fail("glTF array holds an object where a number belongs");
+                default:
+                    break;
+                }
+                if (_isArrayOfObjects(frame.context))
+                    return _fail("glTF array holds a value that is not an object");
+                if (_isKnownKey())
+                    return _fail("glTF property has the wrong type");
+                ++mSkipDepth;
+                return true;
+            }
+
+            bool end_object()
+            {
+                if (mSkipDepth)
+                {
+                    --mSkipDepth;
+                    return true;
+                }
+                switch (mFrames.back().context)
+                {
+                case Context::C_ACCESSOR:
+                {
+                    const auto& accessor = mDocument.accessors.back();
+                    if (!accessor.componentCount)
+                        return _fail("glTF accessor without a type");
+                    switch (accessor.componentType)
+                    {
+                    case GltfComponentType::GCT_BYTE:
+                    case GltfComponentType::GCT_UNSIGNED_BYTE:
+                    case GltfComponentType::GCT_SHORT:
+                    case GltfComponentType::GCT_UNSIGNED_SHORT:
+                    case GltfComponentType::GCT_UNSIGNED_INT:
+                    case GltfComponentType::GCT_FLOAT:
+                        break;
+                    default:
+                        return _fail("Unknown glTF component type");
+                    }
+                    break;
+                }
+                case Context::C_PRIMITIVE:
+                    if (!mHasAttributes)
+                        return _fail("glTF primitive without attributes");
+                    break;
+                default:
+                    break;
+                }
+                mFrames.pop_back();
+                return true;
+            }
+
+            bool start_array(size_t)
+            {
+                if (mSkipDepth)
+                {
+                    ++mSkipDepth;
+                    return true;
+                }
+                if (mFrames.empty())
+                    return _fail("glTF JSON must be an object");
+
+                auto& frame = mFrames.back();
+                switch (frame.context)
+                {
+                case Context::C_ROOT:
+                    switch (frame.key)
+                    {
+                    case Key::K_BUFFERS:
+                        return _push(Context::C_BUFFERS);
+                    case Key::K_BUFFER_VIEWS:
+                        return _push(Context::C_BUFFER_VIEWS);
+                    case Key::K_ACCESSORS:
+                        return _push(Context::C_ACCESSORS);
+                    case Key::K_MESHES:
+                        return _push(Context::C_MESHES);
+                    case Key::K_NODES:
+                        return _push(Context::C_NODES);
+                    case Key::K_SCENES:
+                        return _push(Context::C_SCENES);
+                    case Key::K_IMAGES:
+                        return _push(Context::C_IMAGES);
+                    default:
+                        break;
+                    }
+                    break;
+                case Context::C_MESH:
+                    if (frame.key == Key::K_PRIMITIVES)
+                        return _push(Context::C_PRIMITIVES);
+                    break;
+                case Context::C_NODE:
+                {
+                    auto& node = mDocument.nodes.back();
+                    switch (frame.key)
+                    {
+                    case Key::K_CHILDREN:
+                        return _pushIndices(node.children);
+                    case Key::K_MATRIX:
+                        node.hasMatrix = true;
+                        return _pushNumbers(node.matrix, 16);
+                    case Key::K_TRANSLATION:
+                        return _pushNumbers(node.translation, 3);
+                    case Key::K_ROTATION:
+                        return _pushNumbers(node.rotation, 4);
+                    case Key::K_SCALE:
+                        return _pushNumbers(node.scale, 3);
+                    default:
+                        break;
+                    }
+                    break;
+                }
+                case Context::C_SCENE:
+                    if (frame.key == Key::K_NODES)
+                        return _pushIndices(mDocument.scenes.back().nodes);
+                    break;
+                case Context::C_ACCESSOR:
+                    if (frame.key == Key::K_SPARSE)
+                        mDocument.accessors.back().sparse = true;
+                    break;
+                case Context::C_NUMBERS:
+                case Context::C_INDICES:
+                    return _fail("glTF array holds an array where a number belongs");
+                default:
+                    break;
+                }
+                if (_isArrayOfObjects(frame.context))
+                    return _fail("glTF array holds a value that is not an object");
+                if (_isKnownKey())
+                    return _fail("glTF property has the wrong type");
+                ++mSkipDepth;
+                return true;
+            }
+
+            bool end_array()
+            {
+                if (mSkipDepth)
+                {
+                    --mSkipDepth;
+                    return true;
+                }
+                if (mFrames.back().context == Context::C_NUMBERS && mNumberCount != mExpectedNumberCount)
+                    return _fail("glTF property must be an array of " + std::to_string(mExpectedNumberCount) + " numbers");
+                mFrames.pop_back();
+                return true;
+            }
+
+            bool parse_error(size_t, const std::string&, const Json::exception& e)
+            {
+                return _fail(String("glTF JSON is malformed: ") + e.what());
+            }
+
+            const String& getError() const { return mError; }
+        private:
+            struct Frame
+            {
+                Context context;
+                // Key of the value being parsed, in objects.
+                Key key = Key::K_UNKNOWN;
+            };
+
+            bool _push(Context context)
+            {
+                mFrames.push_back({ context });
+                return true;
+            }
+
+            bool _pushNumbers(double* numbers, uint32 count)
+            {
+                mNumbers = numbers;
+                mNumberCount = 0;
+                mExpectedNumberCount = count;
+                return _push(Context::C_NUMBERS);
+            }
+
+            bool _pushIndices(std::vector<int32>& indices)
+            {
+                mIndices = &indices;
+                return _push(Context::C_INDICES);
+            }
+
+            bool _number(double value)
+            {
+                if (mNumberCount == mExpectedNumberCount)
+                    return _fail("glTF property must be an array of " + std::to_string(mExpectedNumberCount) + " numbers");
+                mNumbers[mNumberCount++] = value;
+                return true;
+            }
+
+            template <typename T>
+            bool _set(T& field, T value)
+            {
+                field = value;
+                return true;
+            }
+
+            bool _inObject(Context context, Key key) const
+            {
+                return !mSkipDepth && mFrames.size() && mFrames.back().context == context && mFrames.back().key == key;
+            }
+
+            // The index property the next value belongs to, if any.
+            int32* _findIndex()
+            {
+                auto& frame = mFrames.back();
+                switch (frame.context)
+                {
+                case Context::C_ROOT:
+                    return frame.key == Key::K_SCENE ? &mDocument.scene : nullptr;
+                case Context::C_BUFFER_VIEW:
+                    return frame.key == Key::K_BUFFER ? &mDocument.bufferViews.back().buffer : nullptr;
+                case Context::C_ACCESSOR:
+                    return frame.key == Key::K_BUFFER_VIEW ? &mDocument.accessors.back().bufferView : nullptr;
+                case Context::C_PRIMITIVE:
+                {
+                    auto& primitive = mDocument.meshes.back().primitives.back();
+                    return frame.key == Key::K_INDICES ? &primitive.indices : frame.key == Key::K_MATERIAL ? &primitive.material : nullptr;
+                }
+                case Context::C_ATTRIBUTES:
+                {
+                    auto& primitive = mDocument.meshes.back().primitives.back();
+                    switch (frame.key)
+                    {
+                    case Key::K_POSITION:
+                        return &primitive.position;
+                    case Key::K_NORMAL:
+                        return &primitive.normal;
+                    case Key::K_TEXCOORD_0:
+                        return &primitive.texCoord;
+                    default:
+                        return nullptr;
+                    }
+                }
+                case Context::C_NODE:
+                    return frame.key == Key::K_MESH ? &mDocument.nodes.back().mesh : nullptr;
+                case Context::C_IMAGE:
+                    return frame.key == Key::K_BUFFER_VIEW ? &mDocument.images.back().bufferView : nullptr;
+                default:
+                    return nullptr;
+                }
+            }
+
+            static bool _isArrayOfObjects(Context context)
+            {
+                return context == Context::C_BUFFERS || context == Context::C_BUFFER_VIEWS || context == Context::C_ACCESSORS ||
+                    context == Context::C_MESHES || context == Context::C_PRIMITIVES || context == Context::C_NODES || context == Context::C_SCENES ||
+                    context == Context::C_IMAGES;
+            }
+
+            // Whether the current key is one the document reads, as opposed to one it skips.
+            bool _isKnownKey() const
+            {
+                auto key = mFrames.back().key;
+                switch (mFrames.back().context)
+                {
+                case Context::C_ROOT:
+                    return key == Key::K_BUFFERS || key == Key::K_BUFFER_VIEWS || key == Key::K_ACCESSORS || key == Key::K_MESHES ||
+                        key == Key::K_NODES || key == Key::K_SCENES || key == Key::K_SCENE || key == Key::K_IMAGES;
+                case Context::C_BUFFER:
+                    return key == Key::K_URI || key == Key::K_BYTE_LENGTH;
+                case Context::C_BUFFER_VIEW:
+                    return key == Key::K_BUFFER || key == Key::K_BYTE_OFFSET || key == Key::K_BYTE_LENGTH || key == Key::K_BYTE_STRIDE;
+                case Context::C_ACCESSOR:
+                    return key == Key::K_BUFFER_VIEW || key == Key::K_BYTE_OFFSET || key == Key::K_COMPONENT_TYPE || key == Key::K_NORMALIZED ||
+                        key == Key::K_COUNT || key == Key::K_TYPE;
+                case Context::C_MESH:
+                    return key == Key::K_PRIMITIVES;
+                case Context::C_PRIMITIVE:
+                    return key == Key::K_ATTRIBUTES || key == Key::K_INDICES || key == Key::K_MATERIAL || key == Key::K_MODE;
+                case Context::C_ATTRIBUTES:
+                    return key == Key::K_POSITION || key == Key::K_NORMAL || key == Key::K_TEXCOORD_0;
+                case Context::C_NODE:
+                    return key == Key::K_MESH || key == Key::K_CHILDREN || key == Key::K_MATRIX || key == Key::K_TRANSLATION ||
+                        key == Key::K_ROTATION || key == Key::K_SCALE;
+                case Context::C_SCENE:
+                    return key == Key::K_NODES;
+                case Context::C_IMAGE:
+                    return key == Key::K_URI || key == Key::K_BUFFER_VIEW || key == Key::K_MIME_TYPE;
+                default:
+                    return false;
+                }
+            }
+
+            // A value that no handler above took.
+            bool _scalar()
+            {
+                if (mSkipDepth)
+                    return true;
+                if (mFrames.empty())
+                    return _fail("glTF JSON must be an object");
+                auto context = mFrames.back().context;
+                if (context == Context::C_NUMBERS)
+                    return _fail("glTF property must be an array of " + std::to_string(mExpectedNumberCount) + " numbers");
+                if (context == Context::C_INDICES)
+                    return _fail("glTF property must hold indices");
+                if (_isArrayOfObjects(context))
+                    return _fail("glTF array holds a value that is not an object");
+                if (context == Context::C_ACCESSOR && mFrames.back().key == Key::K_SPARSE)
+                    mDocument.accessors.back().sparse = true;
+                else if (_isKnownKey())
+                    return _fail("glTF property has the wrong type");
+                return true;
+            }
+
+            bool _fail(String message)
+            {
+                if (mError.empty())
+                    mError = std::move(message);
+                return false;
+            }
+
+            GltfDocument& mDocument;
+            std::vector<Frame> mFrames;
+            // Depth inside a skipped object or array.
+            uint32 mSkipDepth = 0;
+            double* mNumbers = nullptr;
+            uint32 mNumberCount = 0;
+            uint32 mExpectedNumberCount = 0;
+            std::vector<int32>* mIndices = nullptr;
+            bool mHasAttributes = false;
+            String mError;
+        };
+    }
+
+    uint32 getGltfComponentSize(GltfComponentType type)
+    {
+        switch (type)
+        {
+        case GltfComponentType::GCT_BYTE:
+        case GltfComponentType::GCT_UNSIGNED_BYTE:
+            return 1;
+        case GltfComponentType::GCT_SHORT:
+        case GltfComponentType::GCT_UNSIGNED_SHORT:
+            return 2;
+        case GltfComponentType::GCT_UNSIGNED_INT:
+        case GltfComponentType::GCT_FLOAT:
+            return 4;
+        }
+        throw OrcException("Unknown glTF component type");
+    }
+
+    std::array<double, 16> GltfNode::getLocalTransform() const
+    {
+        std::array<double, 16> result;
+        if (hasMatrix)
+        {
+            std::copy(std::begin(matrix), std::end(matrix), result.begin());
+            return result;
+        }
+
+        double x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+        double r[3][3] = {
+            { 1 - 2 * (y * y + z * z), 2 * (x * y - z * w), 2 * (x * z + y * w) },
+            { 2 * (x * y + z * w), 1 - 2 * (x * x + z * z), 2 * (y * z - x * w) },
+            { 2 * (x * z - y * w), 2 * (y * z + x * w), 1 - 2 * (x * x + y * y) },
+        };
+        for (uint32 column = 0; column < 3; ++column)
+        {
+            for (uint32 row = 0; row < 3; ++row)
+                result[column * 4 + row] = r[row][column] * scale[column];
+            result[column * 4 + 3] = 0;
+        }
+        result[12] = translation[0];
+        result[13] = translation[1];
+        result[14] = translation[2];
+        result[15] = 1;
+        return result;
+    }
+
+    GltfDocument parseGltfJson(const char* text, size_t size)
+    {
+        GltfDocument document;
+        SaxHandler handler(document);
+        if (!Json::sax_parse(text, text + size, &handler))
+            throw OrcException(handler.getError().empty() ? String("glTF JSON is malformed") : handler.getError());
+        return document;
+    }
+}
\ No newline at end of file
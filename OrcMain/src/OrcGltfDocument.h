@@ -0,0 +1,113 @@
+#pragma once
+
+#include "OrcTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Orc
+{
+    enum class GltfComponentType
+    {
+        GCT_BYTE = 5120,
+        GCT_UNSIGNED_BYTE = 5121,
+        GCT_SHORT = 5122,
+        GCT_UNSIGNED_SHORT = 5123,
+        GCT_UNSIGNED_INT = 5125,
+        GCT_FLOAT = 5126,
+    };
+
+    uint32 getGltfComponentSize(GltfComponentType type);
+
+    struct GltfBuffer
+    {
+        // Empty for the binary chunk of a .glb.
+        String uri;
+        uint64 byteLength = 0;
+    };
+
+    struct GltfBufferView
+    {
+        int32 buffer = -1;
+        uint64 byteOffset = 0;
+        uint64 byteLength = 0;
+        // 0 when elements are tightly packed.
+        uint32 byteStride = 0;
+    };
+
+    struct GltfAccessor
+    {
+        int32 bufferView = -1;
+        uint64 byteOffset = 0;
+        GltfComponentType componentType = GltfComponentType::GCT_FLOAT;
+        bool normalized = false;
+        uint64 count = 0;
+        // 1 for SCALAR up to 16 for MAT4.
+        uint32 componentCount = 0;
+        bool sparse = false;
+    };
+
+    struct GltfPrimitive
+    {
+        int32 position = -1;
+        int32 normal = -1;
+        int32 texCoord = -1;
+        int32 indices = -1;
+        int32 material = -1;
+        // Triangles unless specified otherwise.
+        int32 mode = 4;
+    };
+
+    struct GltfMesh
+    {
+        std::vector<GltfPrimitive> primitives;
+    };
+
+    struct GltfNode
+    {
+        int32 mesh = -1;
+        std::vector<int32> children;
+        bool hasMatrix = false;
+        // Column-major, like every glTF matrix.
+        double matrix[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+        double translation[3] = { 0, 0, 0 };
+        double rotation[4] = { 0, 0, 0, 1 };
+        double scale[3] = { 1, 1, 1 };
+
+        // The matrix, or the translation, rotation and scale composed into one.
+        std::array<double, 16> getLocalTransform() const;
+    };
+
+    struct GltfScene
+    {
+        std::vector<int32> nodes;
+    };
+
+    // An encoded image, either in a buffer view or behind a URI.
+    struct GltfImage
+    {
+        String uri;
+        int32 bufferView = -1;
+        String mimeType;
+    };
+
+    // The parts of a glTF 2.0 document needed to build meshes and decode their images. Indices into
+    // other arrays, such as GltfAccessor::bufferView or GltfPrimitive::normal, are -1 when the property
+    // is absent.
+    struct GltfDocument
+    {
+        std::vector<GltfBuffer> buffers;
+        std::vector<GltfBufferView> bufferViews;
+        std::vector<GltfAccessor> accessors;
+        std::vector<GltfMesh> meshes;
+        std::vector<GltfNode> nodes;
+        std::vector<GltfScene> scenes;
+        std::vector<GltfImage> images;
+        int32 scene = -1;
+    };
+
+    // Parses the JSON of a .gltf file or the JSON chunk of a .glb. Properties the document does not
+    // hold are skipped. Throws OrcException on malformed input.
+    GltfDocument parseGltfJson(const char* text, size_t size);
+}
\ No newline at end of file
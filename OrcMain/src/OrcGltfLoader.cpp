@@ -0,0 +1,507 @@
+#include "OrcException.h"
+#include "OrcGltfLoader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+
+namespace Orc
+{
+    namespace
+    {
+        using Matrix = std::array<double, 16>;
+
+        constexpr Matrix IDENTITY = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+        constexpr uint32 MAX_NODE_DEPTH = 64;
+        constexpr uint32 GLB_MAGIC = 0x46546C67;
+        constexpr uint32 GLB_CHUNK_JSON = 0x4E4F534A;
+        constexpr uint32 GLB_CHUNK_BIN = 0x004E4942;
+        constexpr int32 MODE_TRIANGLES = 4;
+
+        Matrix multiply(const Matrix& a, const Matrix& b)
+        {
+            Matrix result{};
+            for (uint32 column = 0; column < 4; ++column)
+            {
+                for (uint32 row = 0; row < 4; ++row)
+                {
+                    double sum = 0;
+                    for (uint32 k = 0; k < 4; ++k)
+                        sum += a[k * 4 + row] * b[column * 4 + k];
+                    result[column * 4 + row] = sum;
+                }
+            }
+            return result;
+        }
+
+        uint32 readUint32(const uint8* data)
+        {
+            uint32 value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        float readComponent(const uint8* data, GltfComponentType type, bool normalized, uint32 index)
+        {
+            switch (type)
+            {
+            case GltfComponentType::GCT_FLOAT:
+            {
+                float value;
+                std::memcpy(&value, data + index * sizeof(float), sizeof(float));
+                return value;
+            }
+            case GltfComponentType::GCT_UNSIGNED_BYTE:
+                return normalized ? data[index] / 255.0f : data[index];
+            case GltfComponentType::GCT_UNSIGNED_SHORT:
+            {
+                uint16 value;
+                std::memcpy(&value, data + index * sizeof(uint16), sizeof(uint16));
+                return normalized ? value / 65535.0f : value;
+            }
+            case GltfComponentType::GCT_BYTE:
+            {
+                auto value = static_cast<int8>(data[index]);
+                return normalized ? std::max(value / 127.0f, -1.0f) : value;
+            }
+            case GltfComponentType::GCT_SHORT:
+            {
+                int16 value;
+                std::memcpy(&value, data + index * sizeof(int16), sizeof(int16));
+                return normalized ? std::max(value / 32767.0f, -1.0f) : value;
+            }
+            default:
+                throw OrcException("Unsupported glTF component type");
+            }
+        }
+
+        void readVector(const GltfAccessorView& view, uint64 element, float* values, uint32 componentCount)
+        {
+            const uint8* data = view.data + element * view.stride;
+            if (view.componentType == GltfComponentType::GCT_FLOAT)
+            {
+                std::memcpy(values, data, componentCount * sizeof(float));
+                return;
+            }
+            for (uint32 c = 0; c < componentCount; ++c)
+                values[c] = readComponent(data, view.componentType, view.normalized, c);
+        }
+
+        uint32 readIndex(const GltfAccessorView& view, uint64 element)
+        {
+            const uint8* data = view.data + element * view.stride;
+            switch (view.componentType)
+            {
+            case GltfComponentType::GCT_UNSIGNED_BYTE:
+                return *data;
+            case GltfComponentType::GCT_UNSIGNED_SHORT:
+            {
+                uint16 value;
+                std::memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            default:
+                return readUint32(data);
+            }
+        }
+
+        int decodeBase64Digit(char c)
+        {
+            if (c >= 'A' && c <= 'Z')
+                return c - 'A';
+            if (c >= 'a' && c <= 'z')
+                return c - 'a' + 26;
+            if (c >= '0' && c <= '9')
+                return c - '0' + 52;
+            if (c == '+')
+                return 62;
+            if (c == '/')
+                return 63;
+            return -1;
+        }
+
+        std::vector<uint8> decodeBase64(std::string_view text)
+        {
+            std::vector<uint8> data;
+            data.reserve(text.size() / 4 * 3);
+            uint32 bits = 0;
+            uint32 bitCount = 0;
+            for (char c : text)
+            {
+                if (c == '=')
+                    break;
+                int digit = decodeBase64Digit(c);
+                if (digit < 0)
+                    throw OrcException("glTF data URI is not valid base64");
+                bits = (bits << 6) | static_cast<uint32>(digit);
+                bitCount += 6;
+                if (bitCount >= 8)
+                {
+                    bitCount -= 8;
+                    data.push_back(static_cast<uint8>(bits >> bitCount));
+                }
+            }
+            return data;
+        }
+
+        String decodeUri(const String& uri)
+        {
+            String path;
+            for (size_t i = 0; i < uri.size(); ++i)
+            {
+                if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) && std::isxdigit(static_cast<unsigned char>(uri[i + 2])))
+                {
+                    path.push_back(static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16)));
+                    i += 2;
+                }
+                else
+                    path.push_back(uri[i]);
+            }
+            return path;
+        }
+    }
+
+    GltfAsset::GltfAsset(const String& path)
+    {
+        auto file = std::make_unique<MappedFile>(path);
+        auto data = file->getData();
+        auto size = file->getSize();
+        mMappedFiles.push_back(std::move(file));
+        _parse(data, size, std::filesystem::path(path).parent_path().string());
+    }
+
+    GltfAsset::GltfAsset(const uint8* data, size_t size, const String& baseDirectory)
+    {
+        _parse(data, size, baseDirectory);
+    }
+
+    void GltfAsset::_parse(const uint8* data, size_t size, const String& baseDirectory)
+    {
+        std::span<const uint8> binaryChunk;
+        if (size >= 12 && readUint32(data) == GLB_MAGIC)
+        {
+            if (readUint32(data + 4) != 2)
+                throw OrcException("Only version 2 .glb files are supported");
+            size = std::min<size_t>(size, readUint32(data + 8));
+
+            std::span<const uint8> jsonChunk;
+            size_t offset = 12;
+            while (offset + 8 <= size)
+            {
+                uint64 chunkLength = readUint32(data + offset);
+                uint32 chunkType = readUint32(data + offset + 4);
+                offset += 8;
+                if (chunkLength > size - offset)
+                    throw OrcException(".glb chunk exceeds the file");
+                if (chunkType == GLB_CHUNK_JSON && jsonChunk.empty())
+                    jsonChunk = std::span<const uint8>(data + offset, chunkLength);
+                else if (chunkType == GLB_CHUNK_BIN && binaryChunk.empty())
+                    binaryChunk = std::span<const uint8>(data + offset, chunkLength);
+                offset += (chunkLength + 3) & ~uint64(3);
+            }
+            if (jsonChunk.empty())
+                throw OrcException(".glb file has no JSON chunk");
+            mDocument = parseGltfJson(reinterpret_cast<const char*>(jsonChunk.data()), jsonChunk.size());
+        }
+        else
+            mDocument = parseGltfJson(reinterpret_cast<const char*>(data), size);
+
+        _resolveBuffers(binaryChunk, baseDirectory);
+
+        if (mDocument.scenes.empty())
+        {
+            for (int32 i = 0; i < static_cast<int32>(mDocument.meshes.size()); ++i)
+                _addMesh(i, IDENTITY);
+        }
+        else
+        {
+            auto sceneIndex = mDocument.scene >= 0 && mDocument.scene < static_cast<int32>(mDocument.scenes.size()) ? mDocument.scene : 0;
+            for (int32 node : mDocument.scenes[sceneIndex].nodes)
+                _addNode(node, IDENTITY, 0);
+        }
+    }
+
+    void GltfAsset::_resolveBuffers(std::span<const uint8> binaryChunk, const String& baseDirectory)
+    {
+        for (size_t i = 0; i < mDocument.buffers.size(); ++i)
+        {
+            const auto& buffer = mDocument.buffers[i];
+            std::span<const uint8> data;
+            if (buffer.uri.empty())
+            {
+                if (i != 0 || binaryChunk.empty())
+                    throw OrcException("glTF buffer has no uri");
+                data = binaryChunk;
+            }
+            else
+                data = _resolveUri(buffer.uri, baseDirectory);
+            if (buffer.byteLength > data.size())
+                throw OrcException("glTF buffer is shorter than its byteLength");
+            mBuffers.push_back(data.first(buffer.byteLength));
+        }
+
+        for (const auto& image : mDocument.images)
+        {
+            if (!image.uri.empty())
+                mImages.push_back(_resolveUri(image.uri, baseDirectory));
+            else if (image.bufferView >= 0)
+                mImages.push_back(getBufferView(image.bufferView));
+            else
+                throw OrcException("glTF image has neither a uri nor a bufferView");
+        }
+    }
+
+    std::span<const uint8> GltfAsset::_resolveUri(const String& uri, const String& baseDirectory)
+    {
+        if (uri.starts_with("data:"))
+        {
+            auto base64 = uri.find(";base64,");
+            if (base64 == String::npos)
+                throw OrcException("glTF data URI is not base64 encoded");
+            mEmbeddedBuffers.push_back(decodeBase64(std::string_view(uri).substr(base64 + 8)));
+            return mEmbeddedBuffers.back();
+        }
+        auto path = (std::filesystem::path(baseDirectory) / decodeUri(uri)).string();
+        mMappedFiles.push_back(std::make_unique<MappedFile>(path));
+        return std::span<const uint8>(mMappedFiles.back()->getData(), mMappedFiles.back()->getSize());
+    }
+
+    std::span<const uint8> GltfAsset::getImage(int32 index) const
+    {
+        if (index < 0 || index >= static_cast<int32>(mImages.size()))
+            throw OrcException("glTF image index out of range");
+        return mImages[index];
+    }
+
+    std::span<const uint8> GltfAsset::getBufferView(int32 index) const
+    {
+        if (index < 0 || index >= static_cast<int32>(mDocument.bufferViews.size()))
+            throw OrcException("glTF buffer view index out of range");
+        const auto& view = mDocument.bufferViews[index];
+        if (view.buffer < 0 || view.buffer >= static_cast<int32>(mBuffers.size()))
+            throw OrcException("glTF buffer view references a missing buffer");
+        const auto& buffer = mBuffers[view.buffer];
+        if (view.byteOffset > buffer.size() || view.byteLength > buffer.size() - view.byteOffset)
+            throw OrcException("glTF buffer view exceeds its buffer");
+        return buffer.subspan(view.byteOffset, view.byteLength);
+    }
+
+    GltfAccessorView GltfAsset::getAccessor(int32 index) const
+    {
+        if (index < 0 || index >= static_cast<int32>(mDocument.accessors.size()))
+            throw OrcException("glTF accessor index out of range");
+        const auto& accessor = mDocument.accessors[index];
+        if (accessor.sparse || accessor.bufferView < 0)
+            throw OrcException("Sparse glTF accessors are not supported");
+
+        auto data = getBufferView(accessor.bufferView);
+        uint64 elementSize = getGltfComponentSize(accessor.componentType) * accessor.componentCount;
+        auto byteStride = mDocument.bufferViews[accessor.bufferView].byteStride;
+        GltfAccessorView view;
+        view.stride = byteStride ? byteStride : elementSize;
+        if (accessor.count > 0 && (accessor.count > data.size() || accessor.byteOffset > data.size() ||
+            (accessor.count - 1) * view.stride + elementSize > data.size() - accessor.byteOffset))
+            throw OrcException("glTF accessor exceeds its buffer view");
+        view.data = data.data() + accessor.byteOffset;
+        view.count = accessor.count;
+        view.componentType = accessor.componentType;
+        view.componentCount = accessor.componentCount;
+        view.normalized = accessor.normalized;
+        return view;
+    }
+
+    void GltfAsset::_addNode(int32 nodeIndex, const Matrix& parentTransform, uint32 depth)
+    {
+        if (depth > MAX_NODE_DEPTH || nodeIndex < 0 || nodeIndex >= static_cast<int32>(mDocument.nodes.size()))
+            throw OrcException("Invalid glTF node hierarchy");
+        const auto& node = mDocument.nodes[nodeIndex];
+        auto transform = multiply(parentTransform, node.getLocalTransform());
+        if (node.mesh >= 0)
+            _addMesh(node.mesh, transform);
+        for (int32 child : node.children)
+            _addNode(child, transform, depth + 1);
+    }
+
+    void GltfAsset::_addMesh(int32 meshIndex, const Matrix& transform)
+    {
+        if (meshIndex >= static_cast<int32>(mDocument.meshes.size()))
+            throw OrcException("glTF node references a missing mesh");
+
+        // Checking every accessor now leaves nothing but index values to fail during decoding.
+        uint64 vertexCount = mVertexCount;
+        uint64 indexCount = mIndexCount;
+        for (const auto& primitive : mDocument.meshes[meshIndex].primitives)
+        {
+            if (primitive.mode != MODE_TRIANGLES || primitive.position < 0)
+                continue;
+            auto positions = getAccessor(primitive.position);
+            if (positions.componentCount != 3)
+                throw OrcException("glTF POSITION must be VEC3");
+            if (primitive.normal >= 0)
+            {
+                auto normals = getAccessor(primitive.normal);
+                if (normals.componentCount != 3 || normals.count != positions.count)
+                    throw OrcException("glTF NORMAL must be VEC3 with one element per vertex");
+            }
+            if (primitive.texCoord >= 0)
+            {
+                auto texCoords = getAccessor(primitive.texCoord);
+                if (texCoords.componentCount != 2 || texCoords.count != positions.count)
+                    throw OrcException("glTF TEXCOORD_0 must be VEC2 with one element per vertex");
+            }
+            uint64 primitiveIndexCount = positions.count;
+            if (primitive.indices >= 0)
+            {
+                auto indices = getAccessor(primitive.indices);
+                if (indices.componentCount != 1 || indices.componentType == GltfComponentType::GCT_FLOAT ||
+                    indices.componentType == GltfComponentType::GCT_BYTE || indices.componentType == GltfComponentType::GCT_SHORT)
+                    throw OrcException("Unsupported glTF index type");
+                primitiveIndexCount = indices.count;
+            }
+            vertexCount += positions.count;
+            indexCount += primitiveIndexCount / 3 * 3;
+        }
+        if (vertexCount > std::numeric_limits<uint32>::max() || indexCount > std::numeric_limits<uint32>::max())
+            throw OrcException("glTF mesh is too large");
+        mVertexCount = static_cast<uint32>(vertexCount);
+        mIndexCount = static_cast<uint32>(indexCount);
+        mInstances.push_back({ meshIndex, transform });
+    }
+
+    void GltfAsset::decode(Vertex* vertices, uint32* indices, std::vector<Submesh>& submeshes, BoundingBox& bounds) const
+    {
+        uint32 baseVertex = 0;
+        uint32 indexOffset = 0;
+        bool hasBounds = false;
+        std::vector<Vertex> scratch;
+        submeshes.clear();
+        bounds = BoundingBox();
+
+        for (const auto& instance : mInstances)
+        {
+            const auto& m = instance.transform;
+            // Normals transform by the inverse transpose, the cofactor matrix over the determinant.
+            // cofactor[i * 3 + j] is the cofactor of row j and column i. Normalizing drops the determinant's
+            // magnitude but not its sign, which turns the normals of a mirrored node back outwards.
+            double cofactor[9] = {
+                m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8],
+                m[2] * m[9] - m[1] * m[10], m[0] * m[10] - m[2] * m[8], m[1] * m[8] - m[0] * m[9],
+                m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4],
+            };
+            double determinant = m[0] * cofactor[0] + m[1] * cofactor[1] + m[2] * cofactor[2];
+            // A mirroring transform flips the winding.
+            bool flip = determinant < 0;
+            double normalSign = flip ? -1.0 : 1.0;
+
+            for (const auto& primitive : mDocument.meshes[instance.mesh].primitives)
+            {
+                if (primitive.mode != MODE_TRIANGLES || primitive.position < 0)
+                    continue;
+                auto positions = getAccessor(primitive.position);
+                auto vertexCount = static_cast<uint32>(positions.count);
+                bool hasNormals = primitive.normal >= 0;
+                bool hasTexCoords = primitive.texCoord >= 0;
+                GltfAccessorView normals = hasNormals ? getAccessor(primitive.normal) : GltfAccessorView();
+                GltfAccessorView texCoords = hasTexCoords ? getAccessor(primitive.texCoord) : GltfAccessorView();
+
+                // Vertices without normals are kept back until the faces have been accumulated into them.
+                if (!hasNormals)
+                    scratch.resize(vertexCount);
+                for (uint32 i = 0; i < vertexCount; ++i)
+                {
+                    float p[3];
+                    readVector(positions, i, p, 3);
+                    Vertex vertex{};
+                    for (uint32 row = 0; row < 3; ++row)
+                    {
+                        auto value = static_cast<float>(m[row] * p[0] + m[4 + row] * p[1] + m[8 + row] * p[2] + m[12 + row]);
+                        vertex.position[row] = value;
+                        bounds.min[row] = hasBounds ? std::min(bounds.min[row], value) : value;
+                        bounds.max[row] = hasBounds ? std::max(bounds.max[row], value) : value;
+                    }
+                    hasBounds = true;
+                    if (hasNormals)
+                    {
+                        float n[3];
+                        readVector(normals, i, n, 3);
+                        double transformed[3];
+                        for (uint32 row = 0; row < 3; ++row)
+                            transformed[row] = normalSign * (cofactor[row] * n[0] + cofactor[3 + row] * n[1] + cofactor[6 + row] * n[2]);
+                        double length = std::sqrt(transformed[0] * transformed[0] + transformed[1] * transformed[1] + transformed[2] * transformed[2]);
+                        for (uint32 row = 0; row < 3; ++row)
+                            vertex.normal[row] = length > 0 ? static_cast<float>(transformed[row] / length) : 0.0f;
+                    }
+                    if (hasTexCoords)
+                        readVector(texCoords, i, vertex.texCoord, 2);
+                    if (hasNormals)
+                        vertices[baseVertex + i] = vertex;
+                    else
+                        scratch[i] = vertex;
+                }
+
+                GltfAccessorView indexView = primitive.indices >= 0 ? getAccessor(primitive.indices) : GltfAccessorView();
+                auto triangleCount = static_cast<uint32>((primitive.indices >= 0 ? indexView.count : vertexCount) / 3);
+                for (uint32 t = 0; t < triangleCount; ++t)
+                {
+                    uint32 triangle[3];
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                        triangle[corner] = primitive.indices >= 0 ? readIndex(indexView, t * 3 + corner) : t * 3 + corner;
+                    if (triangle[0] >= vertexCount || triangle[1] >= vertexCount || triangle[2] >= vertexCount)
+                        throw OrcException("glTF index out of range");
+                    if (flip)
+                        std::swap(triangle[1], triangle[2]);
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                        indices[indexOffset + t * 3 + corner] = baseVertex + triangle[corner];
+
+                    if (!hasNormals)
+                    {
+                        const float* a = scratch[triangle[0]].position;
+                        const float* b = scratch[triangle[1]].position;
+                        const float* c = scratch[triangle[2]].position;
+                        float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                        float e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                        // Unnormalized, so larger faces weigh more.
+                        float faceNormal[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+                        for (uint32 corner : triangle)
+                        {
+                            for (uint32 axis = 0; axis < 3; ++axis)
+                                scratch[corner].normal[axis] += faceNormal[axis];
+                        }
+                    }
+                }
+
+                if (!hasNormals)
+                {
+                    for (uint32 i = 0; i < vertexCount; ++i)
+                    {
+                        auto& normal = scratch[i].normal;
+                        float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                        if (length > 0)
+                        {
+                            for (uint32 axis = 0; axis < 3; ++axis)
+                                normal[axis] /= length;
+                        }
+                    }
+                    std::memcpy(vertices + baseVertex, scratch.data(), vertexCount * sizeof(Vertex));
+                }
+
+                submeshes.push_back({ indexOffset, triangleCount * 3, primitive.material });
+                baseVertex += vertexCount;
+                indexOffset += triangleCount * 3;
+            }
+        }
+    }
+
+    MeshData GltfAsset::decode() const
+    {
+        MeshData mesh;
+        mesh.vertices.resize(mVertexCount);
+        mesh.indices.resize(mIndexCount);
+        decode(mesh.vertices.data(), mesh.indices.data(), mesh.submeshes, mesh.bounds);
+        return mesh;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcGltfDocument.h"
+#include "OrcMappedFile.h"
+#include "OrcMesh.h"
+#include "OrcTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Orc
+{
+    // Elements of an accessor, read in place from the buffer that holds them.
+    struct GltfAccessorView
+    {
+        const uint8* data = nullptr;
+        uint64 count = 0;
+        // Bytes between consecutive elements.
+        uint64 stride = 0;
+        GltfComponentType componentType = GltfComponentType::GCT_FLOAT;
+        uint32 componentCount = 0;
+        bool normalized = false;
+    };
+
+    // A glTF asset whose buffers are used where they lie. A .glb, or a .gltf and its external buffers
+    // and images, is memory-mapped and only the JSON is parsed up front; accessors, buffer views and
+    // images are spans into the mappings. Decoding converts vertices and indices straight from the page
+    // cache into the destination, typically a mapped upload buffer, so geometry is copied exactly once.
+    // Throws OrcException on malformed input.
+    class GltfAsset
+    {
+    public:
+        // Maps the file and any external buffers, which are resolved relative to it.
+        GltfAsset(const String& path);
+        // Uses a file already in memory, which must outlive the asset.
+        GltfAsset(const uint8* data, size_t size, const String& baseDirectory);
+        ~GltfAsset() = default;
+
+        const GltfDocument& getDocument() const { return mDocument; }
+        std::span<const uint8> getBufferView(int32 index) const;
+        GltfAccessorView getAccessor(int32 index) const;
+        // The encoded bytes of an image, still compressed.
+        std::span<const uint8> getImage(int32 index) const;
+
+        // Totals over the triangle primitives of the default scene, known once the JSON is parsed.
+        uint32 getVertexCount() const { return mVertexCount; }
+        uint32 getIndexCount() const { return mIndexCount; }
+
+        // Transforms every triangle primitive of the default scene to world space and writes it to
+        // vertices and indices, which must have room for getVertexCount() and getIndexCount() elements.
+        // Both are written front to back and never read, so they may point to write-combined memory.
+        void decode(Vertex* vertices, uint32* indices, std::vector<Submesh>& submeshes, BoundingBox& bounds) const;
+        MeshData decode() const;
+
+        ORC_DISABLE_COPY_AND_MOVE(GltfAsset)
+    private:
+        // A mesh placed in the scene by a node.
+        struct MeshInstance
+        {
+            int32 mesh;
+            std::array<double, 16> transform;
+        };
+
+        void _parse(const uint8* data, size_t size, const String& baseDirectory);
+        void _resolveBuffers(std::span<const uint8> binaryChunk, const String& baseDirectory);
+        std::span<const uint8> _resolveUri(const String& uri, const String& baseDirectory);
+        void _addNode(int32 nodeIndex, const std::array<double, 16>& parentTransform, uint32 depth);
+        void _addMesh(int32 meshIndex, const std::array<double, 16>& transform);
+
+        GltfDocument mDocument;
+        std::vector<std::unique_ptr<MappedFile>> mMappedFiles;
+        // Buffers and images embedded as base64 data URIs, decoded at load.
+        std::vector<std::vector<uint8>> mEmbeddedBuffers;
+        std::vector<std::span<const uint8>> mBuffers;
+        std::vector<std::span<const uint8>> mImages;
+        std::vector<MeshInstance> mInstances;
+        uint32 mVertexCount = 0;
+        uint32 mIndexCount = 0;
+    };
+}
\ No newline at end of file
@@ -1,235 +1,290 @@
 #include "OrcCommandList.h"
 #include "OrcException.h"
 #include "OrcGraphicsDevice.h"
+#include "OrcNullGraphicsDevice.h"
+#include "OrcParallelCommandRecorder.h"
 #include "OrcTypes.h"
 
+#ifdef _WIN32
+#include "OrcD3D12GraphicsDevice.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace Orc
 {
-    GraphicsDevice::GraphicsDevice(HWND hwnd, uint32 width, uint32 height) :
-        mEvent(CreateEventW(nullptr, FALSE, FALSE, nullptr)),
-        mGraphicsEvent(CreateEventW(nullptr, FALSE, FALSE, nullptr)),
-        mCopyEvent(CreateEventW(nullptr, FALSE, FALSE, nullptr)),
-        mComputeEvent(CreateEventW(nullptr, FALSE, FALSE, nullptr))
-    {
-        uint32 factoryFlag = 0;
-#ifdef _DEBUG
-        if (mHD3D12Debug == NULL)
-            mHD3D12Debug = LoadLibraryW(L"D3D12SDKLayers.dll");
-        if (mHDXGIDebug == NULL)
-            mHDXGIDebug = LoadLibraryW(L"dxgidebug.dll");
-        if (mHD3D12Debug)
-        {
-            D3D12GetDebugInterface(IID_PPV_ARGS(&mDebugController));
-            mDebugController->EnableDebugLayer();
-        }
-        if (mHDXGIDebug)
-            factoryFlag = DXGI_CREATE_FACTORY_DEBUG;
-#endif
-        CreateDXGIFactory2(factoryFlag, IID_PPV_ARGS(&mFactory));
-        mFactory->EnumAdapterByGpuPreference(0, DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE, IID_PPV_ARGS(&mAdapter));
-        D3D12CreateDevice(mAdapter.Get(), D3D_FEATURE_LEVEL_12_0, IID_PPV_ARGS(&mDevice));
-
-        D3D12_COMMAND_QUEUE_DESC queueDesc{};
-        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-        mDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&mGraphicsQueue));
-        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
-        mDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&mCopyQueue));
-        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
-        mDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&mComputeQueue));
-
-        _createSwapChain(hwnd, width, height);
-
-        mFrameIndex = mSwapChain->GetCurrentBackBufferIndex();
-        _createRTV();
-
-        mDevice->CreateFence(mFenceValue[mFrameIndex]++, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mFence));
-        mDevice->CreateFence(mGraphicsFenceValue++, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mGraphicsFence));
-        mDevice->CreateFence(mCopyFenceValue++, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mCopyFence));
-        mDevice->CreateFence(mComputeFenceValue++, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mComputeFence));
+    GraphicsDevice::GraphicsDevice(GraphicsBackendType type, const GraphicsSettings& settings, JobSystem* jobSystem) : mBackendType(type), mSettings(settings),
+        mJobSystem(jobSystem)
+    {
+        if (mSettings.backBufferCount < 2 || mSettings.backBufferCount > 16)
+            throw OrcException("Back buffer count must be between 2 and 16");
+        if (mSettings.framesInFlight == 0)
+            throw OrcException("At least one frame must be in flight");
+        mFrameFenceValue.resize(mSettings.framesInFlight);
+        mNextResourceHandle = mSettings.backBufferCount;
+        setPresentMode(mSettings.presentMode, mSettings.frameRateCap);
+        _applyPresentMode();
 
         mGraphicsCommandList = createCommandListContext(CommandListType::CLT_GRAPHICS);
         mCopyCommandList = createCommandListContext(CommandListType::CLT_COPY);
         mComputeCommandList = createCommandListContext(CommandListType::CLT_COMPUTE);
     }
 
-    GraphicsDevice::~GraphicsDevice()
+    GraphicsDevice::~GraphicsDevice() = default;
+
+    std::shared_ptr<GraphicsDevice> GraphicsDevice::create([[maybe_unused]] void* handle, [[maybe_unused]] uint32 width, [[maybe_unused]] uint32 height,
+        const GraphicsSettings& settings, JobSystem* jobSystem)
+    {
+        switch (settings.backend)
+        {
+        case GraphicsBackendType::GBT_D3D12:
+#ifdef _WIN32
+            return std::make_shared<D3D12GraphicsDevice>(*static_cast<HWND*>(handle), width, height, settings, jobSystem);
+#else
+            throw OrcException("D3D12 backend is not supported on this platform");
+#endif
+        case GraphicsBackendType::GBT_NULL:
+            return std::make_shared<NullGraphicsDevice>(settings, jobSystem);
+        }
+        throw OrcException("Unknown graphics backend");
+    }
+
+    std::shared_ptr<CommandListContext> GraphicsDevice::createCommandListContext(CommandListType type)
+    {
+        return std::make_shared<CommandListContext>(type);
+    }
+
+    ParallelCommandRecorder* GraphicsDevice::getParallelCommandRecorder()
     {
-        _wait(CommandListType::CLT_GRAPHICS);
-        _wait(CommandListType::CLT_COPY);
-        _wait(CommandListType::CLT_COMPUTE);
+        if (!mParallelCommandRecorder)
+            mParallelCommandRecorder = std::make_unique<ParallelCommandRecorder>(this, mJobSystem);
+        return mParallelCommandRecorder.get();
     }
 
-    void GraphicsDevice::_wait(CommandListType type)
+    ResourceHandle GraphicsDevice::createBuffer(uint64 size, HeapType heapType)
     {
-        switch (type)
+        ResourceHandle handle;
         {
-        case CommandListType::CLT_GRAPHICS:
-            mGraphicsQueue->Signal(mGraphicsFence.Get(), mGraphicsFenceValue);
-            mGraphicsFence->SetEventOnCompletion(mGraphicsFenceValue++, mGraphicsEvent.Get());
-            if (WaitForSingleObjectEx(mGraphicsEvent.Get(), INFINITE, FALSE) == WAIT_FAILED)
-                throw OrcException("Fail to call WaitForSingleObjectEx");
-            break;
-        case CommandListType::CLT_COPY:
-            mCopyQueue->Signal(mCopyFence.Get(), mCopyFenceValue);
-            mCopyFence->SetEventOnCompletion(mCopyFenceValue++, mCopyEvent.Get());
-            if (WaitForSingleObjectEx(mCopyEvent.Get(), INFINITE, FALSE) == WAIT_FAILED)
-                throw OrcException("Fail to call WaitForSingleObjectEx");
-            break;
-        case CommandListType::CLT_COMPUTE:
-            mComputeQueue->Signal(mComputeFence.Get(), mComputeFenceValue);
-            mComputeFence->SetEventOnCompletion(mComputeFenceValue++, mComputeEvent.Get());
-            if (WaitForSingleObjectEx(mComputeEvent.Get(), INFINITE, FALSE) == WAIT_FAILED)
-                throw OrcException("Fail to call WaitForSingleObjectEx");
-            break;
+            std::lock_guard<std::mutex> lock(mResourceMutex);
+            if (!mFreeResourceHandles.empty())
+            {
+                handle = mFreeResourceHandles.back();
+                mFreeResourceHandles.pop_back();
+            }
+            else if (mNextResourceHandle < ORC_MAX_RESOURCE_COUNT)
+                handle = mNextResourceHandle++;
+            else
+                throw OrcException("Too many resources");
         }
-    }
 
-    void GraphicsDevice::_createSwapChain(HWND hwnd, uint32 width, uint32 height)
-    {
-        DXGI_SWAP_CHAIN_DESC1 scDesc{};
-        scDesc.BufferCount = ORC_SWAPCHAIN_COUNT;
-        scDesc.Width = width;
-        scDesc.Height = height;
-        scDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        scDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-        scDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
-        scDesc.SampleDesc.Count = 1;
-        scDesc.SampleDesc.Quality = 0;
-        scDesc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
-        scDesc.Scaling = DXGI_SCALING_STRETCH;
-        DXGI_SWAP_CHAIN_FULLSCREEN_DESC fsSwapChainDesc{};
-        fsSwapChainDesc.Windowed = TRUE;
-        Microsoft::WRL::ComPtr<IDXGISwapChain1> swapChain;
-        mFactory->CreateSwapChainForHwnd(mGraphicsQueue.Get(), hwnd, &scDesc, &fsSwapChainDesc, nullptr, &swapChain);
-        mFactory->MakeWindowAssociation(hwnd, DXGI_MWA_NO_WINDOW_CHANGES | DXGI_MWA_NO_ALT_ENTER);
-        swapChain.As(&mSwapChain);
-    }
-
-    void GraphicsDevice::_createRTV()
-    {
-        D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc{};
-        rtvHeapDesc.NumDescriptors = ORC_SWAPCHAIN_COUNT;
-        rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-        rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-        mDevice->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&mRtvHeap));
-        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = mRtvHeap->GetCPUDescriptorHandleForHeapStart();
-        mRtvDescriptorSize = mDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-        for (uint32 i = 0; i < ORC_SWAPCHAIN_COUNT; ++i)
+        try
+        {
+            _createBuffer(handle, size, heapType);
+        }
+        catch (...)
         {
-            Microsoft::WRL::ComPtr<ID3D12Resource> renderTarget;
-            mSwapChain->GetBuffer(i, IID_PPV_ARGS(&renderTarget));
-            mDevice->CreateRenderTargetView(renderTarget.Get(), nullptr, rtvHandle);
-            rtvHandle.ptr += mRtvDescriptorSize;
-            mSwapChainRes[i] = renderTarget.Get();
+            std::lock_guard<std::mutex> lock(mResourceMutex);
+            mFreeResourceHandles.push_back(handle);
+            throw;
         }
+        return handle;
     }
 
-    std::shared_ptr<CommandListContext> GraphicsDevice::createCommandListContext(CommandListType type)
+    void GraphicsDevice::releaseResource(ResourceHandle resource)
     {
-        return std::make_shared<CommandListContext>(this, type);
+        if (resource < mSettings.backBufferCount || resource >= ORC_MAX_RESOURCE_COUNT)
+            throw OrcException("Invalid resource handle");
+        _releaseResource(resource);
+        std::lock_guard<std::mutex> lock(mResourceMutex);
+        mFreeResourceHandles.push_back(resource);
     }
 
-    void GraphicsDevice::executeCommandListContext(CommandListContext* context)
+    void GraphicsDevice::releaseResourceAfter(ResourceHandle resource, CommandListType type, uint64 fenceValue)
     {
-        auto tempList = static_cast<ID3D12CommandList*>(context->getRawCommandList());
-        auto type = context->getCommandListType();
-        ID3D12CommandList* tempLists[1] = { tempList };
-        switch (type)
+        if (resource < mSettings.backBufferCount || resource >= ORC_MAX_RESOURCE_COUNT)
+            throw OrcException("Invalid resource handle");
+        if (getQueue(type)->isComplete(fenceValue))
         {
-        case CommandListType::CLT_GRAPHICS:
-            mGraphicsQueue->ExecuteCommandLists(1, tempLists);
-            break;
-        case CommandListType::CLT_COPY:
-            mCopyQueue->ExecuteCommandLists(1, tempLists);
-            break;
-        case CommandListType::CLT_COMPUTE:
-            mComputeQueue->ExecuteCommandLists(1, tempLists);
-            break;
+            releaseResource(resource);
+            return;
         }
+        std::lock_guard<std::mutex> lock(mPendingReleaseMutex);
+        mPendingReleases.push_back({ resource, type, fenceValue });
     }
 
-    void GraphicsDevice::_moveToNextFrame()
+    void GraphicsDevice::_releaseCompletedResources()
     {
-        const uint64 currentFenceValue = mFenceValue[mFrameIndex];
-        mGraphicsQueue->Signal(mFence.Get(), currentFenceValue);
-        mFrameIndex = mSwapChain->GetCurrentBackBufferIndex();
-        if (mFence->GetCompletedValue() < mFenceValue[mFrameIndex])
+        std::vector<ResourceHandle> completed;
         {
-            mFence->SetEventOnCompletion(mFenceValue[mFrameIndex], mEvent.Get());
-            if (WaitForSingleObjectEx(mEvent.Get(), INFINITE, FALSE) == WAIT_FAILED)
-                throw OrcException("Fail to call WaitForSingleObjectEx");
+            std::lock_guard<std::mutex> lock(mPendingReleaseMutex);
+            for (size_t i = 0; i < mPendingReleases.size();)
+            {
+                if (getQueue(mPendingReleases[i].type)->isComplete(mPendingReleases[i].fenceValue))
+                {
+                    completed.push_back(mPendingReleases[i].resource);
+                    mPendingReleases[i] = mPendingReleases.back();
+                    mPendingReleases.pop_back();
+                }
+                else
+                    ++i;
+            }
         }
-        mFenceValue[mFrameIndex] = currentFenceValue + 1;
+        for (auto resource : completed)
+            releaseResource(resource);
     }
 
-    D3D12_CPU_DESCRIPTOR_HANDLE GraphicsDevice::_getCurrentRenderTargetView() const
+    void GraphicsDevice::executeCommandListContext(CommandListContext* context)
     {
-        D3D12_CPU_DESCRIPTOR_HANDLE handle = mRtvHeap->GetCPUDescriptorHandleForHeapStart();
-        handle.ptr += mFrameIndex * mRtvDescriptorSize;
-        return handle;
+        // A batch of the caller's own, since other threads may be submitting at the same time.
+        SubmissionBatch batch;
+        batch.addCommandListContext(context);
+        submitBatch(batch);
     }
 
-    void GraphicsDevice::_clearSwapChainColor(float r, float g, float b, float a)
+    void GraphicsDevice::executeCommandListContexts(const std::vector<CommandListContext*>& contexts)
     {
-        auto rtvHandle = _getCurrentRenderTargetView();
-        float colorRGBA[4] = { r, g, b, a };
-        mGraphicsCommandList->getRawCommandList()->ClearRenderTargetView(rtvHandle, colorRGBA, 0, nullptr);
+        SubmissionBatch batch;
+        batch.addCommandListContexts(contexts);
+        submitBatch(batch);
     }
 
-    void GraphicsDevice::beginDraw()
+    SubmissionResult GraphicsDevice::submitBatch(const SubmissionBatch& batch)
     {
-        mGraphicsCommandList->begin();
-        D3D12_RESOURCE_BARRIER barrier{};
-        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrier.Transition.pResource = mSwapChainRes[mFrameIndex];
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        mGraphicsCommandList->getRawCommandList()->ResourceBarrier(1, &barrier);
-        _clearSwapChainColor(0, 0, 0, 1);
+        std::lock_guard<std::mutex> lock(mSubmitMutex);
+        SubmissionResult result;
+        for (auto type : { CommandListType::CLT_COPY, CommandListType::CLT_COMPUTE, CommandListType::CLT_GRAPHICS })
+        {
+            if (batch.isEmpty(type))
+                continue;
+            for (auto context : batch.getCommandListContexts(type))
+            {
+                if (context->isRecording())
+                    throw OrcException("Command list must be closed before execution");
+            }
+            for (const auto& wait : batch.getQueueWaits(type))
+            {
+                if (wait.fenceValue > getLastSignaledFenceValue(wait.queue))
+                    throw OrcException("Queue wait on a fence value that has not been signaled");
+            }
+
+            auto queue = getQueue(type);
+            for (const auto& wait : batch.getQueueWaits(type))
+            {
+                queue->gpuWait(*getQueue(wait.queue), wait.fenceValue);
+                auto& gpuWaitValue = mGpuWaitValue[static_cast<uint32>(type)][static_cast<uint32>(wait.queue)];
+                gpuWaitValue = std::max(gpuWaitValue, wait.fenceValue);
+            }
+            _executeCommandLists(type, batch.getCommandListContexts(type), queue->getLastSignaledValue() + 1);
+            result.fenceValue[static_cast<uint32>(type)] = queue->signal();
+        }
+        return result;
     }
 
-    void GraphicsDevice::endDraw()
+    void GraphicsDevice::setPresentMode(PresentMode mode, uint32 frameRateCap)
     {
-        D3D12_RESOURCE_BARRIER barrier{};
-        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrier.Transition.pResource = mSwapChainRes[mFrameIndex];
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        mGraphicsCommandList->getRawCommandList()->ResourceBarrier(1, &barrier);
+        if (mode == PresentMode::PM_CAPPED && frameRateCap == 0)
+            throw OrcException("Frame rate cap must be positive");
+        std::lock_guard<std::mutex> lock(mPresentModeMutex);
+        mRequestedPresentMode = mode;
+        mRequestedFrameRateCap = frameRateCap;
+        mPresentModeChanged = true;
+    }
 
-        mGraphicsCommandList->end();
-        executeCommandListContext(mGraphicsCommandList.get());
+    PresentMode GraphicsDevice::getPresentMode() const
+    {
+        std::lock_guard<std::mutex> lock(mPresentModeMutex);
+        return mRequestedPresentMode;
+    }
 
-        mGraphicsQueue->Signal(mGraphicsFence.Get(), mGraphicsFenceValue++);
-        mCopyQueue->Signal(mCopyFence.Get(), mCopyFenceValue++);
-        mComputeQueue->Signal(mComputeFence.Get(), mComputeFenceValue++);
+    void GraphicsDevice::_applyPresentMode()
+    {
+        std::lock_guard<std::mutex> lock(mPresentModeMutex);
+        if (!mPresentModeChanged)
+            return;
+        if (mRequestedPresentMode == PresentMode::PM_CAPPED)
+            mFrameLimiter.setFrameRate(mRequestedFrameRateCap);
+        mSettings.presentMode = mRequestedPresentMode;
+        mSettings.frameRateCap = mRequestedFrameRateCap;
+        mPresentModeChanged = false;
+    }
+
+    bool GraphicsDevice::probeVisibility()
+    {
+        mOccluded = _testOcclusion();
+        return !mOccluded;
+    }
 
-        mSwapChain->Present(1, 0);
-        _moveToNextFrame();
+    void GraphicsDevice::_setPresentClock(std::unique_ptr<PresentClock> clock)
+    {
+        mPresentClock = std::move(clock);
+        mFramePacer = std::make_unique<FramePacer>(mPresentClock.get(), mSettings.framePacingMode, std::chrono::microseconds(mSettings.justInTimeMarginMicroseconds));
+    }
 
-        if (mGraphicsFence->GetCompletedValue() < mGraphicsFenceValue - (ORC_SWAPCHAIN_COUNT - 1))
+    void GraphicsDevice::_moveToNextFrame(uint32 nextBackBufferIndex)
+    {
+        // Every submission already signals its queue, so the frame only records what it depends on.
+        auto& frameFenceValue = mFrameFenceValue[mFrameIndex];
         {
-            mGraphicsFence->SetEventOnCompletion(mGraphicsFenceValue - (ORC_SWAPCHAIN_COUNT - 1), mGraphicsEvent.Get());
-            if (WaitForSingleObjectEx(mGraphicsEvent.Get(), INFINITE, FALSE) == WAIT_FAILED)
-                throw OrcException("Fail to call WaitForSingleObjectEx");
+            std::lock_guard<std::mutex> lock(mSubmitMutex);
+            for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+            {
+                auto lastSignaledValue = mQueues[i]->getLastSignaledValue();
+                frameFenceValue[i] = lastSignaledValue != mLastFrameFenceValue[i] ? lastSignaledValue : 0;
+                mLastFrameFenceValue[i] = lastSignaledValue;
+            }
+            for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+            {
+                for (uint32 j = 0; j < ORC_COMMAND_LIST_TYPE_COUNT; ++j)
+                {
+                    if (i != j && frameFenceValue[i] && frameFenceValue[j] && mGpuWaitValue[j][i] >= frameFenceValue[i])
+                        frameFenceValue[i] = 0;
+                }
+            }
         }
-        if (mCopyFence->GetCompletedValue() < mCopyFenceValue - (ORC_SWAPCHAIN_COUNT - 1))
+
+        mBackBufferIndex = nextBackBufferIndex;
+        mFrameIndex = (mFrameIndex + 1) % mSettings.framesInFlight;
+        for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
         {
-            mCopyFence->SetEventOnCompletion(mCopyFenceValue - (ORC_SWAPCHAIN_COUNT - 1), mCopyEvent.Get());
-            if (WaitForSingleObjectEx(mCopyEvent.Get(), INFINITE, FALSE) == WAIT_FAILED)
-                throw OrcException("Fail to call WaitForSingleObjectEx");
+            if (mFrameFenceValue[mFrameIndex][i])
+                mQueues[i]->waitFor(mFrameFenceValue[mFrameIndex][i]);
         }
-        if (mComputeFence->GetCompletedValue() < mComputeFenceValue - (ORC_SWAPCHAIN_COUNT - 1))
+        _releaseCompletedResources();
+    }
+
+    void GraphicsDevice::_waitForIdle()
+    {
+        for (auto& queue : mQueues)
         {
-            mComputeFence->SetEventOnCompletion(mComputeFenceValue - (ORC_SWAPCHAIN_COUNT - 1), mComputeEvent.Get());
-            if (WaitForSingleObjectEx(mComputeEvent.Get(), INFINITE, FALSE) == WAIT_FAILED)
-                throw OrcException("Fail to call WaitForSingleObjectEx");
+            if (queue)
+                queue->waitForIdle();
         }
+        _releaseCompletedResources();
+    }
+
+    void GraphicsDevice::beginDraw()
+    {
+        _applyPresentMode();
+        mFramePacer->beginFrame();
+        mGraphicsCommandList->begin();
+        mGraphicsCommandList->resourceBarrier(getCurrentBackBuffer(), ResourceState::RS_PRESENT, ResourceState::RS_RENDER_TARGET);
+        mGraphicsCommandList->clearRenderTarget(getCurrentBackBuffer(), 0, 0, 0, 1);
+    }
+
+    void GraphicsDevice::endDraw()
+    {
+        mGraphicsCommandList->resourceBarrier(getCurrentBackBuffer(), ResourceState::RS_RENDER_TARGET, ResourceState::RS_PRESENT);
+        mGraphicsCommandList->end();
+        executeCommandListContext(mGraphicsCommandList.get());
+
+        mFramePacer->endFrame();
+        if (mSettings.presentMode == PresentMode::PM_CAPPED)
+            mFrameLimiter.wait();
+        _present();
+        ++mFrameCount;
     }
 }
\ No newline at end of file
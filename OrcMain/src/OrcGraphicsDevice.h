@@ -2,70 +2,163 @@
 
 #include "OrcPrerequisites.h"
 
+#include "OrcCommandAllocatorPool.h"
 #include "OrcCommandList.h"
+#include "OrcCommandStream.h"
+#include "OrcDefines.h"
+#include "OrcFrameLimiter.h"
+#include "OrcFramePacer.h"
+#include "OrcGraphicsSettings.h"
+#include "OrcPresentClock.h"
+#include "OrcQueue.h"
+#include "OrcSubmissionBatch.h"
 #include "OrcTypes.h"
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
+
+#define ORC_MAX_RESOURCE_COUNT 16384
 
 namespace Orc
 {
+    class JobSystem;
+    class ParallelCommandRecorder;
+
+    enum class HeapType
+    {
+        // GPU local memory, filled through copies.
+        HT_DEFAULT,
+        // CPU writable memory that stays mapped for the lifetime of the buffer.
+        HT_UPLOAD,
+    };
+
     class GraphicsDevice
     {
     public:
-        ID3D12Device4* getRawGraphicsDevice() const { return mDevice.Get(); }
+        // Parallel command list recording runs on jobSystem, which has to outlive the device.
+        static std::shared_ptr<GraphicsDevice> create(void* handle, uint32 width, uint32 height, const GraphicsSettings& settings, JobSystem* jobSystem);
 
         void beginDraw();
         void endDraw();
-        GraphicsDevice(HWND hwnd, uint32 width, uint32 height);
-        ~GraphicsDevice();
 
+        virtual ~GraphicsDevice();
+
+        GraphicsBackendType getBackendType() const { return mBackendType; }
         uint32 getCurrentFrameIndex() const { return mFrameIndex; }
+        uint32 getCurrentBackBufferIndex() const { return mBackBufferIndex; }
+        uint32 getBackBufferCount() const { return mSettings.backBufferCount; }
+        uint32 getFramesInFlight() const { return mSettings.framesInFlight; }
+        uint64 getFrameCount() const { return mFrameCount; }
+        // Back buffers are registered as the first resources, so their handles are their indices.
+        ResourceHandle getCurrentBackBuffer() const { return mBackBufferIndex; }
 
         std::shared_ptr<CommandListContext> createCommandListContext(CommandListType type);
+        // These and submitBatch are safe to call from any thread, so loaders can submit copies while
+        // another thread renders.
         void executeCommandListContext(CommandListContext* context);
-    private:
-        void _createSwapChain(HWND hwnd, uint32 width, uint32 height);
-        void _createRTV();
-        void _moveToNextFrame();
-
-        void _wait(CommandListType type);
-        void _clearSwapChainColor(float r, float g, float b, float a);
-        D3D12_CPU_DESCRIPTOR_HANDLE _getCurrentRenderTargetView() const;
-
-        Microsoft::WRL::ComPtr<IDXGIAdapter4> mAdapter;
-        Microsoft::WRL::ComPtr<ID3D12Debug> mDebugController;
-        Microsoft::WRL::ComPtr<IDXGIFactory7> mFactory;
-        Microsoft::WRL::ComPtr<ID3D12Device4> mDevice;
-        Microsoft::WRL::ComPtr<ID3D12CommandQueue> mGraphicsQueue;
-        Microsoft::WRL::ComPtr<ID3D12CommandQueue> mCopyQueue;
-        Microsoft::WRL::ComPtr<ID3D12CommandQueue> mComputeQueue;
-        Microsoft::WRL::ComPtr<IDXGISwapChain4> mSwapChain;
-        uint32 mFrameIndex = 0;
+        void executeCommandListContexts(const std::vector<CommandListContext*>& contexts);
+        SubmissionResult submitBatch(const SubmissionBatch& batch);
+
+        // Buffers can be created and released from any thread. A resource may only be released once
+        // the GPU is done with it.
+        ResourceHandle createBuffer(uint64 size, HeapType heapType);
+        void releaseResource(ResourceHandle resource);
+        // Releases resource once the queue of the given type reaches fenceValue, right away if it already
+        // has. Pending releases are carried out as frames move on and when the device goes idle.
+        void releaseResourceAfter(ResourceHandle resource, CommandListType type, uint64 fenceValue);
+        uint8* getMappedData(ResourceHandle buffer) { return _getMappedData(buffer); }
+
+        Queue* getQueue(CommandListType type) const { return mQueues[static_cast<uint32>(type)].get(); }
+        uint64 getLastSignaledFenceValue(CommandListType type) const { return getQueue(type)->getLastSignaledValue(); }
 
-        uint64 mFenceValue[ORC_SWAPCHAIN_COUNT]{};
-        Microsoft::WRL::ComPtr<ID3D12Fence1> mFence;
-        Microsoft::WRL::Wrappers::Event mEvent;
+        ParallelCommandRecorder* getParallelCommandRecorder();
+        // Safe to call from any thread. Takes effect when the drawing thread begins its next frame, so it
+        // never changes under a frame being presented. frameRateCap only applies to PM_CAPPED.
+        void setPresentMode(PresentMode mode, uint32 frameRateCap);
+        // The mode last requested, which may not have taken effect yet.
+        PresentMode getPresentMode() const;
+        const FrameLimiter& getFrameLimiter() const { return mFrameLimiter; }
+        FramePacer* getFramePacer() const { return mFramePacer.get(); }
+        PresentClock* getPresentClock() const { return mPresentClock.get(); }
 
-        uint64 mGraphicsFenceValue = 0;
-        Microsoft::WRL::ComPtr<ID3D12Fence1> mGraphicsFence;
-        Microsoft::WRL::Wrappers::Event mGraphicsEvent;
-        uint64 mCopyFenceValue = 0;
-        Microsoft::WRL::ComPtr<ID3D12Fence1> mCopyFence;
-        Microsoft::WRL::Wrappers::Event mCopyEvent;
-        uint64 mComputeFenceValue = 0;
-        Microsoft::WRL::ComPtr<ID3D12Fence1> mComputeFence;
-        Microsoft::WRL::Wrappers::Event mComputeEvent;
-        Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mRtvHeap;
+        // True once a present reported the output as occluded, until probeVisibility() finds it visible.
+        bool isOccluded() const { return mOccluded.load(std::memory_order_relaxed); }
+        // Checks whether a frame would be visible without rendering or presenting one.
+        bool probeVisibility();
 
-        uint32 mRtvDescriptorSize;
+        virtual CommandAllocatorPoolStats getCommandAllocatorPoolStats(CommandListType type) const = 0;
 
-        ID3D12Resource* mSwapChainRes[ORC_SWAPCHAIN_COUNT]{};
+        ORC_DISABLE_COPY_AND_MOVE(GraphicsDevice)
+    protected:
+        GraphicsDevice(GraphicsBackendType type, const GraphicsSettings& settings, JobSystem* jobSystem);
+
+        virtual void _present() = 0;
+        // Returns true if the output is occluded, without presenting anything.
+        virtual bool _testOcclusion() = 0;
+        // Executes the contexts on the queue of the given type. fenceValue is the value the queue signals
+        // once they complete, for tagging the command allocator they were recorded into.
+        virtual void _executeCommandLists(CommandListType type, const std::vector<CommandListContext*>& contexts, uint64 fenceValue) = 0;
+        // Handles are allocated by the base class; back buffers take the first backBufferCount.
+        virtual void _createBuffer(ResourceHandle handle, uint64 size, HeapType heapType) = 0;
+        virtual void _releaseResource(ResourceHandle handle) = 0;
+        virtual uint8* _getMappedData(ResourceHandle handle) = 0;
+
+        void _setPresentClock(std::unique_ptr<PresentClock> clock);
+        void _applyPresentMode();
+        void _moveToNextFrame(uint32 nextBackBufferIndex);
+        // Also releases every pending resource, since nothing is left on the GPU to use them.
+        void _waitForIdle();
+        void _releaseCompletedResources();
+
+        GraphicsBackendType mBackendType;
+        GraphicsSettings mSettings;
+        // Index of the frame in flight, which selects per-frame resources, and of the back buffer.
+        uint32 mFrameIndex = 0;
+        uint32 mBackBufferIndex = 0;
+        uint64 mFrameCount = 0;
+        // Written by whichever thread presents, read by the frame loop.
+        std::atomic<bool> mOccluded{ false };
+        // Per frame in flight, the value each queue must reach before the frame's resources can be reused;
+        // 0 if the queue was idle during that frame or another queue of the frame already waited on it.
+        std::vector<std::array<uint64, ORC_COMMAND_LIST_TYPE_COUNT>> mFrameFenceValue;
+        uint64 mLastFrameFenceValue[ORC_COMMAND_LIST_TYPE_COUNT]{};
+        // Highest value of the second queue that work on the first queue waits on the GPU for.
+        uint64 mGpuWaitValue[ORC_COMMAND_LIST_TYPE_COUNT][ORC_COMMAND_LIST_TYPE_COUNT]{};
+
+        std::unique_ptr<Queue> mQueues[ORC_COMMAND_LIST_TYPE_COUNT];
+        // Serializes submissions with each other and with the frame's fence bookkeeping.
+        std::mutex mSubmitMutex;
+
+        std::mutex mResourceMutex;
+        std::vector<ResourceHandle> mFreeResourceHandles;
+        ResourceHandle mNextResourceHandle;
+
+        struct PendingRelease
+        {
+            ResourceHandle resource;
+            CommandListType type;
+            uint64 fenceValue;
+        };
+        std::mutex mPendingReleaseMutex;
+        std::vector<PendingRelease> mPendingReleases;
 
         std::shared_ptr<CommandListContext> mGraphicsCommandList;
         std::shared_ptr<CommandListContext> mCopyCommandList;
         std::shared_ptr<CommandListContext> mComputeCommandList;
 
-        inline static HMODULE mHD3D12Debug = NULL;
-        inline static HMODULE mHDXGIDebug = NULL;
+        std::unique_ptr<PresentClock> mPresentClock;
+        std::unique_ptr<FramePacer> mFramePacer;
+        FrameLimiter mFrameLimiter;
+        // Requested by setPresentMode and applied to mSettings and mFrameLimiter by _applyPresentMode.
+        mutable std::mutex mPresentModeMutex;
+        PresentMode mRequestedPresentMode;
+        uint32 mRequestedFrameRateCap;
+        bool mPresentModeChanged = false;
+
+        JobSystem* mJobSystem;
+        std::unique_ptr<ParallelCommandRecorder> mParallelCommandRecorder;
     };
 }
\ No newline at end of file
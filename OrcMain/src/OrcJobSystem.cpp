@@ -0,0 +1,450 @@
+#include "OrcCpuPause.h"
+#include "OrcJobSystem.h"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Orc
+{
+    namespace
+    {
+        struct ThreadRegistration
+        {
+            uint64 systemId = 0;
+            uint32 threadIndex = 0;
+        };
+
+        constexpr uint32 JOB_BLOCK_SIZE = 256;
+        // A worker hands its free jobs back to the shared list past this count, so jobs started on one
+        // thread and finished on another do not pile up on the finishing thread.
+        constexpr uint32 MAX_FREE_JOBS_PER_WORKER = 2 * JOB_BLOCK_SIZE;
+        // Failed searches for a job before a worker goes to sleep, or a waiting thread starts yielding.
+        constexpr uint32 IDLE_SPIN_COUNT = 256;
+        constexpr uint32 PARALLEL_FOR_GRAINS_PER_THREAD = 16;
+
+        std::atomic<uint64> sNextSystemId{ 1 };
+        thread_local ThreadRegistration sThreadRegistration;
+        thread_local uint32 sStealSeed = static_cast<uint32>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+
+        uint32 nextRandom()
+        {
+            // xorshift32
+            sStealSeed ^= sStealSeed << 13;
+            sStealSeed ^= sStealSeed >> 17;
+            sStealSeed ^= sStealSeed << 5;
+            return sStealSeed;
+        }
+    }
+
+    struct JobSystem::ParallelForState
+    {
+        JobSystem* system;
+        const RangeFunction* body;
+        uint32 grainSize;
+        JobCounter counter;
+    };
+
+    JobSystem::JobSystem(uint32 threadCount) : mId(sNextSystemId.fetch_add(1, std::memory_order_relaxed))
+    {
+        if (threadCount == 0)
+            threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0)
+            threadCount = 1;
+
+        for (uint32 i = 0; i < threadCount; ++i)
+            mWorkers.push_back(std::make_unique<Worker>());
+        sThreadRegistration = { mId, 0 };
+        for (uint32 i = 1; i < threadCount; ++i)
+            mThreads.emplace_back(&JobSystem::_workerMain, this, i);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        mShutdown.store(true);
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+        }
+        mSleepCondition.notify_all();
+        for (auto& thread : mThreads)
+            thread.join();
+
+        if (sThreadRegistration.systemId == mId)
+            sThreadRegistration = {};
+    }
+
+    uint32 JobSystem::getCurrentThreadIndex() const
+    {
+        return sThreadRegistration.systemId == mId ? sThreadRegistration.threadIndex : getThreadCount();
+    }
+
+    void JobSystem::run(JobFunction function, JobCounter* counter)
+    {
+        auto threadIndex = getCurrentThreadIndex();
+        Job* job = _allocateJob(threadIndex);
+        job->function = std::move(function);
+        job->counter = counter;
+        if (counter)
+            counter->mState.fetch_add(1, std::memory_order_relaxed);
+        _push(job, threadIndex);
+    }
+
+    void JobSystem::run(JobFunction function, JobCounter* counter, JobCounter& dependency)
+    {
+        auto threadIndex = getCurrentThreadIndex();
+        Job* job = _allocateJob(threadIndex);
+        job->function = std::move(function);
+        job->counter = counter;
+        if (counter)
+            counter->mState.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            // The job that brings the dependency to zero takes this lock before starting continuations.
+            std::lock_guard<std::mutex> lock(dependency.mMutex);
+            auto state = dependency.mState.load(std::memory_order_acquire);
+            while ((state & JobCounter::COUNT_MASK) != 0)
+            {
+                if (dependency.mState.compare_exchange_weak(state, state | JobCounter::CONTINUATIONS_BIT, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    dependency.mContinuations.push_back(job);
+                    return;
+                }
+            }
+        }
+        _push(job, threadIndex);
+    }
+
+    void JobSystem::wait(JobCounter& counter)
+    {
+        auto threadIndex = getCurrentThreadIndex();
+        uint32 idleCount = 0;
+        // Also waits for the thread that brought the counter to zero to finish starting its continuations,
+        // after which the counter may be destroyed.
+        while (counter.mState.load(std::memory_order_acquire) != 0)
+        {
+            if (Job* job = _findJob(threadIndex))
+            {
+                _execute(job, threadIndex);
+                idleCount = 0;
+            }
+            else if (++idleCount < IDLE_SPIN_COUNT)
+                ORC_CPU_PAUSE();
+            else
+                std::this_thread::yield();
+        }
+
+        if (counter.mFailed.load(std::memory_order_acquire))
+        {
+            auto exception = counter.mException;
+            counter.mException = nullptr;
+            counter.mFailed.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(exception);
+        }
+    }
+
+    bool JobSystem::tryRunJob()
+    {
+        auto threadIndex = getCurrentThreadIndex();
+        Job* job = _findJob(threadIndex);
+        if (!job)
+            return false;
+        _execute(job, threadIndex);
+        return true;
+    }
+
+    void JobSystem::parallelFor(uint32 count, const RangeFunction& body, uint32 minGrainSize)
+    {
+        if (count == 0)
+            return;
+
+        ParallelForState state;
+        state.system = this;
+        state.body = &body;
+        state.grainSize = std::max({ minGrainSize, count / (PARALLEL_FOR_GRAINS_PER_THREAD * getThreadCount()), 1u });
+
+        // Split off ranges may still be running when the calling thread's part throws, so its exception
+        // is reported through the counter like theirs.
+        try
+        {
+            _runRange(&state, 0, count);
+        }
+        catch (...)
+        {
+            _captureException(state.counter);
+        }
+        wait(state.counter);
+    }
+
+    JobSystemStats JobSystem::getStats() const
+    {
+        JobSystemStats stats;
+        auto add = [&stats](const WorkerStats& workerStats)
+        {
+            stats.executedCount += workerStats.executedCount.load(std::memory_order_relaxed);
+            stats.stolenCount += workerStats.stolenCount.load(std::memory_order_relaxed);
+            stats.inlineCount += workerStats.inlineCount.load(std::memory_order_relaxed);
+            stats.sleepCount += workerStats.sleepCount.load(std::memory_order_relaxed);
+        };
+        for (auto& worker : mWorkers)
+            add(worker->stats);
+        add(mExternalStats);
+        return stats;
+    }
+
+    void JobSystem::resetStats()
+    {
+        auto reset = [](WorkerStats& workerStats)
+        {
+            workerStats.executedCount.store(0, std::memory_order_relaxed);
+            workerStats.stolenCount.store(0, std::memory_order_relaxed);
+            workerStats.inlineCount.store(0, std::memory_order_relaxed);
+            workerStats.sleepCount.store(0, std::memory_order_relaxed);
+        };
+        for (auto& worker : mWorkers)
+            reset(worker->stats);
+        reset(mExternalStats);
+    }
+
+    void JobSystem::_workerMain(uint32 threadIndex)
+    {
+        sThreadRegistration = { mId, threadIndex };
+        auto& stats = mWorkers[threadIndex]->stats;
+
+        uint32 idleCount = 0;
+        while (!mShutdown.load(std::memory_order_relaxed))
+        {
+            // Read before searching: a job pushed after the search bumps the generation and keeps the
+            // worker from sleeping through it.
+            auto generation = mWorkGeneration.load();
+            if (Job* job = _findJob(threadIndex))
+            {
+                _execute(job, threadIndex);
+                idleCount = 0;
+                continue;
+            }
+            if (++idleCount < IDLE_SPIN_COUNT)
+            {
+                ORC_CPU_PAUSE();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mSleepMutex);
+            mSleepingCount.fetch_add(1);
+            stats.sleepCount.fetch_add(1, std::memory_order_relaxed);
+            mSleepCondition.wait(lock, [&] { return mShutdown.load() || mWorkGeneration.load() != generation; });
+            mSleepingCount.fetch_sub(1);
+            idleCount = 0;
+        }
+    }
+
+    Job* JobSystem::_allocateJob(uint32 threadIndex)
+    {
+        Worker* worker = threadIndex < mWorkers.size() ? mWorkers[threadIndex].get() : nullptr;
+        if (worker && worker->freeJobs)
+        {
+            Job* job = worker->freeJobs;
+            worker->freeJobs = job->nextFree;
+            --worker->freeJobCount;
+            return job;
+        }
+
+        std::lock_guard<std::mutex> lock(mSharedMutex);
+        if (!mSharedFreeJobs)
+        {
+            auto block = std::make_unique<Job[]>(JOB_BLOCK_SIZE);
+            for (uint32 i = 0; i + 1 < JOB_BLOCK_SIZE; ++i)
+                block[i].nextFree = &block[i + 1];
+            mSharedFreeJobs = &block[0];
+            mJobBlocks.push_back(std::move(block));
+        }
+
+        Job* job = mSharedFreeJobs;
+        mSharedFreeJobs = job->nextFree;
+        if (worker)
+        {
+            // Take the whole list so the next allocations need no lock.
+            uint32 count = 0;
+            for (Job* free = mSharedFreeJobs; free; free = free->nextFree)
+                ++count;
+            worker->freeJobs = mSharedFreeJobs;
+            worker->freeJobCount = count;
+            mSharedFreeJobs = nullptr;
+        }
+        return job;
+    }
+
+    void JobSystem::_freeJob(Job* job, uint32 threadIndex)
+    {
+        job->function = nullptr;
+        job->counter = nullptr;
+
+        if (threadIndex < mWorkers.size())
+        {
+            auto& worker = *mWorkers[threadIndex];
+            job->nextFree = worker.freeJobs;
+            worker.freeJobs = job;
+            if (++worker.freeJobCount <= MAX_FREE_JOBS_PER_WORKER)
+                return;
+
+            Job* last = job;
+            while (last->nextFree)
+                last = last->nextFree;
+            std::lock_guard<std::mutex> lock(mSharedMutex);
+            last->nextFree = mSharedFreeJobs;
+            mSharedFreeJobs = worker.freeJobs;
+            worker.freeJobs = nullptr;
+            worker.freeJobCount = 0;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mSharedMutex);
+        job->nextFree = mSharedFreeJobs;
+        mSharedFreeJobs = job;
+    }
+
+    void JobSystem::_push(Job* job, uint32 threadIndex)
+    {
+        if (threadIndex < mWorkers.size())
+        {
+            if (!mWorkers[threadIndex]->deque.push(job))
+            {
+                _getStats(threadIndex).inlineCount.fetch_add(1, std::memory_order_relaxed);
+                _execute(job, threadIndex);
+                return;
+            }
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(mSharedMutex);
+            mSharedQueue.push_back(job);
+            mSharedQueueSize.fetch_add(1, std::memory_order_release);
+        }
+
+        mWorkGeneration.fetch_add(1);
+        if (mSleepingCount.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mSleepMutex);
+            }
+            mSleepCondition.notify_one();
+        }
+    }
+
+    bool JobSystem::_hasQueuedJobs(uint32 threadIndex) const
+    {
+        if (threadIndex < mWorkers.size())
+            return mWorkers[threadIndex]->deque.size() > 0;
+        return mSharedQueueSize.load(std::memory_order_relaxed) > 0;
+    }
+
+    Job* JobSystem::_findJob(uint32 threadIndex)
+    {
+        Job* job = nullptr;
+        auto threadCount = static_cast<uint32>(mWorkers.size());
+        if (threadIndex < threadCount && mWorkers[threadIndex]->deque.pop(job))
+            return job;
+
+        if (mSharedQueueSize.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(mSharedMutex);
+            if (!mSharedQueue.empty())
+            {
+                job = mSharedQueue.front();
+                mSharedQueue.pop_front();
+                mSharedQueueSize.fetch_sub(1, std::memory_order_relaxed);
+                _getStats(threadIndex).stolenCount.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        auto start = nextRandom() % threadCount;
+        for (uint32 i = 0; i < threadCount; ++i)
+        {
+            auto victim = (start + i) % threadCount;
+            if (victim != threadIndex && mWorkers[victim]->deque.steal(job))
+            {
+                _getStats(threadIndex).stolenCount.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void JobSystem::_execute(Job* job, uint32 threadIndex)
+    {
+        JobCounter* counter = job->counter;
+        try
+        {
+            job->function();
+        }
+        catch (...)
+        {
+            // Nothing waits for a job without a counter, so its exception could only be dropped.
+            if (!counter)
+                std::terminate();
+            _captureException(*counter);
+        }
+
+        // Captures are released before the counter lets waiters continue.
+        _freeJob(job, threadIndex);
+        _getStats(threadIndex).executedCount.fetch_add(1, std::memory_order_relaxed);
+        if (counter)
+            _finishJob(*counter, threadIndex);
+    }
+
+    void JobSystem::_finishJob(JobCounter& counter, uint32 threadIndex)
+    {
+        // A waiter may destroy the counter as soon as it reads zero, so unless continuations are queued
+        // the decrement is the last access.
+        auto state = counter.mState.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if ((state & JobCounter::COUNT_MASK) != 1 || !(state & JobCounter::CONTINUATIONS_BIT))
+            {
+                if (counter.mState.compare_exchange_weak(state, state - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    return;
+                continue;
+            }
+
+            auto releasing = (state & ~(JobCounter::CONTINUATIONS_BIT | JobCounter::COUNT_MASK)) + JobCounter::RELEASING_ONE;
+            if (counter.mState.compare_exchange_weak(state, releasing, std::memory_order_acq_rel, std::memory_order_relaxed))
+                break;
+        }
+
+        std::vector<Job*> continuations;
+        {
+            std::lock_guard<std::mutex> lock(counter.mMutex);
+            continuations.swap(counter.mContinuations);
+        }
+        for (Job* job : continuations)
+            _push(job, threadIndex);
+        counter.mState.fetch_sub(JobCounter::RELEASING_ONE, std::memory_order_release);
+    }
+
+    void JobSystem::_runRange(ParallelForState* state, uint32 begin, uint32 end)
+    {
+        auto threadIndex = getCurrentThreadIndex();
+        while (begin < end)
+        {
+            if (end - begin > state->grainSize && !_hasQueuedJobs(threadIndex))
+            {
+                auto middle = begin + (end - begin) / 2;
+                run([state, middle, end] { state->system->_runRange(state, middle, end); }, &state->counter);
+                end = middle;
+                continue;
+            }
+
+            auto grainEnd = std::min(end, begin + state->grainSize);
+            (*state->body)(begin, grainEnd);
+            begin = grainEnd;
+        }
+    }
+
+    void JobSystem::_captureException(JobCounter& counter)
+    {
+        if (!counter.mFailed.exchange(true, std::memory_order_acq_rel))
+            counter.mException = std::current_exception();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+#include "OrcWorkStealingDeque.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define ORC_JOB_DEQUE_CAPACITY 4096
+
+namespace Orc
+{
+    class JobSystem;
+    struct Job;
+
+    // Counts the unfinished jobs started with it. Jobs can also be made to depend on a counter, and
+    // start once it drops to zero. The first exception thrown by one of its jobs is rethrown by
+    // JobSystem::wait.
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        ~JobCounter() = default;
+
+        uint32 getValue() const { return static_cast<uint32>(mState.load(std::memory_order_acquire) & COUNT_MASK); }
+        bool isDone() const { return getValue() == 0; }
+
+        ORC_DISABLE_COPY_AND_MOVE(JobCounter)
+    private:
+        friend class JobSystem;
+
+        static constexpr uint64 COUNT_MASK = 0xFFFFFFFF;
+        // Threads that may still touch the counter after bringing it to zero, to start its continuations.
+        static constexpr uint64 RELEASING_ONE = uint64(1) << 32;
+        static constexpr uint64 CONTINUATIONS_BIT = uint64(1) << 63;
+
+        // Unfinished jobs, releasing threads and whether continuations are queued, in one word so a
+        // finishing job decides atomically whether it is the one to start them.
+        std::atomic<uint64> mState{ 0 };
+        std::atomic<bool> mFailed{ false };
+        std::exception_ptr mException;
+        std::mutex mMutex;
+        std::vector<Job*> mContinuations;
+    };
+
+    struct JobSystemStats
+    {
+        uint64 executedCount = 0;
+        // Jobs taken from another thread's deque or from the queue of jobs started by other threads.
+        uint64 stolenCount = 0;
+        // Jobs run by the thread that started them because its deque was full.
+        uint64 inlineCount = 0;
+        uint64 sleepCount = 0;
+    };
+
+    struct Job
+    {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+        Job* nextFree = nullptr;
+    };
+
+    // Work-stealing scheduler. Each worker thread, and the thread that created the system, owns a
+    // Chase-Lev deque of jobs and steals from the others when it runs dry. Threads that wait for a
+    // counter run jobs until it reaches zero instead of blocking, so jobs may wait on other jobs.
+    // Other threads can start and wait for jobs too; their jobs go through a shared queue.
+    class JobSystem
+    {
+    public:
+        using JobFunction = std::function<void()>;
+        using RangeFunction = std::function<void(uint32 begin, uint32 end)>;
+
+        // threadCount includes the calling thread. 0 uses every hardware thread.
+        JobSystem(uint32 threadCount);
+        // Jobs still pending are discarded, so counters should be waited for first.
+        ~JobSystem();
+
+        void run(JobFunction function, JobCounter* counter = nullptr);
+        // Starts the job once dependency reaches zero, right away if it already has.
+        void run(JobFunction function, JobCounter* counter, JobCounter& dependency);
+        void wait(JobCounter& counter);
+        // Runs one queued job on the calling thread. Returns false if none was found.
+        bool tryRunJob();
+
+        // Calls body on disjoint subranges covering [0, count) and waits for them. Each thread works
+        // through its range a grain at a time and splits off the upper half of the rest whenever it has
+        // no queued job left for idle threads to steal, so ranges are only split as far as the load
+        // requires. The grain is count / (16 * thread count), but at least minGrainSize.
+        void parallelFor(uint32 count, const RangeFunction& body, uint32 minGrainSize = 1);
+
+        uint32 getThreadCount() const { return static_cast<uint32>(mWorkers.size()); }
+        // 0 for the thread that created the system, 1 to getThreadCount() - 1 for workers and
+        // getThreadCount() for any other thread.
+        uint32 getCurrentThreadIndex() const;
+
+        JobSystemStats getStats() const;
+        void resetStats();
+
+        ORC_DISABLE_COPY_AND_MOVE(JobSystem)
+    private:
+        struct alignas(64) WorkerStats
+        {
+            std::atomic<uint64> executedCount{ 0 };
+            std::atomic<uint64> stolenCount{ 0 };
+            std::atomic<uint64> inlineCount{ 0 };
+            std::atomic<uint64> sleepCount{ 0 };
+        };
+
+        struct alignas(64) Worker
+        {
+            Worker() : deque(ORC_JOB_DEQUE_CAPACITY) {}
+
+            WorkStealingDeque<Job*> deque;
+            Job* freeJobs = nullptr;
+            uint32 freeJobCount = 0;
+            WorkerStats stats;
+        };
+
+        struct ParallelForState;
+
+        void _workerMain(uint32 threadIndex);
+        Job* _allocateJob(uint32 threadIndex);
+        void _freeJob(Job* job, uint32 threadIndex);
+        void _push(Job* job, uint32 threadIndex);
+        bool _hasQueuedJobs(uint32 threadIndex) const;
+        Job* _findJob(uint32 threadIndex);
+        void _execute(Job* job, uint32 threadIndex);
+        void _finishJob(JobCounter& counter, uint32 threadIndex);
+        void _runRange(ParallelForState* state, uint32 begin, uint32 end);
+        WorkerStats& _getStats(uint32 threadIndex) { return threadIndex < mWorkers.size() ? mWorkers[threadIndex]->stats : mExternalStats; }
+
+        static void _captureException(JobCounter& counter);
+
+        uint64 mId;
+        std::vector<std::unique_ptr<Worker>> mWorkers;
+        WorkerStats mExternalStats;
+        std::vector<std::thread> mThreads;
+
+        // Jobs started by unregistered threads, and the free list and job storage shared by all threads.
+        std::mutex mSharedMutex;
+        std::deque<Job*> mSharedQueue;
+        std::atomic<uint32> mSharedQueueSize{ 0 };
+        Job* mSharedFreeJobs = nullptr;
+        std::vector<std::unique_ptr<Job[]>> mJobBlocks;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mSleepCondition;
+        std::atomic<uint64> mWorkGeneration{ 0 };
+        std::atomic<uint32> mSleepingCount{ 0 };
+        std::atomic<bool> mShutdown{ false };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "OrcLodSelector.h"
+#include "OrcMeshlet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#include <emmintrin.h>
+#define ORC_LOD_SSE2
+#endif
+
+namespace Orc
+{
+    namespace
+    {
+        // Below this share of the triangle budget, the relaxation eases by RELAXATION_RECOVERY each frame.
+        constexpr double RECOVERY_THRESHOLD = 0.75;
+        constexpr float RELAXATION_RECOVERY = 1.05f;
+
+        template <typename T>
+        void removeSlot(std::vector<T>& values, uint32 slot)
+        {
+            values[slot] = values.back();
+            values.pop_back();
+        }
+
+        uint32 getTriangleCount(const std::vector<Submesh>& submeshes)
+        {
+            uint32 indexCount = 0;
+            for (const auto& submesh : submeshes)
+                indexCount += submesh.indexCount;
+            return indexCount / 3;
+        }
+    }
+
+    struct LodSelector::Pass
+    {
+        Frustum frustum;
+        float cameraPosition[3];
+        // Error allowed per unit of distance for an entity to move to a coarser level, and to stay at one.
+        float coarsenErrorPerDistance;
+        float keepErrorPerDistance;
+    };
+
+    uint32 LodSelector::add(const Mesh& mesh)
+    {
+        uint32 slot = getCount();
+        LocalSphere sphere;
+        float squaredRadius = 0.0f;
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            sphere.center[axis] = (mesh.bounds.min[axis] + mesh.bounds.max[axis]) * 0.5f;
+            float halfExtent = (mesh.bounds.max[axis] - mesh.bounds.min[axis]) * 0.5f;
+            squaredRadius += halfExtent * halfExtent;
+        }
+        sphere.radius = std::sqrt(squaredRadius);
+        mLocalSpheres.push_back(sphere);
+        mCenterX.push_back(sphere.center[0]);
+        mCenterY.push_back(sphere.center[1]);
+        mCenterZ.push_back(sphere.center[2]);
+        mRadius.push_back(sphere.radius);
+        mInverseScale.push_back(1.0f);
+
+        // Counting the levels within the error allowed gives the coarsest only if errors never decrease.
+        uint32 lodCount = std::min(static_cast<uint32>(mesh.lods.size()), uint32(ORC_MAX_LOD_COUNT - 1));
+        float error = 0.0f;
+        for (uint32 level = 0; level < ORC_MAX_LOD_COUNT - 1; ++level)
+        {
+            if (level < lodCount)
+                error = std::max(error, mesh.lods[level].error);
+            mErrors[level].push_back(level < lodCount ? error : std::numeric_limits<float>::infinity());
+            mTriangleCounts[level + 1].push_back(level < lodCount ? getTriangleCount(mesh.lods[level].submeshes) : 0);
+        }
+        mTriangleCounts[0].push_back(mesh.submeshes.empty() ? mesh.indexCount / 3 : getTriangleCount(mesh.submeshes));
+        mLevelCount = std::max(mLevelCount, lodCount + 1);
+
+        mLods.push_back(0);
+        mNextLods.push_back(0);
+        mVisible.push_back(0);
+        return slot;
+    }
+
+    void LodSelector::remove(uint32 slot)
+    {
+        removeSlot(mLocalSpheres, slot);
+        removeSlot(mCenterX, slot);
+        removeSlot(mCenterY, slot);
+        removeSlot(mCenterZ, slot);
+        removeSlot(mRadius, slot);
+        removeSlot(mInverseScale, slot);
+        for (auto& errors : mErrors)
+            removeSlot(errors, slot);
+        for (auto& triangleCounts : mTriangleCounts)
+            removeSlot(triangleCounts, slot);
+        removeSlot(mLods, slot);
+        removeSlot(mNextLods, slot);
+        removeSlot(mVisible, slot);
+    }
+
+    void LodSelector::setTransform(uint32 slot, const float (&position)[3], float scale)
+    {
+        const auto& sphere = mLocalSpheres[slot];
+        mCenterX[slot] = position[0] + sphere.center[0] * scale;
+        mCenterY[slot] = position[1] + sphere.center[1] * scale;
+        mCenterZ[slot] = position[2] + sphere.center[2] * scale;
+        mRadius[slot] = sphere.radius * std::abs(scale);
+        mInverseScale[slot] = 1.0f / std::abs(scale);
+    }
+
+    LodSelectionStats LodSelector::select(const Camera& camera, const LodSelectionSettings& settings)
+    {
+        Pass pass;
+        pass.frustum = makeFrustum(camera.viewProjection);
+        std::copy(camera.position, camera.position + 3, pass.cameraPosition);
+        // An error e at distance d spans e * viewportHeight / (2 * tan(verticalFov / 2) * d) pixels.
+        float errorPerDistance = settings.pixelError * 2.0f * std::tan(camera.verticalFov * 0.5f) / std::max(camera.viewportHeight, 1u);
+        float maxRelaxation = std::max(settings.maxRelaxation, 1.0f);
+        float hysteresis = std::clamp(settings.hysteresis, 0.0f, 1.0f);
+        mRelaxation = settings.triangleBudget ? std::clamp(mRelaxation, 1.0f, maxRelaxation) : 1.0f;
+
+        LodSelectionStats stats;
+        stats.entityCount = getCount();
+        for (;;)
+        {
+            pass.coarsenErrorPerDistance = errorPerDistance * mRelaxation * (1.0f - hysteresis);
+            pass.keepErrorPerDistance = errorPerDistance * mRelaxation * (1.0f + hysteresis);
+            uint64 triangleCount = 0, fullDetailTriangleCount = 0;
+            uint32 visibleCount = 0, begin = 0;
+#ifdef ORC_LOD_SSE2
+            if (mVectorized)
+            {
+                begin = getCount() / 4 * 4;
+                _selectVectorized(pass, begin, triangleCount, fullDetailTriangleCount, visibleCount);
+            }
+#endif
+            _selectScalar(pass, begin, getCount(), triangleCount, fullDetailTriangleCount, visibleCount);
+            stats.visibleCount = visibleCount;
+            stats.triangleCount = triangleCount;
+            stats.fullDetailTriangleCount = fullDetailTriangleCount;
+            ++stats.passCount;
+
+            if (!settings.triangleBudget || triangleCount <= settings.triangleBudget || stats.passCount == ORC_LOD_BUDGET_PASSES || mRelaxation >= maxRelaxation)
+                break;
+            // Triangles fall slower than the error allowed rises, since entities within the hysteresis band or
+            // at their coarsest level keep theirs, so it rises by at least the share over budget.
+            double ratio = static_cast<double>(triangleCount) / settings.triangleBudget;
+            mRelaxation = std::min(mRelaxation * static_cast<float>(std::clamp(ratio, 1.25, 4.0)), maxRelaxation);
+        }
+        mLods.swap(mNextLods);
+        stats.relaxation = mRelaxation;
+
+        // Quality comes back over several frames and only with room to spare, so it does not oscillate
+        // around the budget.
+        if (stats.passCount == 1 && stats.triangleCount < settings.triangleBudget * RECOVERY_THRESHOLD)
+            mRelaxation = std::max(mRelaxation / RELAXATION_RECOVERY, 1.0f);
+        return stats;
+    }
+
+    void LodSelector::_selectScalar(const Pass& pass, uint32 begin, uint32 end, uint64& triangleCount, uint64& fullDetailTriangleCount, uint32& visibleCount)
+    {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            float center[3] = { mCenterX[i], mCenterY[i], mCenterZ[i] };
+            bool visible = isSphereInFrustum(pass.frustum, center, mRadius[i]);
+            mVisible[i] = visible;
+            if (!visible)
+            {
+                mNextLods[i] = mLods[i];
+                continue;
+            }
+
+            float dx = center[0] - pass.cameraPosition[0], dy = center[1] - pass.cameraPosition[1], dz = center[2] - pass.cameraPosition[2];
+            float distance = std::max(std::sqrt(dx * dx + dy * dy + dz * dz) - mRadius[i], 0.0f) * mInverseScale[i];
+            float coarsenError = distance * pass.coarsenErrorPerDistance, keepError = distance * pass.keepErrorPerDistance;
+            uint32 minLod = 0, maxLod = 0;
+            for (uint32 level = 0; level + 1 < mLevelCount; ++level)
+            {
+                minLod += mErrors[level][i] <= coarsenError;
+                maxLod += mErrors[level][i] <= keepError;
+            }
+            uint32 lod = std::clamp(mLods[i], minLod, maxLod);
+            mNextLods[i] = lod;
+            triangleCount += mTriangleCounts[lod][i];
+            fullDetailTriangleCount += mTriangleCounts[0][i];
+            ++visibleCount;
+        }
+    }
+
+    void LodSelector::_selectVectorized(const Pass& pass, uint32 end, uint64& triangleCount, uint64& fullDetailTriangleCount, uint32& visibleCount)
+    {
+#ifdef ORC_LOD_SSE2
+        auto select = [](__m128i mask, __m128i a, __m128i b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); };
+
+        __m128 planes[6][4];
+        for (uint32 plane = 0; plane < 6; ++plane)
+        {
+            for (uint32 component = 0; component < 4; ++component)
+                planes[plane][component] = _mm_set1_ps(pass.frustum.planes[plane][component]);
+        }
+        __m128 cameraX = _mm_set1_ps(pass.cameraPosition[0]), cameraY = _mm_set1_ps(pass.cameraPosition[1]), cameraZ = _mm_set1_ps(pass.cameraPosition[2]);
+        __m128 coarsenErrorPerDistance = _mm_set1_ps(pass.coarsenErrorPerDistance), keepErrorPerDistance = _mm_set1_ps(pass.keepErrorPerDistance);
+        __m128 zero = _mm_setzero_ps();
+        __m128i one = _mm_set1_epi32(1);
+        __m128i triangleSum = _mm_setzero_si128(), fullDetailTriangleSum = _mm_setzero_si128(), visibleSum = _mm_setzero_si128();
+
+        for (uint32 i = 0; i < end; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(&mCenterX[i]), y = _mm_loadu_ps(&mCenterY[i]), z = _mm_loadu_ps(&mCenterZ[i]), radius = _mm_loadu_ps(&mRadius[i]);
+            __m128 negativeRadius = _mm_sub_ps(zero, radius);
+            __m128 inside = _mm_cmpeq_ps(zero, zero);
+            for (const auto& plane : planes)
+            {
+                // Summed in the same order as isSphereInFrustum, so both paths agree at the planes.
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[0], x), _mm_mul_ps(plane[1], y)), _mm_mul_ps(plane[2], z)), plane[3]);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+            }
+            __m128i visible = _mm_castps_si128(inside);
+
+            __m128 dx = _mm_sub_ps(x, cameraX), dy = _mm_sub_ps(y, cameraY), dz = _mm_sub_ps(z, cameraZ);
+            __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+            distance = _mm_mul_ps(_mm_max_ps(_mm_sub_ps(distance, radius), zero), _mm_loadu_ps(&mInverseScale[i]));
+            __m128 coarsenError = _mm_mul_ps(distance, coarsenErrorPerDistance), keepError = _mm_mul_ps(distance, keepErrorPerDistance);
+            // Comparisons give all bits set, -1, for each level within the error.
+            __m128i minLod = _mm_setzero_si128(), maxLod = _mm_setzero_si128();
+            for (uint32 level = 0; level + 1 < mLevelCount; ++level)
+            {
+                __m128 error = _mm_loadu_ps(&mErrors[level][i]);
+                minLod = _mm_sub_epi32(minLod, _mm_castps_si128(_mm_cmple_ps(error, coarsenError)));
+                maxLod = _mm_sub_epi32(maxLod, _mm_castps_si128(_mm_cmple_ps(error, keepError)));
+            }
+            __m128i previousLod = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&mLods[i]));
+            __m128i lod = select(_mm_cmplt_epi32(previousLod, minLod), minLod, previousLod);
+            lod = select(_mm_cmpgt_epi32(lod, maxLod), maxLod, lod);
+            lod = select(visible, lod, previousLod);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&mNextLods[i]), lod);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&mVisible[i]), _mm_and_si128(visible, one));
+
+            __m128i triangles = _mm_setzero_si128();
+            for (uint32 level = 0; level < mLevelCount; ++level)
+            {
+                __m128i selected = _mm_cmpeq_epi32(lod, _mm_set1_epi32(static_cast<int>(level)));
+                triangles = _mm_or_si128(triangles, _mm_and_si128(selected, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&mTriangleCounts[level][i]))));
+            }
+            triangles = _mm_and_si128(triangles, visible);
+            __m128i fullDetailTriangles = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&mTriangleCounts[0][i])), visible);
+            // Sums go to 64-bit lanes, which many entities of many triangles would overflow otherwise.
+            __m128i zeroInteger = _mm_setzero_si128();
+            triangleSum = _mm_add_epi64(triangleSum, _mm_add_epi64(_mm_unpacklo_epi32(triangles, zeroInteger), _mm_unpackhi_epi32(triangles, zeroInteger)));
+            fullDetailTriangleSum = _mm_add_epi64(fullDetailTriangleSum,
+                _mm_add_epi64(_mm_unpacklo_epi32(fullDetailTriangles, zeroInteger), _mm_unpackhi_epi32(fullDetailTriangles, zeroInteger)));
+            visibleSum = _mm_sub_epi32(visibleSum, visible);
+        }
+
+        alignas(16) uint64 sums[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(sums), triangleSum);
+        triangleCount += sums[0] + sums[1];
+        _mm_store_si128(reinterpret_cast<__m128i*>(sums), fullDetailTriangleSum);
+        fullDetailTriangleCount += sums[0] + sums[1];
+        alignas(16) uint32 counts[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(counts), visibleSum);
+        visibleCount += counts[0] + counts[1] + counts[2] + counts[3];
+#endif
+    }
+}
\ No newline at end of file
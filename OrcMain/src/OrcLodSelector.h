@@ -0,0 +1,76 @@
+#pragma once
+
+#include "OrcCamera.h"
+#include "OrcDefines.h"
+#include "OrcManager.h"
+#include "OrcMesh.h"
+#include "OrcTypes.h"
+
+#include <vector>
+
+// Levels of detail an entity can select from, the full-detail one included. Coarser levels of a mesh
+// beyond this are ignored.
+#define ORC_MAX_LOD_COUNT 8
+
+// Times selection runs within a frame when the triangle budget is exceeded, relaxing quality each time.
+#define ORC_LOD_BUDGET_PASSES 4
+
+namespace Orc
+{
+    // Selects a level of detail for many entities at once from the screen-space size of each level's
+    // error. Entities are kept as structures of arrays indexed by slot, so one pass tests their bounding
+    // spheres against the frustum and picks their levels four at a time with SSE2.
+    class LodSelector
+    {
+    public:
+        LodSelector() {}
+
+        // Returns the slot of an entity drawing mesh, at the origin and unscaled until setTransform.
+        uint32 add(const Mesh& mesh);
+        // Moves the last slot into slot.
+        void remove(uint32 slot);
+        void setTransform(uint32 slot, const float (&position)[3], float scale);
+        uint32 getCount() const { return static_cast<uint32>(mLods.size()); }
+        uint32 getLod(uint32 slot) const { return mLods[slot]; }
+        bool isVisible(uint32 slot) const { return mVisible[slot] != 0; }
+
+        // Picks each visible entity's coarsest level whose error projects to at most settings.pixelError,
+        // keeping its current level while that stays within the hysteresis band. Over the triangle
+        // budget, the error allowed is raised and selection runs again, and it only comes back down over
+        // the following frames once the budget allows.
+        LodSelectionStats select(const Camera& camera, const LodSelectionSettings& settings);
+        // Selection without SSE2, which hardware without it always uses.
+        void setVectorized(bool vectorized) { mVectorized = vectorized; }
+
+        ORC_DISABLE_COPY_AND_MOVE(LodSelector)
+    private:
+        struct LocalSphere
+        {
+            float center[3];
+            float radius;
+        };
+
+        struct Pass;
+
+        void _selectScalar(const Pass& pass, uint32 begin, uint32 end, uint64& triangleCount, uint64& fullDetailTriangleCount, uint32& visibleCount);
+        void _selectVectorized(const Pass& pass, uint32 end, uint64& triangleCount, uint64& fullDetailTriangleCount, uint32& visibleCount);
+
+        // World space bounding spheres.
+        std::vector<float> mCenterX;
+        std::vector<float> mCenterY;
+        std::vector<float> mCenterZ;
+        std::vector<float> mRadius;
+        std::vector<float> mInverseScale;
+        // Error of each level after the full-detail one in the mesh's units, infinite past the last.
+        std::vector<float> mErrors[ORC_MAX_LOD_COUNT - 1];
+        std::vector<uint32> mTriangleCounts[ORC_MAX_LOD_COUNT];
+        // Levels selected last frame, and by the latest pass of this one.
+        std::vector<uint32> mLods;
+        std::vector<uint32> mNextLods;
+        std::vector<uint32> mVisible;
+        std::vector<LocalSphere> mLocalSpheres;
+        uint32 mLevelCount = 1;
+        float mRelaxation = 1.0f;
+        bool mVectorized = true;
+    };
+}
\ No newline at end of file
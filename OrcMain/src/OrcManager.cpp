@@ -1,10 +1,60 @@
+#include "OrcAsyncScheduler.h"
+#include "OrcDetail.h"
+#include "OrcEntityLoader.h"
+#include "OrcException.h"
+#include "OrcFrameSnapshot.h"
+#include "OrcLodSelector.h"
 #include "OrcManager.h"
+#include "OrcRoot.h"
+
+#include <memory>
+#include <utility>
 
 namespace Orc
 {
+    SceneManager::SceneManager(Root* root, const String& sceneManagerName) : mRoot(root), mName(sceneManagerName),
+        mLodSelector(std::make_unique<LodSelector>())
+    {
+    }
+
+    SceneManager::~SceneManager()
+    {
+        // Loads still in flight keep their entity alive but must not touch the scene.
+        for (auto& entity : mEntities)
+        {
+            entity->mSceneManager = nullptr;
+            entity->mLodSlot = Entity::NO_LOD_SLOT;
+        }
+    }
+
     Entity* SceneManager::createEntity(const String& entityName, const String& filePath)
     {
-        return nullptr;
+        auto load = _loadEntity(entityName, filePath, 0, true);
+        auto scheduler = mRoot->_getAsyncScheduler();
+        while (!load->isFinished())
+        {
+            if (!scheduler->poll())
+                scheduler->wait();
+        }
+        if (load->getState() == LoadState::LS_FAILED)
+        {
+            destroyEntity(load->getEntity());
+            throw OrcException(load->getError());
+        }
+        return load->getEntity();
+    }
+
+    std::shared_ptr<EntityLoad> SceneManager::createEntityAsync(const String& entityName, const String& filePath, int32 priority)
+    {
+        return _loadEntity(entityName, filePath, priority, false);
+    }
+
+    std::shared_ptr<EntityLoad> SceneManager::_loadEntity(const String& entityName, const String& filePath, int32 priority, bool immediate)
+    {
+        auto entity = std::make_shared<detail::Entity>(entityName);
+        entity->mSceneManager = this;
+        mEntities.push_back(entity);
+        return mRoot->_getEntityLoader()->load(entity, filePath, priority, immediate);
     }
 
     void SceneManager::destroyEntity(Entity* ent)
@@ -13,9 +63,63 @@ namespace Orc
         {
             if (ent == it->get())
             {
+                if (ent->mLodSlot != Entity::NO_LOD_SLOT)
+                {
+                    mLodSelector->remove(ent->mLodSlot);
+                    mLodEntities[ent->mLodSlot] = mLodEntities.back();
+                    mLodEntities[ent->mLodSlot]->mLodSlot = ent->mLodSlot;
+                    mLodEntities.pop_back();
+                    ent->mLodSlot = Entity::NO_LOD_SLOT;
+                }
+                ent->mSceneManager = nullptr;
                 mEntities.erase(it);
+                invalidate();
                 break;
             }
         }
     }
+
+    void SceneManager::_addToLodSelection(Entity* entity)
+    {
+        auto selector = mLodSelector.get();
+        entity->mLodSlot = selector->add(*static_cast<Mesh*>(entity->mMesh.get()));
+        selector->setTransform(entity->mLodSlot, entity->mPosition, entity->mScale);
+        mLodEntities.push_back(entity);
+    }
+
+    void SceneManager::_selectLods()
+    {
+        mLodSelectionStats = mLodSelector->select(mCamera, mLodSelectionSettings);
+    }
+
+    void SceneManager::_buildSnapshot(SceneSnapshot& snapshot) const
+    {
+        snapshot.generation = getGeneration();
+        snapshot.drawItems.clear();
+        // Every ready entity has a slot in the selector, which says whether the camera sees it.
+        for (uint32 slot = 0; slot < mLodSelector->getCount(); ++slot)
+        {
+            if (!mLodSelector->isVisible(slot))
+                continue;
+            auto entity = mLodEntities[slot];
+            DrawItem item;
+            item.mesh = std::static_pointer_cast<Mesh>(entity->mMesh);
+            item.lod = mLodSelector->getLod(slot);
+            snapshot.drawItems.push_back(std::move(item));
+        }
+    }
+
+    void SceneManager::setCamera(const Camera& camera)
+    {
+        if (camera == mCamera)
+            return;
+        mCamera = camera;
+        invalidate();
+    }
+
+    void SceneManager::invalidate()
+    {
+        mGeneration.fetch_add(1, std::memory_order_release);
+        mRoot->invalidate();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "OrcException.h"
+#include "OrcMappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <filesystem>
+
+namespace Orc
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const String& path)
+    {
+        mFile = CreateFileW(std::filesystem::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (mFile == INVALID_HANDLE_VALUE)
+            throw OrcException("Failed to open " + path);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(mFile, &size))
+        {
+            CloseHandle(mFile);
+            throw OrcException("Failed to get the size of " + path);
+        }
+        mSize = static_cast<size_t>(size.QuadPart);
+        // Empty files cannot be mapped.
+        if (mSize == 0)
+            return;
+
+        mMapping = CreateFileMappingW(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mMapping)
+            mData = static_cast<const uint8*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+        if (!mData)
+        {
+            if (mMapping)
+                CloseHandle(mMapping);
+            CloseHandle(mFile);
+            throw OrcException("Failed to map " + path);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (mData)
+            UnmapViewOfFile(mData);
+        if (mMapping)
+            CloseHandle(mMapping);
+        CloseHandle(mFile);
+    }
+#else
+    MappedFile::MappedFile(const String& path)
+    {
+        int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            throw OrcException("Failed to open " + path);
+
+        struct stat status;
+        if (fstat(file, &status) != 0)
+        {
+            close(file);
+            throw OrcException("Failed to get the size of " + path);
+        }
+        mSize = static_cast<size_t>(status.st_size);
+        if (mSize == 0)
+        {
+            close(file);
+            return;
+        }
+
+        // The mapping keeps its own reference to the file.
+        void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+            throw OrcException("Failed to map " + path);
+        madvise(data, mSize, MADV_SEQUENTIAL);
+        mData = static_cast<const uint8*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (mData)
+            munmap(const_cast<uint8*>(mData), mSize);
+    }
+#endif
+}
\ No newline at end of file
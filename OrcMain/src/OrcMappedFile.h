@@ -0,0 +1,33 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <cstddef>
+
+namespace Orc
+{
+    // Read-only view of a whole file in the address space. Pages are faulted in from the page cache on
+    // first access, so nothing is read or copied up front. Throws OrcException if the file cannot be
+    // opened or mapped.
+    class MappedFile
+    {
+    public:
+        MappedFile(const String& path);
+        ~MappedFile();
+
+        const uint8* getData() const { return mData; }
+        size_t getSize() const { return mSize; }
+
+        ORC_DISABLE_COPY_AND_MOVE(MappedFile)
+    private:
+        const uint8* mData = nullptr;
+        size_t mSize = 0;
+#ifdef _WIN32
+        HANDLE mFile = INVALID_HANDLE_VALUE;
+        HANDLE mMapping = NULL;
+#endif
+    };
+}
\ No newline at end of file
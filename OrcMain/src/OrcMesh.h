@@ -0,0 +1,126 @@
+#pragma once
+
+#include "OrcCommandStream.h"
+#include "OrcTexture.h"
+#include "OrcTypes.h"
+
+#include <vector>
+
+namespace Orc
+{
+    struct Vertex
+    {
+        float position[3];
+        float normal[3];
+        float texCoord[2];
+    };
+
+    // Range of a mesh's index buffer drawn with one material.
+    struct Submesh
+    {
+        uint32 indexOffset;
+        uint32 indexCount;
+        int32 materialIndex;
+    };
+
+    struct BoundingBox
+    {
+        float min[3]{};
+        float max[3]{};
+    };
+
+    struct Meshlet
+    {
+        // First entry in MeshletData::vertices and first byte in MeshletData::triangles.
+        uint32 vertexOffset;
+        uint32 triangleOffset;
+        uint32 vertexCount;
+        uint32 triangleCount;
+    };
+
+    // A bounding sphere and a cone containing the normals of a meshlet's triangles. The meshlet faces away
+    // from a camera at position p if dot(normalize(coneApex - p), coneAxis) >= coneCutoff; coneCutoff is
+    // 1 when the normals spread too far for the test to ever pass.
+    struct MeshletBounds
+    {
+        float center[3];
+        float radius;
+        float coneApex[3];
+        float coneAxis[3];
+        float coneCutoff;
+    };
+
+    // Meshlets of a mesh, built separately for each of its submeshes so none crosses a material.
+    struct MeshletData
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshletBounds> bounds;
+        // Indices into the mesh's vertices.
+        std::vector<uint32> vertices;
+        // Three indices into the meshlet's vertices per triangle, each meshlet's padded to 4 bytes.
+        std::vector<uint8> triangles;
+        // First meshlet of each submesh, followed by the meshlet count.
+        std::vector<uint32> submeshOffsets;
+    };
+
+    // A simplified level of a mesh. Its submeshes index the mesh's vertices like the full-detail ones,
+    // further into the index buffer.
+    struct MeshLod
+    {
+        std::vector<Submesh> submeshes;
+        // Estimated distance between this level's surface and the full-detail one, in the mesh's units.
+        float error = 0;
+    };
+
+    // Triangle list geometry on the CPU, as decoded from an asset.
+    struct MeshData
+    {
+        std::vector<Vertex> vertices;
+        std::vector<uint32> indices;
+        std::vector<Submesh> submeshes;
+        BoundingBox bounds;
+        // Levels of detail after the full-detail one, coarsest last.
+        std::vector<MeshLod> lods;
+
+        void computeBounds();
+    };
+
+    // Geometry uploaded to default heap buffers.
+    struct Mesh
+    {
+        ResourceHandle vertexBuffer = 0;
+        ResourceHandle indexBuffer = 0;
+        uint32 vertexCount = 0;
+        uint32 indexCount = 0;
+        std::vector<Submesh> submeshes;
+        BoundingBox bounds;
+        std::vector<MeshLod> lods;
+        // Decoded images of the asset, indexed like its glTF images. Kept on the CPU for now; nothing
+        // samples them yet.
+        std::vector<TextureData> images;
+        // Empty unless built at import. Kept on the CPU like images until meshlets are drawn.
+        MeshletData meshlets;
+        // Graphics fence value of the last frame whose snapshot held the mesh, written by the drawing thread.
+        // The buffers are released once the graphics queue reaches it.
+        uint64 lastFrameFenceValue = 0;
+    };
+
+    inline void MeshData::computeBounds()
+    {
+        if (vertices.empty())
+        {
+            bounds = BoundingBox();
+            return;
+        }
+        for (uint32 axis = 0; axis < 3; ++axis)
+            bounds.min[axis] = bounds.max[axis] = vertices[0].position[axis];
+        for (const auto& vertex : vertices)
+        {
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                bounds.min[axis] = vertex.position[axis] < bounds.min[axis] ? vertex.position[axis] : bounds.min[axis];
+                bounds.max[axis] = vertex.position[axis] > bounds.max[axis] ? vertex.position[axis] : bounds.max[axis];
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,407 @@
+#include "OrcMeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Orc
+{
+    namespace
+    {
+        // Forsyth's scoring model: a larger cache than the one measured against, recently used vertices
+        // scored flat so a triangle's vertices are not penalized for their order, and a bonus for
+        // vertices with few triangles left so none are stranded.
+        constexpr uint32 SCORE_CACHE_SIZE = 32;
+        constexpr uint32 MAX_SCORED_VALENCE = 32;
+        constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr float CACHE_DECAY_POWER = 1.5f;
+        constexpr float VALENCE_BOOST_SCALE = 2.0f;
+        constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+        constexpr uint32 FETCH_LINE_SIZE = 64;
+        constexpr uint32 FETCH_LINE_COUNT = 128;
+        constexpr uint32 INVALID_INDEX = ~0u;
+
+        struct ScoreTables
+        {
+            ScoreTables()
+            {
+                for (uint32 position = 0; position < SCORE_CACHE_SIZE; ++position)
+                {
+                    cache[position] = position < 3 ? LAST_TRIANGLE_SCORE :
+                        std::pow(1.0f - float(position - 3) / (SCORE_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+                }
+                valence[0] = 0;
+                for (uint32 count = 1; count <= MAX_SCORED_VALENCE; ++count)
+                    valence[count] = VALENCE_BOOST_SCALE * std::pow(float(count), -VALENCE_BOOST_POWER);
+            }
+
+            float cache[SCORE_CACHE_SIZE];
+            float valence[MAX_SCORED_VALENCE + 1];
+        };
+
+        float getVertexScore(const ScoreTables& tables, int32 cachePosition, uint32 liveTriangles)
+        {
+            // Vertices without triangles left never make a triangle more attractive.
+            if (liveTriangles == 0)
+                return -1.0f;
+            float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+            return score + tables.valence[std::min(liveTriangles, MAX_SCORED_VALENCE)];
+        }
+
+        // FIFO post-transform cache. A vertex is cached if fewer than size misses happened since its own.
+        class FifoCache
+        {
+        public:
+            FifoCache(uint32 vertexCount, uint32 size) : mStamps(vertexCount, 0), mSize(size), mTime(size + 1) {}
+
+            // Returns true on a miss.
+            bool access(uint32 vertex)
+            {
+                if (mTime - mStamps[vertex] <= mSize)
+                    return false;
+                mStamps[vertex] = mTime++;
+                return true;
+            }
+
+            uint32 accessTriangle(const uint32* triangle) { return access(triangle[0]) + access(triangle[1]) + access(triangle[2]); }
+            void reset() { mTime += mSize + 1; }
+        private:
+            std::vector<uint64> mStamps;
+            uint64 mSize;
+            uint64 mTime;
+        };
+
+        struct Vector3
+        {
+            double x, y, z;
+        };
+
+        Vector3 getPosition(const Vertex& vertex)
+        {
+            return { vertex.position[0], vertex.position[1], vertex.position[2] };
+        }
+
+        // Calls function(indices, vertices, vertexCount) on each submesh of each level of detail, with its
+        // indices rebased to the lowest vertex it uses.
+        template <typename Function>
+        void forEachSubmesh(MeshData& mesh, Function&& function)
+        {
+            std::vector<Submesh> ranges = mesh.submeshes;
+            if (ranges.empty())
+                ranges.push_back({ 0, static_cast<uint32>(mesh.indices.size()), -1 });
+            for (const auto& lod : mesh.lods)
+                ranges.insert(ranges.end(), lod.submeshes.begin(), lod.submeshes.end());
+            for (const auto& range : ranges)
+            {
+                if (range.indexCount == 0)
+                    continue;
+                auto indices = std::span<uint32>(mesh.indices).subspan(range.indexOffset, range.indexCount);
+                auto [low, high] = std::minmax_element(indices.begin(), indices.end());
+                uint32 base = *low;
+                uint32 vertexCount = *high - base + 1;
+                for (auto& index : indices)
+                    index -= base;
+                function(indices, mesh.vertices.data() + base, vertexCount);
+                for (auto& index : indices)
+                    index += base;
+            }
+        }
+    }
+
+    VertexCacheStats analyzeVertexCache(std::span<const uint32> indices, uint32 vertexCount, uint32 cacheSize)
+    {
+        VertexCacheStats stats;
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<bool> referenced(vertexCount);
+        for (uint32 index : indices)
+        {
+            if (!referenced[index])
+            {
+                referenced[index] = true;
+                ++stats.vertexCount;
+            }
+            stats.transformCount += cache.access(index);
+        }
+        if (indices.size() >= 3)
+            stats.acmr = float(double(stats.transformCount) / (indices.size() / 3));
+        if (stats.vertexCount)
+            stats.atvr = float(double(stats.transformCount) / stats.vertexCount);
+        return stats;
+    }
+
+    VertexFetchStats analyzeVertexFetch(std::span<const uint32> indices, uint32 vertexCount, uint32 vertexSize)
+    {
+        VertexFetchStats stats;
+        FifoCache cache(vertexCount, ORC_VERTEX_CACHE_SIZE);
+        std::vector<bool> referenced(vertexCount);
+        uint64 referencedCount = 0;
+        std::vector<uint64> lines(FETCH_LINE_COUNT, std::numeric_limits<uint64>::max());
+        for (uint32 index : indices)
+        {
+            if (!referenced[index])
+            {
+                referenced[index] = true;
+                ++referencedCount;
+            }
+            if (!cache.access(index))
+                continue;
+            uint64 begin = uint64(index) * vertexSize;
+            for (uint64 line = begin / FETCH_LINE_SIZE; line <= (begin + vertexSize - 1) / FETCH_LINE_SIZE; ++line)
+            {
+                auto& slot = lines[line % FETCH_LINE_COUNT];
+                if (slot != line)
+                {
+                    slot = line;
+                    stats.bytesFetched += FETCH_LINE_SIZE;
+                }
+            }
+        }
+        if (referencedCount)
+            stats.overfetch = float(double(stats.bytesFetched) / (referencedCount * vertexSize));
+        return stats;
+    }
+
+    void optimizeVertexCache(std::span<uint32> indices, uint32 vertexCount)
+    {
+        static const ScoreTables tables;
+        auto triangleCount = static_cast<uint32>(indices.size() / 3);
+        if (triangleCount < 2)
+            return;
+
+        // Triangles of each vertex, one entry per reference; the first liveCount[v] are not emitted yet.
+        std::vector<uint32> liveCount(vertexCount, 0);
+        for (uint32 i = 0; i < triangleCount * 3; ++i)
+            ++liveCount[indices[i]];
+        std::vector<uint32> adjacencyOffset(vertexCount + 1, 0);
+        for (uint32 v = 0; v < vertexCount; ++v)
+            adjacencyOffset[v + 1] = adjacencyOffset[v] + liveCount[v];
+        std::vector<uint32> adjacency(triangleCount * 3);
+        {
+            std::vector<uint32> cursor(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (uint32 i = 0; i < triangleCount * 3; ++i)
+                adjacency[cursor[indices[i]]++] = i / 3;
+        }
+
+        std::vector<int32> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+            vertexScore[v] = getVertexScore(tables, -1, liveCount[v]);
+        std::vector<float> triangleScore(triangleCount);
+        uint32 best = 0;
+        for (uint32 t = 0; t < triangleCount; ++t)
+        {
+            triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+            if (triangleScore[t] > triangleScore[best])
+                best = t;
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32> output;
+        output.reserve(triangleCount * 3);
+        uint32 cache[SCORE_CACHE_SIZE + 3];
+        uint32 cacheCount = 0;
+        uint32 inputCursor = 0;
+
+        for (uint32 emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+        {
+            if (best == INVALID_INDEX)
+            {
+                // No cached vertex has triangles left, so continue with the next one in input order.
+                while (emitted[inputCursor])
+                    ++inputCursor;
+                best = inputCursor;
+            }
+            const uint32* triangle = &indices[best * 3];
+            output.insert(output.end(), triangle, triangle + 3);
+            emitted[best] = true;
+
+            uint32 newCache[SCORE_CACHE_SIZE + 3];
+            uint32 newCount = 0;
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                if (std::find(newCache, newCache + newCount, triangle[k]) == newCache + newCount)
+                    newCache[newCount++] = triangle[k];
+            }
+            for (uint32 i = 0; i < cacheCount; ++i)
+            {
+                if (cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2])
+                    newCache[newCount++] = cache[i];
+            }
+
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                uint32 v = triangle[k];
+                uint32* live = &adjacency[adjacencyOffset[v]];
+                auto* position = std::find(live, live + liveCount[v], best);
+                std::swap(*position, live[liveCount[v] - 1]);
+                --liveCount[v];
+            }
+
+            // Vertices pushed out of the modelled cache lose their cache score too.
+            for (uint32 i = 0; i < newCount; ++i)
+                cachePosition[newCache[i]] = i < SCORE_CACHE_SIZE ? static_cast<int32>(i) : -1;
+            for (uint32 i = 0; i < newCount; ++i)
+            {
+                uint32 v = newCache[i];
+                float score = getVertexScore(tables, cachePosition[v], liveCount[v]);
+                float delta = score - vertexScore[v];
+                vertexScore[v] = score;
+                const uint32* live = &adjacency[adjacencyOffset[v]];
+                for (uint32 j = 0; j < liveCount[v]; ++j)
+                    triangleScore[live[j]] += delta;
+            }
+
+            cacheCount = std::min(newCount, SCORE_CACHE_SIZE);
+            std::copy(newCache, newCache + cacheCount, cache);
+            best = INVALID_INDEX;
+            float bestScore = -std::numeric_limits<float>::max();
+            for (uint32 i = 0; i < cacheCount; ++i)
+            {
+                uint32 v = cache[i];
+                const uint32* live = &adjacency[adjacencyOffset[v]];
+                for (uint32 j = 0; j < liveCount[v]; ++j)
+                {
+                    if (triangleScore[live[j]] > bestScore)
+                    {
+                        bestScore = triangleScore[live[j]];
+                        best = live[j];
+                    }
+                }
+            }
+        }
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void optimizeOverdraw(std::span<uint32> indices, const Vertex* vertices, uint32 vertexCount, float threshold)
+    {
+        auto triangleCount = static_cast<uint32>(indices.size() / 3);
+        if (triangleCount < 2)
+            return;
+
+        // A cache-optimized list misses on all three vertices where it jumps to a disjoint patch.
+        FifoCache cache(vertexCount, ORC_VERTEX_CACHE_SIZE);
+        std::vector<uint32> hardBoundaries;
+        for (uint32 t = 0; t < triangleCount; ++t)
+        {
+            if (cache.accessTriangle(&indices[t * 3]) == 3 || t == 0)
+                hardBoundaries.push_back(t);
+        }
+        hardBoundaries.push_back(triangleCount);
+
+        std::vector<uint32> clusters;
+        for (size_t h = 0; h + 1 < hardBoundaries.size(); ++h)
+        {
+            uint32 begin = hardBoundaries[h], end = hardBoundaries[h + 1];
+            cache.reset();
+            uint32 clusterMisses = 0;
+            for (uint32 t = begin; t < end; ++t)
+                clusterMisses += cache.accessTriangle(&indices[t * 3]);
+            double clusterLimit = double(clusterMisses) / (end - begin) * threshold;
+
+            cache.reset();
+            clusters.push_back(begin);
+            uint32 start = begin, misses = 0;
+            for (uint32 t = begin; t + 1 < end; ++t)
+            {
+                misses += cache.accessTriangle(&indices[t * 3]);
+                if (misses <= clusterLimit * (t + 1 - start))
+                {
+                    clusters.push_back(t + 1);
+                    start = t + 1;
+                    misses = 0;
+                    cache.reset();
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+        auto clusterCount = static_cast<uint32>(clusters.size() - 1);
+
+        Vector3 meshCentre{};
+        for (uint32 index : indices.first(triangleCount * 3))
+        {
+            auto p = getPosition(vertices[index]);
+            meshCentre = { meshCentre.x + p.x, meshCentre.y + p.y, meshCentre.z + p.z };
+        }
+        double scale = 1.0 / (triangleCount * 3);
+        meshCentre = { meshCentre.x * scale, meshCentre.y * scale, meshCentre.z * scale };
+
+        std::vector<double> sortKeys(clusterCount);
+        for (uint32 c = 0; c < clusterCount; ++c)
+        {
+            // Area-weighted centroid and normal of the cluster.
+            Vector3 centroid{}, normal{};
+            double area = 0;
+            for (uint32 t = clusters[c]; t < clusters[c + 1]; ++t)
+            {
+                auto a = getPosition(vertices[indices[t * 3]]);
+                auto b = getPosition(vertices[indices[t * 3 + 1]]);
+                auto d = getPosition(vertices[indices[t * 3 + 2]]);
+                Vector3 e1{ b.x - a.x, b.y - a.y, b.z - a.z }, e2{ d.x - a.x, d.y - a.y, d.z - a.z };
+                Vector3 n{ e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+                double w = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+                centroid = { centroid.x + (a.x + b.x + d.x) * w, centroid.y + (a.y + b.y + d.y) * w, centroid.z + (a.z + b.z + d.z) * w };
+                normal = { normal.x + n.x, normal.y + n.y, normal.z + n.z };
+                area += w;
+            }
+            double length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+            if (area == 0 || length == 0)
+                continue;
+            centroid = { centroid.x / (3 * area), centroid.y / (3 * area), centroid.z / (3 * area) };
+            sortKeys[c] = ((centroid.x - meshCentre.x) * normal.x + (centroid.y - meshCentre.y) * normal.y + (centroid.z - meshCentre.z) * normal.z) / length;
+        }
+
+        std::vector<uint32> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32 a, uint32 b) { return sortKeys[a] > sortKeys[b]; });
+
+        std::vector<uint32> output;
+        output.reserve(triangleCount * 3);
+        for (uint32 c : order)
+            output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void optimizeVertexFetch(std::vector<Vertex>& vertices, std::span<uint32> indices)
+    {
+        std::vector<uint32> remap(vertices.size(), INVALID_INDEX);
+        std::vector<Vertex> reordered;
+        reordered.reserve(vertices.size());
+        for (auto& index : indices)
+        {
+            if (remap[index] == INVALID_INDEX)
+            {
+                remap[index] = static_cast<uint32>(reordered.size());
+                reordered.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+        vertices = std::move(reordered);
+    }
+
+    MeshOptimizationStats optimizeMesh(MeshData& mesh, const MeshOptimizationSettings& settings)
+    {
+        MeshOptimizationStats stats;
+        auto vertexCount = static_cast<uint32>(mesh.vertices.size());
+        stats.cacheBefore = analyzeVertexCache(mesh.indices, vertexCount);
+        stats.fetchBefore = analyzeVertexFetch(mesh.indices, vertexCount, sizeof(Vertex));
+
+        if (settings.vertexCache)
+        {
+            forEachSubmesh(mesh, [&](std::span<uint32> indices, const Vertex* vertices, uint32 count)
+            {
+                optimizeVertexCache(indices, count);
+                if (settings.overdraw)
+                    optimizeOverdraw(indices, vertices, count, settings.overdrawThreshold);
+            });
+        }
+        if (settings.vertexFetch)
+            optimizeVertexFetch(mesh.vertices, mesh.indices);
+
+        vertexCount = static_cast<uint32>(mesh.vertices.size());
+        stats.cacheAfter = analyzeVertexCache(mesh.indices, vertexCount);
+        stats.fetchAfter = analyzeVertexFetch(mesh.indices, vertexCount, sizeof(Vertex));
+        return stats;
+    }
+}
\ No newline at end of file
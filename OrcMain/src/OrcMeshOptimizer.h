@@ -0,0 +1,67 @@
+#pragma once
+
+#include "OrcMesh.h"
+#include "OrcTypes.h"
+
+#include <span>
+#include <vector>
+
+// Entries of the FIFO post-transform cache that ACMR and ATVR are measured against.
+#define ORC_VERTEX_CACHE_SIZE 16
+
+namespace Orc
+{
+    struct VertexCacheStats
+    {
+        // Vertices the indices reference, and how many times vertices were transformed.
+        uint32 vertexCount = 0;
+        uint64 transformCount = 0;
+        // Transforms per triangle, from 3 down to about 0.5 for regular meshes, and per vertex, down to 1.
+        float acmr = 0;
+        float atvr = 0;
+    };
+
+    struct VertexFetchStats
+    {
+        uint64 bytesFetched = 0;
+        // Bytes fetched over the bytes of the referenced vertices; 1 when each is read once.
+        float overfetch = 0;
+    };
+
+    struct MeshOptimizationSettings
+    {
+        bool vertexCache = true;
+        // Draws outward-facing clusters of triangles first, letting the ACMR of each cluster grow by up to
+        // overdrawThreshold. Only applied after vertex cache optimization.
+        bool overdraw = true;
+        float overdrawThreshold = 1.05f;
+        bool vertexFetch = true;
+    };
+
+    struct MeshOptimizationStats
+    {
+        VertexCacheStats cacheBefore;
+        VertexCacheStats cacheAfter;
+        VertexFetchStats fetchBefore;
+        VertexFetchStats fetchAfter;
+    };
+
+    VertexCacheStats analyzeVertexCache(std::span<const uint32> indices, uint32 vertexCount, uint32 cacheSize = ORC_VERTEX_CACHE_SIZE);
+    // Vertices transformed on post-transform cache misses are read through a small direct-mapped cache of
+    // 64-byte lines.
+    VertexFetchStats analyzeVertexFetch(std::span<const uint32> indices, uint32 vertexCount, uint32 vertexSize);
+
+    // Reorders triangles for post-transform cache hits with Forsyth's linear-speed algorithm, which
+    // greedily emits the triangle whose vertices score highest by cache position and remaining valence.
+    void optimizeVertexCache(std::span<uint32> indices, uint32 vertexCount);
+    // Splits a cache-optimized triangle list into clusters where the cache restarts or, within those,
+    // where the running ACMR stays within threshold of the cluster's, then sorts the clusters so those
+    // facing away from the mesh centre come first and hide what is behind them (Sander et al. 2007).
+    void optimizeOverdraw(std::span<uint32> indices, const Vertex* vertices, uint32 vertexCount, float threshold);
+    // Renumbers vertices in the order the indices first use them and drops unreferenced ones.
+    void optimizeVertexFetch(std::vector<Vertex>& vertices, std::span<uint32> indices);
+
+    // Runs the enabled passes on each submesh of each level of detail, then remaps the vertices of the
+    // whole mesh.
+    MeshOptimizationStats optimizeMesh(MeshData& mesh, const MeshOptimizationSettings& settings);
+}
\ No newline at end of file
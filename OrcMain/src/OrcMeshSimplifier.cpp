@@ -0,0 +1,591 @@
+#include "OrcMeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace Orc
+{
+    namespace
+    {
+        constexpr uint32 ATTRIBUTE_COUNT = 5;
+        // Collapses turning a triangle by more than about 78 degrees would fold the surface over.
+        constexpr double MIN_NORMAL_DOT = 0.2;
+        constexpr double MIN_WEIGHT = 1e-20;
+
+        struct Vector3
+        {
+            double x, y, z;
+
+            Vector3 operator+(const Vector3& other) const { return { x + other.x, y + other.y, z + other.z }; }
+            Vector3 operator-(const Vector3& other) const { return { x - other.x, y - other.y, z - other.z }; }
+            Vector3 operator*(double scale) const { return { x * scale, y * scale, z * scale }; }
+        };
+
+        double dot(const Vector3& a, const Vector3& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        Vector3 cross(const Vector3& a, const Vector3& b)
+        {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        // A weighted sum of squared distances to planes, p^T A p + 2 b.p + c, and the sum of the weights.
+        struct Quadric
+        {
+            double a[6]{};
+            double b[3]{};
+            double c = 0;
+            double weight = 0;
+
+            // Adds w (n.p + d)^2; the caller accounts for w in weight.
+            void addSquare(const Vector3& n, double d, double w)
+            {
+                a[0] += w * n.x * n.x;
+                a[1] += w * n.x * n.y;
+                a[2] += w * n.x * n.z;
+                a[3] += w * n.y * n.y;
+                a[4] += w * n.y * n.z;
+                a[5] += w * n.z * n.z;
+                b[0] += w * n.x * d;
+                b[1] += w * n.y * d;
+                b[2] += w * n.z * d;
+                c += w * d * d;
+            }
+
+            void add(const Quadric& other)
+            {
+                for (uint32 i = 0; i < 6; ++i)
+                    a[i] += other.a[i];
+                for (uint32 i = 0; i < 3; ++i)
+                    b[i] += other.b[i];
+                c += other.c;
+                weight += other.weight;
+            }
+
+            double evaluate(const Vector3& p) const
+            {
+                double x = p.x, y = p.y, z = p.z;
+                return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + a[3] * y * y + 2 * a[4] * y * z + a[5] * z * z +
+                    2 * (b[0] * x + b[1] * y + b[2] * z) + c;
+            }
+        };
+
+        // Hoppe's quadric for attributes s_j that vary linearly over each triangle as g_j.p + d_j: the
+        // weighted sum of (g_j.p + d_j - s_j)^2, split into the part without s and the sums of w g_j and
+        // w d_j.
+        struct AttributeQuadric
+        {
+            Quadric quadric;
+            Vector3 gradients[ATTRIBUTE_COUNT]{};
+            double offsets[ATTRIBUTE_COUNT]{};
+
+            void add(const AttributeQuadric& other)
+            {
+                quadric.add(other.quadric);
+                for (uint32 j = 0; j < ATTRIBUTE_COUNT; ++j)
+                {
+                    gradients[j] = gradients[j] + other.gradients[j];
+                    offsets[j] += other.offsets[j];
+                }
+            }
+
+            double evaluate(const Vector3& p, const double* attributes) const
+            {
+                double error = quadric.evaluate(p);
+                for (uint32 j = 0; j < ATTRIBUTE_COUNT; ++j)
+                    error += attributes[j] * (quadric.weight * attributes[j] - 2 * (dot(gradients[j], p) + offsets[j]));
+                return error;
+            }
+        };
+
+        template <size_t Size>
+        struct KeyHash
+        {
+            size_t operator()(const std::array<uint32, Size>& key) const
+            {
+                size_t hash = 0;
+                for (uint32 word : key)
+                    hash = (hash ^ word) * 0x100000001B3ull;
+                return hash;
+            }
+        };
+
+        // Simplifies one submesh. Vertices sharing a position are welded into one position that edges
+        // collapse between, while triangle corners keep referencing vertices, here called wedges, so
+        // attributes stay those of existing vertices.
+        class Simplifier
+        {
+        public:
+            Simplifier(std::span<const Vertex> vertices, std::span<const uint32> indices, const Vector3& origin, double scale,
+                const SimplificationSettings& settings)
+            {
+                auto [low, high] = std::minmax_element(indices.begin(), indices.end());
+                mBase = *low;
+                uint32 wedgeCount = *high - mBase + 1;
+
+                // Identical vertices are welded too, or they would look like a seam to collapses.
+                std::unordered_map<std::array<uint32, 8>, uint32, KeyHash<8>> wedgeIds;
+                std::unordered_map<std::array<uint32, 3>, uint32, KeyHash<3>> positionIds;
+                std::vector<uint32> canonicalWedges(wedgeCount);
+                mWedgePositions.resize(wedgeCount);
+                mWedgeAttributes.resize(wedgeCount);
+                for (uint32 wedge = 0; wedge < wedgeCount; ++wedge)
+                {
+                    const auto& vertex = vertices[mBase + wedge];
+                    std::array<uint32, 8> vertexKey;
+                    std::memcpy(vertexKey.data(), &vertex, sizeof(vertexKey));
+                    canonicalWedges[wedge] = wedgeIds.try_emplace(vertexKey, wedge).first->second;
+
+                    std::array<uint32, 3> key;
+                    std::memcpy(key.data(), vertex.position, sizeof(key));
+                    auto [it, inserted] = positionIds.try_emplace(key, static_cast<uint32>(mPositions.size()));
+                    if (inserted)
+                    {
+                        Vector3 position{ vertex.position[0], vertex.position[1], vertex.position[2] };
+                        mPositions.push_back((position - origin) * (1.0 / scale));
+                    }
+                    mWedgePositions[wedge] = it->second;
+                    mWedgeAttributes[wedge] = { vertex.normal[0] * settings.normalWeight, vertex.normal[1] * settings.normalWeight,
+                        vertex.normal[2] * settings.normalWeight, vertex.texCoord[0] * settings.texCoordWeight, vertex.texCoord[1] * settings.texCoordWeight };
+                }
+
+                uint32 positionCount = static_cast<uint32>(mPositions.size());
+                mAdjacency.resize(positionCount);
+                mGeometric.resize(positionCount);
+                mAttributes.resize(wedgeCount);
+                mLocked.assign(positionCount, false);
+                mStamps.assign(positionCount, 0);
+                mTouched.assign(positionCount, 0);
+
+                std::vector<uint64> edges;
+                for (size_t i = 0; i + 2 < indices.size(); i += 3)
+                {
+                    uint32 corners[3] = { canonicalWedges[indices[i] - mBase], canonicalWedges[indices[i + 1] - mBase], canonicalWedges[indices[i + 2] - mBase] };
+                    uint32 p[3] = { mWedgePositions[corners[0]], mWedgePositions[corners[1]], mWedgePositions[corners[2]] };
+                    // Triangles with two corners at one position have no area and would break the adjacency.
+                    if (p[0] == p[1] || p[1] == p[2] || p[2] == p[0])
+                        continue;
+                    auto triangle = static_cast<uint32>(mTriangles.size() / 3);
+                    mTriangles.insert(mTriangles.end(), corners, corners + 3);
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        mAdjacency[p[corner]].push_back(triangle);
+                        uint32 a = p[corner], b = p[(corner + 1) % 3];
+                        edges.push_back(uint64(std::min(a, b)) << 32 | std::max(a, b));
+                    }
+                    _addQuadrics(corners);
+                }
+                mTriangleCount = static_cast<uint32>(mTriangles.size() / 3);
+                mAlive.assign(mTriangleCount, true);
+
+                // Open edges, and edges shared by more than two triangles, which collapses cannot keep intact.
+                std::sort(edges.begin(), edges.end());
+                for (size_t i = 0; i < edges.size();)
+                {
+                    size_t end = i;
+                    while (end < edges.size() && edges[end] == edges[i])
+                        ++end;
+                    if ((end - i == 1 && settings.lockBorder) || end - i > 2)
+                        mLocked[edges[i] >> 32] = mLocked[edges[i] & 0xFFFFFFFF] = true;
+                    i = end;
+                }
+            }
+
+            void simplify(uint32 targetTriangleCount, double targetError)
+            {
+                double maxCost = targetError * targetError;
+                while (mTriangleCount > targetTriangleCount)
+                {
+                    // Each pass collapses the cheapest edge of each position, cheapest first, touching every
+                    // position at most once so costs computed at the start of the pass stay meaningful.
+                    mCandidates.clear();
+                    for (uint32 u = 0; u < mPositions.size(); ++u)
+                    {
+                        if (mLocked[u] || mAdjacency[u].empty())
+                            continue;
+                        Candidate best{ u, 0, maxCost };
+                        bool found = false;
+                        for (uint32 triangle : mAdjacency[u])
+                        {
+                            for (uint32 corner = 0; corner < 3; ++corner)
+                            {
+                                uint32 v = mWedgePositions[mTriangles[triangle * 3 + corner]];
+                                double cost, geometricError;
+                                if (v != u && _evaluate(u, v, cost, geometricError) && cost <= best.cost && _isValid(u, v))
+                                {
+                                    best = { u, v, cost };
+                                    found = true;
+                                }
+                            }
+                        }
+                        if (found)
+                            mCandidates.push_back(best);
+                    }
+                    std::sort(mCandidates.begin(), mCandidates.end(), [](const Candidate& a, const Candidate& b) { return a.cost < b.cost; });
+
+                    ++mPass;
+                    uint32 collapsedCount = 0;
+                    for (const auto& candidate : mCandidates)
+                    {
+                        if (mTriangleCount <= targetTriangleCount)
+                            break;
+                        uint32 u = candidate.u, v = candidate.v;
+                        if (mTouched[u] == mPass || mTouched[v] == mPass)
+                            continue;
+                        double cost, geometricError;
+                        if (!_evaluate(u, v, cost, geometricError) || cost > maxCost || !_isValid(u, v))
+                            continue;
+                        _collapse(u, v);
+                        mTouched[u] = mTouched[v] = mPass;
+                        mError = std::max(mError, geometricError);
+                        ++collapsedCount;
+                    }
+                    if (collapsedCount == 0)
+                        break;
+                }
+            }
+
+            void appendIndices(std::vector<uint32>& indices) const
+            {
+                for (uint32 triangle = 0; triangle < mAlive.size(); ++triangle)
+                {
+                    if (!mAlive[triangle])
+                        continue;
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                        indices.push_back(mBase + mTriangles[triangle * 3 + corner]);
+                }
+            }
+
+            uint32 getTriangleCount() const { return mTriangleCount; }
+            // Geometric error reached, relative to the scale passed in.
+            double getError() const { return std::sqrt(mError); }
+        private:
+            struct Candidate
+            {
+                uint32 u;
+                uint32 v;
+                double cost;
+            };
+
+            Vector3 _getPosition(uint32 wedge) const { return mPositions[mWedgePositions[wedge]]; }
+
+            void _addQuadrics(const uint32* corners)
+            {
+                Vector3 p0 = _getPosition(corners[0]), p1 = _getPosition(corners[1]), p2 = _getPosition(corners[2]);
+                Vector3 e1 = p1 - p0, e2 = p2 - p0;
+                Vector3 normal = cross(e1, e2);
+                double length = std::sqrt(dot(normal, normal));
+                if (length < MIN_WEIGHT)
+                    return;
+                normal = normal * (1.0 / length);
+                double area = length * 0.5;
+
+                Quadric plane;
+                plane.addSquare(normal, -dot(normal, p0), area);
+                plane.weight = area;
+                for (uint32 corner = 0; corner < 3; ++corner)
+                    mGeometric[mWedgePositions[corners[corner]]].add(plane);
+
+                // The gradient of an attribute lies in the triangle's plane and matches its change along both
+                // edges, which inverts the matrix with rows e1, e2 and the normal.
+                double determinant = dot(e1, cross(e2, normal));
+                Vector3 c1 = cross(e2, normal) * (1.0 / determinant);
+                Vector3 c2 = cross(normal, e1) * (1.0 / determinant);
+                AttributeQuadric attributes;
+                attributes.quadric.weight = area;
+                const auto& s0 = mWedgeAttributes[corners[0]];
+                const auto& s1 = mWedgeAttributes[corners[1]];
+                const auto& s2 = mWedgeAttributes[corners[2]];
+                for (uint32 j = 0; j < ATTRIBUTE_COUNT; ++j)
+                {
+                    Vector3 gradient = c1 * (s1[j] - s0[j]) + c2 * (s2[j] - s0[j]);
+                    double offset = s0[j] - dot(gradient, p0);
+                    attributes.quadric.addSquare(gradient, offset, area);
+                    attributes.gradients[j] = gradient * area;
+                    attributes.offsets[j] = offset * area;
+                }
+                for (uint32 corner = 0; corner < 3; ++corner)
+                    mAttributes[corners[corner]].add(attributes);
+            }
+
+            // Maps each wedge of u to the wedge of v it becomes, and fails if a wedge of u does not share a
+            // triangle with v: its attributes would be stretched across a seam.
+            bool _mapWedges(uint32 u, uint32 v)
+            {
+                mWedgeMap.clear();
+                for (uint32 triangle : mAdjacency[u])
+                {
+                    const uint32* corners = &mTriangles[triangle * 3];
+                    uint32 wedgeU = 0, wedgeV = ~0u;
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        uint32 position = mWedgePositions[corners[corner]];
+                        if (position == u)
+                            wedgeU = corners[corner];
+                        else if (position == v)
+                            wedgeV = corners[corner];
+                    }
+                    if (wedgeV == ~0u)
+                        continue;
+                    auto it = std::find_if(mWedgeMap.begin(), mWedgeMap.end(), [&](const auto& pair) { return pair.first == wedgeU; });
+                    if (it == mWedgeMap.end())
+                        mWedgeMap.push_back({ wedgeU, wedgeV });
+                    else if (it->second != wedgeV)
+                        return false;
+                }
+                for (uint32 triangle : mAdjacency[u])
+                {
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        uint32 wedge = mTriangles[triangle * 3 + corner];
+                        if (mWedgePositions[wedge] == u &&
+                            std::none_of(mWedgeMap.begin(), mWedgeMap.end(), [&](const auto& pair) { return pair.first == wedge; }))
+                            return false;
+                    }
+                }
+                return true;
+            }
+
+            // The cost of moving u onto v: the mean squared distance to the planes merged into both, plus
+            // the mean squared change of attributes of each wedge of u.
+            bool _evaluate(uint32 u, uint32 v, double& cost, double& geometricError)
+            {
+                if (!_mapWedges(u, v))
+                    return false;
+                const Vector3& target = mPositions[v];
+                Quadric geometric = mGeometric[u];
+                geometric.add(mGeometric[v]);
+                geometricError = std::max(geometric.evaluate(target), 0.0) / std::max(geometric.weight, MIN_WEIGHT);
+
+                double attributeError = 0, attributeWeight = 0;
+                for (const auto& [wedgeU, wedgeV] : mWedgeMap)
+                {
+                    AttributeQuadric attributes = mAttributes[wedgeU];
+                    attributes.add(mAttributes[wedgeV]);
+                    attributeError += attributes.evaluate(target, mWedgeAttributes[wedgeV].data());
+                    attributeWeight += attributes.quadric.weight;
+                }
+                cost = geometricError + std::max(attributeError, 0.0) / std::max(attributeWeight, MIN_WEIGHT);
+                return true;
+            }
+
+            // Rejects collapses that would fold triangles over or join the surface to itself, which happens
+            // when u and v have neighbours in common other than across the triangles of their edge.
+            bool _isValid(uint32 u, uint32 v)
+            {
+                mStamp += 2;
+                uint32 sharedTriangles = 0;
+                for (uint32 triangle : mAdjacency[u])
+                {
+                    bool hasV = false;
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        uint32 position = mWedgePositions[mTriangles[triangle * 3 + corner]];
+                        hasV |= position == v;
+                        mStamps[position] = mStamp;
+                    }
+                    sharedTriangles += hasV;
+                }
+                uint32 commonNeighbors = 0;
+                for (uint32 triangle : mAdjacency[v])
+                {
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        uint32 position = mWedgePositions[mTriangles[triangle * 3 + corner]];
+                        if (position != u && position != v && mStamps[position] == mStamp)
+                        {
+                            mStamps[position] = mStamp + 1;
+                            ++commonNeighbors;
+                        }
+                    }
+                }
+                if (commonNeighbors != sharedTriangles)
+                    return false;
+
+                for (uint32 triangle : mAdjacency[u])
+                {
+                    Vector3 before[3], after[3];
+                    bool hasV = false;
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        uint32 position = mWedgePositions[mTriangles[triangle * 3 + corner]];
+                        hasV |= position == v;
+                        before[corner] = mPositions[position];
+                        after[corner] = position == u ? mPositions[v] : before[corner];
+                    }
+                    if (hasV)
+                        continue;
+                    Vector3 normalBefore = cross(before[1] - before[0], before[2] - before[0]);
+                    Vector3 normalAfter = cross(after[1] - after[0], after[2] - after[0]);
+                    double lengths = std::sqrt(dot(normalBefore, normalBefore) * dot(normalAfter, normalAfter));
+                    if (dot(normalAfter, normalAfter) < MIN_WEIGHT || dot(normalBefore, normalAfter) < MIN_NORMAL_DOT * lengths)
+                        return false;
+                }
+                return true;
+            }
+
+            void _removeAdjacency(uint32 position, uint32 triangle)
+            {
+                auto& adjacency = mAdjacency[position];
+                auto it = std::find(adjacency.begin(), adjacency.end(), triangle);
+                *it = adjacency.back();
+                adjacency.pop_back();
+            }
+
+            void _collapse(uint32 u, uint32 v)
+            {
+                auto triangles = std::move(mAdjacency[u]);
+                mAdjacency[u].clear();
+                for (uint32 triangle : triangles)
+                {
+                    uint32* corners = &mTriangles[triangle * 3];
+                    bool hasV = false;
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                        hasV |= mWedgePositions[corners[corner]] == v;
+                    if (hasV)
+                    {
+                        mAlive[triangle] = false;
+                        --mTriangleCount;
+                        for (uint32 corner = 0; corner < 3; ++corner)
+                        {
+                            uint32 position = mWedgePositions[corners[corner]];
+                            if (position != u)
+                                _removeAdjacency(position, triangle);
+                        }
+                        continue;
+                    }
+                    for (uint32 corner = 0; corner < 3; ++corner)
+                    {
+                        if (mWedgePositions[corners[corner]] != u)
+                            continue;
+                        auto it = std::find_if(mWedgeMap.begin(), mWedgeMap.end(), [&](const auto& pair) { return pair.first == corners[corner]; });
+                        corners[corner] = it->second;
+                    }
+                    mAdjacency[v].push_back(triangle);
+                }
+
+                mGeometric[v].add(mGeometric[u]);
+                for (const auto& [wedgeU, wedgeV] : mWedgeMap)
+                    mAttributes[wedgeV].add(mAttributes[wedgeU]);
+            }
+
+            uint32 mBase = 0;
+            std::vector<uint32> mWedgePositions;
+            std::vector<std::array<double, ATTRIBUTE_COUNT>> mWedgeAttributes;
+            std::vector<Vector3> mPositions;
+            std::vector<Quadric> mGeometric;
+            std::vector<AttributeQuadric> mAttributes;
+            std::vector<bool> mLocked;
+
+            // Corners are wedges; each position lists the live triangles around it.
+            std::vector<uint32> mTriangles;
+            std::vector<bool> mAlive;
+            std::vector<std::vector<uint32>> mAdjacency;
+            uint32 mTriangleCount = 0;
+            double mError = 0;
+
+            std::vector<Candidate> mCandidates;
+            std::vector<std::pair<uint32, uint32>> mWedgeMap;
+            std::vector<uint32> mStamps;
+            uint32 mStamp = 0;
+            std::vector<uint32> mTouched;
+            uint32 mPass = 0;
+        };
+
+        // The scale errors are relative to: the largest extent of the bounds.
+        double getScale(const BoundingBox& bounds)
+        {
+            double scale = std::max({ bounds.max[0] - bounds.min[0], bounds.max[1] - bounds.min[1], bounds.max[2] - bounds.min[2] });
+            return scale > 0 ? scale : 1.0;
+        }
+    }
+
+    std::vector<uint32> simplifyMesh(std::span<const Vertex> vertices, std::span<const uint32> indices, uint32 targetIndexCount, float targetError,
+        float& error, const SimplificationSettings& settings)
+    {
+        std::vector<uint32> result;
+        error = 0;
+        indices = indices.first(indices.size() / 3 * 3);
+        if (indices.empty())
+            return result;
+
+        BoundingBox bounds;
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            bounds.min[axis] = bounds.max[axis] = vertices[indices[0]].position[axis];
+            for (uint32 index : indices)
+            {
+                bounds.min[axis] = std::min(bounds.min[axis], vertices[index].position[axis]);
+                bounds.max[axis] = std::max(bounds.max[axis], vertices[index].position[axis]);
+            }
+        }
+        double scale = getScale(bounds);
+        Simplifier simplifier(vertices, indices, { bounds.min[0], bounds.min[1], bounds.min[2] }, scale, settings);
+        simplifier.simplify(targetIndexCount / 3, targetError);
+        simplifier.appendIndices(result);
+        error = static_cast<float>(simplifier.getError() * scale);
+        return result;
+    }
+
+    void generateLods(MeshData& mesh, const LodSettings& settings)
+    {
+        if (mesh.indices.size() < 3 || settings.levelErrors.empty())
+            return;
+        if (mesh.submeshes.empty())
+            mesh.submeshes.push_back({ 0, static_cast<uint32>(mesh.indices.size() / 3 * 3), -1 });
+
+        struct Level
+        {
+            std::vector<uint32> indices;
+            double error = 0;
+        };
+        // levels[submesh][level], each simplified further from the one before.
+        double scale = getScale(mesh.bounds);
+        Vector3 origin{ mesh.bounds.min[0], mesh.bounds.min[1], mesh.bounds.min[2] };
+        std::vector<std::vector<Level>> levels(mesh.submeshes.size());
+        for (size_t i = 0; i < mesh.submeshes.size(); ++i)
+        {
+            const auto& submesh = mesh.submeshes[i];
+            auto indices = std::span<const uint32>(mesh.indices).subspan(submesh.indexOffset, submesh.indexCount / 3 * 3);
+            levels[i].resize(settings.levelErrors.size());
+            if (indices.empty())
+                continue;
+            Simplifier simplifier(mesh.vertices, indices, origin, scale, settings.simplification);
+            for (size_t level = 0; level < settings.levelErrors.size(); ++level)
+            {
+                simplifier.simplify(0, settings.levelErrors[level]);
+                simplifier.appendIndices(levels[i][level].indices);
+                levels[i][level].error = simplifier.getError() * scale;
+            }
+        }
+
+        uint64 previousCount = 0;
+        for (const auto& submesh : mesh.submeshes)
+            previousCount += submesh.indexCount / 3 * 3;
+        for (size_t level = 0; level < settings.levelErrors.size(); ++level)
+        {
+            uint64 count = 0;
+            for (const auto& submesh : levels)
+                count += submesh[level].indices.size();
+            // A level barely simpler than the last costs memory without saving time.
+            if (count == 0 || count > settings.maxTriangleRatio * previousCount)
+                continue;
+
+            MeshLod lod;
+            for (size_t i = 0; i < mesh.submeshes.size(); ++i)
+            {
+                const auto& indices = levels[i][level].indices;
+                lod.submeshes.push_back({ static_cast<uint32>(mesh.indices.size()), static_cast<uint32>(indices.size()), mesh.submeshes[i].materialIndex });
+                lod.error = std::max(lod.error, static_cast<float>(levels[i][level].error));
+                mesh.indices.insert(mesh.indices.end(), indices.begin(), indices.end());
+            }
+            mesh.lods.push_back(std::move(lod));
+            previousCount = count;
+        }
+    }
+}
\ No newline at end of file
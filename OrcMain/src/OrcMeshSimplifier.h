@@ -0,0 +1,45 @@
+#pragma once
+
+#include "OrcMesh.h"
+#include "OrcTypes.h"
+
+#include <span>
+#include <vector>
+
+namespace Orc
+{
+    struct SimplificationSettings
+    {
+        // Vertices on open edges, including those between submeshes, stay where they are so levels keep
+        // their outline and do not crack against other submeshes.
+        bool lockBorder = true;
+        // How much a change of normal or texture coordinate weighs against moving the surface. Distances are
+        // relative to the mesh's size, normals are unit length and texture coordinates usually span 0 to 1.
+        float normalWeight = 0.5f;
+        float texCoordWeight = 0.5f;
+    };
+
+    struct LodSettings
+    {
+        // Error each level may reach, relative to the largest extent of the mesh's bounds, finest first.
+        std::vector<float> levelErrors = { 0.002f, 0.008f, 0.03f, 0.1f };
+        // Levels keeping more than this fraction of the previous level's triangles are skipped.
+        float maxTriangleRatio = 0.8f;
+        SimplificationSettings simplification;
+    };
+
+    // Simplifies a triangle list by collapsing edges onto existing vertices, cheapest first by quadric
+    // error metrics: a vertex's distance to the planes of the triangles merged into it, plus the change of
+    // its normal and texture coordinate over them (Garland and Heckbert 1997, Hoppe 1999). A vertex
+    // whose copies carry different attributes only collapses along the edges those copies share, so
+    // texture seams and hard edges hold. Stops at targetIndexCount indices or when any collapse left would
+    // exceed targetError, relative to the mesh's size; returns the indices and, in error, the geometric
+    // error reached in the mesh's units.
+    std::vector<uint32> simplifyMesh(std::span<const Vertex> vertices, std::span<const uint32> indices, uint32 targetIndexCount, float targetError,
+        float& error, const SimplificationSettings& settings = SimplificationSettings());
+
+    // Appends a chain of simplified levels to mesh.lods, their indices after the mesh's own. Each level
+    // simplifies every submesh of the previous one further until its error is reached, so errors are
+    // measured against the full-detail mesh. Run before optimizeMesh, which then also orders the levels.
+    void generateLods(MeshData& mesh, const LodSettings& settings = LodSettings());
+}
\ No newline at end of file
@@ -0,0 +1,466 @@
+#include "OrcMeshlet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Orc
+{
+    namespace
+    {
+        constexpr uint32 INVALID_INDEX = ~0u;
+        // Cones wider than about 84 degrees are left untestable; their apex would lie far behind the
+        // meshlet and the test would hardly ever pass.
+        constexpr float MIN_CONE_DOT = 0.1f;
+
+        struct Vector3
+        {
+            float x, y, z;
+
+            Vector3 operator+(const Vector3& other) const { return { x + other.x, y + other.y, z + other.z }; }
+            Vector3 operator-(const Vector3& other) const { return { x - other.x, y - other.y, z - other.z }; }
+            Vector3 operator*(float scale) const { return { x * scale, y * scale, z * scale }; }
+        };
+
+        float dot(const Vector3& a, const Vector3& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        Vector3 cross(const Vector3& a, const Vector3& b)
+        {
+            return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+        }
+
+        // Returns the zero vector for vectors too short to have a direction.
+        Vector3 normalize(const Vector3& v)
+        {
+            float length = std::sqrt(dot(v, v));
+            return length > 1e-12f ? v * (1.0f / length) : Vector3{ 0, 0, 0 };
+        }
+
+        Vector3 getPosition(const Vertex& vertex)
+        {
+            return { vertex.position[0], vertex.position[1], vertex.position[2] };
+        }
+
+        // Ritter's sphere: the widest pair of points extreme along an axis, grown to take in the others.
+        void computeSphere(std::span<const Vertex> vertices, const uint32* meshletVertices, uint32 count, MeshletBounds& bounds)
+        {
+            uint32 extremes[6]{};
+            for (uint32 i = 1; i < count; ++i)
+            {
+                auto p = vertices[meshletVertices[i]].position;
+                for (uint32 axis = 0; axis < 3; ++axis)
+                {
+                    if (p[axis] < vertices[meshletVertices[extremes[axis * 2]]].position[axis])
+                        extremes[axis * 2] = i;
+                    if (p[axis] > vertices[meshletVertices[extremes[axis * 2 + 1]]].position[axis])
+                        extremes[axis * 2 + 1] = i;
+                }
+            }
+            Vector3 a{}, b{};
+            float widest = -1.0f;
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                Vector3 low = getPosition(vertices[meshletVertices[extremes[axis * 2]]]);
+                Vector3 high = getPosition(vertices[meshletVertices[extremes[axis * 2 + 1]]]);
+                float distance = dot(high - low, high - low);
+                if (distance > widest)
+                {
+                    widest = distance;
+                    a = low;
+                    b = high;
+                }
+            }
+
+            Vector3 center = (a + b) * 0.5f;
+            float radius = std::sqrt(widest) * 0.5f;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                Vector3 offset = getPosition(vertices[meshletVertices[i]]) - center;
+                float distance = std::sqrt(dot(offset, offset));
+                if (distance > radius)
+                {
+                    float grown = (radius + distance) * 0.5f;
+                    center = center + offset * ((grown - radius) / distance);
+                    radius = grown;
+                }
+            }
+            bounds.center[0] = center.x;
+            bounds.center[1] = center.y;
+            bounds.center[2] = center.z;
+            bounds.radius = radius;
+        }
+
+        // The cone's axis is the average triangle normal and its apex the point on the axis behind the
+        // plane of every triangle, so every triangle faces away from cameras inside the cone behind it.
+        void computeCone(std::span<const Vertex> vertices, const uint32* meshletVertices, const uint8* triangles, uint32 triangleCount,
+            MeshletBounds& bounds)
+        {
+            Vector3 center{ bounds.center[0], bounds.center[1], bounds.center[2] };
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                bounds.coneApex[axis] = bounds.center[axis];
+                bounds.coneAxis[axis] = 0.0f;
+            }
+            bounds.coneCutoff = 1.0f;
+
+            std::vector<Vector3> normals(triangleCount);
+            Vector3 sum{ 0, 0, 0 };
+            for (uint32 i = 0; i < triangleCount; ++i)
+            {
+                Vector3 p0 = getPosition(vertices[meshletVertices[triangles[i * 3]]]);
+                Vector3 p1 = getPosition(vertices[meshletVertices[triangles[i * 3 + 1]]]);
+                Vector3 p2 = getPosition(vertices[meshletVertices[triangles[i * 3 + 2]]]);
+                normals[i] = normalize(cross(p1 - p0, p2 - p0));
+                sum = sum + normals[i];
+            }
+            Vector3 axis = normalize(sum);
+            if (dot(axis, axis) == 0.0f)
+                return;
+
+            float minDot = 1.0f;
+            for (const auto& normal : normals)
+            {
+                // Degenerate triangles cover no pixels and never face the camera.
+                if (dot(normal, normal) != 0.0f)
+                    minDot = std::min(minDot, dot(axis, normal));
+            }
+            if (minDot <= MIN_CONE_DOT)
+                return;
+
+            float maxT = -std::numeric_limits<float>::max();
+            for (uint32 i = 0; i < triangleCount; ++i)
+            {
+                if (dot(normals[i], normals[i]) == 0.0f)
+                    continue;
+                Vector3 p0 = getPosition(vertices[meshletVertices[triangles[i * 3]]]);
+                maxT = std::max(maxT, dot(center - p0, normals[i]) / dot(axis, normals[i]));
+            }
+            Vector3 apex = center - axis * maxT;
+            bounds.coneApex[0] = apex.x;
+            bounds.coneApex[1] = apex.y;
+            bounds.coneApex[2] = apex.z;
+            bounds.coneAxis[0] = axis.x;
+            bounds.coneAxis[1] = axis.y;
+            bounds.coneAxis[2] = axis.z;
+            bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+
+        class MeshletBuilder
+        {
+        public:
+            MeshletBuilder(std::span<const Vertex> vertices, const MeshletSettings& settings, MeshletData& data)
+                : mVertices(vertices), mSettings(settings), mData(data)
+            {
+            }
+
+            void build(std::span<const uint32> indices)
+            {
+                if (indices.empty())
+                    return;
+                auto [low, high] = std::minmax_element(indices.begin(), indices.end());
+                mBase = *low;
+                _prepare(indices, *high - mBase + 1);
+
+                uint32 triangleCount = static_cast<uint32>(mCentroids.size());
+                uint32 seedCursor = 0;
+                for (uint32 emitted = 0; emitted < triangleCount; ++emitted)
+                {
+                    uint32 newVertices = 0;
+                    uint32 triangle = _findNeighbor(newVertices);
+                    if (triangle == INVALID_INDEX)
+                    {
+                        while (mEmitted[seedCursor])
+                            ++seedCursor;
+                        triangle = seedCursor;
+                        newVertices = 0;
+                        for (uint32 corner = 0; corner < 3; ++corner)
+                            newVertices += mLocalIndices[mIndices[triangle * 3 + corner]] == INVALID_INDEX;
+                    }
+                    if (mMeshletVertices.size() + newVertices > mSettings.maxVertices || mMeshletTriangles.size() / 3 >= mSettings.maxTriangles)
+                        _flush();
+                    _emit(triangle);
+                }
+                _flush();
+            }
+        private:
+            void _prepare(std::span<const uint32> indices, uint32 vertexCount)
+            {
+                uint32 triangleCount = static_cast<uint32>(indices.size() / 3);
+                mIndices.resize(indices.size());
+                for (size_t i = 0; i < indices.size(); ++i)
+                    mIndices[i] = indices[i] - mBase;
+
+                mAdjacencyOffsets.assign(vertexCount + 1, 0);
+                for (uint32 index : mIndices)
+                    ++mAdjacencyOffsets[index + 1];
+                for (uint32 vertex = 0; vertex < vertexCount; ++vertex)
+                    mAdjacencyOffsets[vertex + 1] += mAdjacencyOffsets[vertex];
+                mLiveCounts.assign(vertexCount, 0);
+                mAdjacency.resize(mIndices.size());
+                for (uint32 i = 0; i < mIndices.size(); ++i)
+                {
+                    uint32 vertex = mIndices[i];
+                    mAdjacency[mAdjacencyOffsets[vertex] + mLiveCounts[vertex]++] = i / 3;
+                }
+
+                mCentroids.resize(triangleCount);
+                mNormals.resize(triangleCount);
+                for (uint32 triangle = 0; triangle < triangleCount; ++triangle)
+                {
+                    Vector3 p0 = _getPosition(mIndices[triangle * 3]);
+                    Vector3 p1 = _getPosition(mIndices[triangle * 3 + 1]);
+                    Vector3 p2 = _getPosition(mIndices[triangle * 3 + 2]);
+                    mCentroids[triangle] = (p0 + p1 + p2) * (1.0f / 3.0f);
+                    mNormals[triangle] = normalize(cross(p1 - p0, p2 - p0));
+                }
+                mEmitted.assign(triangleCount, false);
+                mLocalIndices.assign(vertexCount, INVALID_INDEX);
+            }
+
+            Vector3 _getPosition(uint32 vertex) const
+            {
+                return getPosition(mVertices[mBase + vertex]);
+            }
+
+            // The live triangle next to the meshlet adding the fewest vertices, then closest to its centre
+            // and to its average normal. Returns INVALID_INDEX when the meshlet has no live neighbours.
+            uint32 _findNeighbor(uint32& bestNewVertices) const
+            {
+                if (mMeshletTriangles.empty())
+                    return INVALID_INDEX;
+                float triangleCount = static_cast<float>(mMeshletTriangles.size() / 3);
+                Vector3 centroid = mCentroidSum * (1.0f / triangleCount);
+                Vector3 axis = normalize(mNormalSum);
+
+                uint32 best = INVALID_INDEX;
+                float bestScore = std::numeric_limits<float>::max();
+                bestNewVertices = 4;
+                for (uint32 vertex : mMeshletVertices)
+                {
+                    for (uint32 i = 0; i < mLiveCounts[vertex]; ++i)
+                    {
+                        uint32 triangle = mAdjacency[mAdjacencyOffsets[vertex] + i];
+                        uint32 newVertices = 0;
+                        for (uint32 corner = 0; corner < 3; ++corner)
+                            newVertices += mLocalIndices[mIndices[triangle * 3 + corner]] == INVALID_INDEX;
+                        if (newVertices > bestNewVertices)
+                            continue;
+                        Vector3 offset = mCentroids[triangle] - centroid;
+                        float spread = 1.0f - dot(mNormals[triangle], axis);
+                        float score = std::sqrt(dot(offset, offset)) * (1.0f + mSettings.coneWeight * spread);
+                        if (newVertices < bestNewVertices || score < bestScore)
+                        {
+                            best = triangle;
+                            bestNewVertices = newVertices;
+                            bestScore = score;
+                        }
+                    }
+                }
+                return best;
+            }
+
+            void _emit(uint32 triangle)
+            {
+                for (uint32 corner = 0; corner < 3; ++corner)
+                {
+                    uint32 vertex = mIndices[triangle * 3 + corner];
+                    if (mLocalIndices[vertex] == INVALID_INDEX)
+                    {
+                        mLocalIndices[vertex] = static_cast<uint32>(mMeshletVertices.size());
+                        mMeshletVertices.push_back(vertex);
+                    }
+                    mMeshletTriangles.push_back(static_cast<uint8>(mLocalIndices[vertex]));
+
+                    // Only live triangles stay in the adjacency, so vertices with none left cost nothing.
+                    uint32* adjacency = mAdjacency.data() + mAdjacencyOffsets[vertex];
+                    uint32& liveCount = mLiveCounts[vertex];
+                    for (uint32 i = 0; i < liveCount; ++i)
+                    {
+                        if (adjacency[i] == triangle)
+                        {
+                            adjacency[i] = adjacency[--liveCount];
+                            break;
+                        }
+                    }
+                }
+                mEmitted[triangle] = true;
+                mCentroidSum = mCentroidSum + mCentroids[triangle];
+                mNormalSum = mNormalSum + mNormals[triangle];
+            }
+
+            void _flush()
+            {
+                if (mMeshletTriangles.empty())
+                    return;
+                Meshlet meshlet;
+                meshlet.vertexOffset = static_cast<uint32>(mData.vertices.size());
+                meshlet.triangleOffset = static_cast<uint32>(mData.triangles.size());
+                meshlet.vertexCount = static_cast<uint32>(mMeshletVertices.size());
+                meshlet.triangleCount = static_cast<uint32>(mMeshletTriangles.size() / 3);
+                for (uint32 vertex : mMeshletVertices)
+                {
+                    mData.vertices.push_back(mBase + vertex);
+                    mLocalIndices[vertex] = INVALID_INDEX;
+                }
+                mData.triangles.insert(mData.triangles.end(), mMeshletTriangles.begin(), mMeshletTriangles.end());
+                mData.triangles.resize((mData.triangles.size() + 3) & ~size_t(3), 0);
+
+                MeshletBounds bounds;
+                const uint32* meshletVertices = mData.vertices.data() + meshlet.vertexOffset;
+                computeSphere(mVertices, meshletVertices, meshlet.vertexCount, bounds);
+                computeCone(mVertices, meshletVertices, mData.triangles.data() + meshlet.triangleOffset, meshlet.triangleCount, bounds);
+                mData.meshlets.push_back(meshlet);
+                mData.bounds.push_back(bounds);
+
+                mMeshletVertices.clear();
+                mMeshletTriangles.clear();
+                mCentroidSum = mNormalSum = { 0, 0, 0 };
+            }
+
+            std::span<const Vertex> mVertices;
+            const MeshletSettings& mSettings;
+            MeshletData& mData;
+
+            // The submesh's indices rebased to its lowest vertex, and the live triangles of each vertex.
+            uint32 mBase = 0;
+            std::vector<uint32> mIndices;
+            std::vector<uint32> mAdjacencyOffsets;
+            std::vector<uint32> mAdjacency;
+            std::vector<uint32> mLiveCounts;
+            std::vector<Vector3> mCentroids;
+            std::vector<Vector3> mNormals;
+            std::vector<bool> mEmitted;
+
+            // The meshlet being built.
+            std::vector<uint32> mLocalIndices;
+            std::vector<uint32> mMeshletVertices;
+            std::vector<uint8> mMeshletTriangles;
+            Vector3 mCentroidSum{ 0, 0, 0 };
+            Vector3 mNormalSum{ 0, 0, 0 };
+        };
+    }
+
+    MeshletData buildMeshlets(std::span<const Vertex> vertices, std::span<const uint32> indices, std::span<const Submesh> submeshes,
+        const MeshletSettings& settings)
+    {
+        MeshletSettings clamped = settings;
+        clamped.maxVertices = std::clamp(settings.maxVertices, 3u, 256u);
+        clamped.maxTriangles = std::max(settings.maxTriangles, 1u);
+
+        MeshletData data;
+        MeshletBuilder builder(vertices, clamped, data);
+        if (submeshes.empty())
+        {
+            data.submeshOffsets.push_back(0);
+            builder.build(indices.first(indices.size() / 3 * 3));
+        }
+        for (const auto& submesh : submeshes)
+        {
+            data.submeshOffsets.push_back(static_cast<uint32>(data.meshlets.size()));
+            builder.build(indices.subspan(submesh.indexOffset, submesh.indexCount / 3 * 3));
+        }
+        data.submeshOffsets.push_back(static_cast<uint32>(data.meshlets.size()));
+        return data;
+    }
+
+    MeshletStats analyzeMeshlets(const MeshletData& meshlets, uint32 vertexCount, const MeshletSettings& settings)
+    {
+        MeshletStats stats;
+        stats.meshletCount = static_cast<uint32>(meshlets.meshlets.size());
+        if (!stats.meshletCount)
+            return stats;
+
+        uint64 vertexTotal = 0, triangleTotal = 0;
+        for (const auto& meshlet : meshlets.meshlets)
+        {
+            vertexTotal += meshlet.vertexCount;
+            triangleTotal += meshlet.triangleCount;
+        }
+        for (const auto& bounds : meshlets.bounds)
+            stats.cullableConeCount += bounds.coneCutoff < 1.0f;
+        std::vector<bool> referenced(vertexCount);
+        uint64 referencedCount = 0;
+        for (uint32 vertex : meshlets.vertices)
+        {
+            if (!referenced[vertex])
+            {
+                referenced[vertex] = true;
+                ++referencedCount;
+            }
+        }
+
+        stats.vertexFill = float(double(vertexTotal) / (double(stats.meshletCount) * settings.maxVertices));
+        stats.triangleFill = float(double(triangleTotal) / (double(stats.meshletCount) * settings.maxTriangles));
+        stats.vertexDuplication = float(double(vertexTotal) / referencedCount);
+        return stats;
+    }
+
+    Frustum makeFrustum(const float (&viewProjection)[16])
+    {
+        // The clip space position is p * M, so each clip coordinate is the dot product of p with a column.
+        // The planes are w + x, w - x, w + y, w - y, z and w - z, from -w <= x <= w, -w <= y <= w and
+        // 0 <= z <= w.
+        Frustum frustum;
+        for (uint32 i = 0; i < 6; ++i)
+        {
+            uint32 axis = i / 2;
+            float sign = i % 2 ? -1.0f : 1.0f;
+            float w = i == 4 ? 0.0f : 1.0f;
+            for (uint32 row = 0; row < 4; ++row)
+                frustum.planes[i][row] = w * viewProjection[row * 4 + 3] + sign * viewProjection[row * 4 + axis];
+        }
+
+        for (auto& plane : frustum.planes)
+        {
+            float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f)
+            {
+                for (auto& component : plane)
+                    component /= length;
+            }
+        }
+        return frustum;
+    }
+
+    bool isSphereInFrustum(const Frustum& frustum, const float (&center)[3], float radius)
+    {
+        for (const auto& plane : frustum.planes)
+        {
+            if (plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3] < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    bool isMeshletBackfacing(const MeshletBounds& bounds, const float (&cameraPosition)[3])
+    {
+        if (bounds.coneCutoff >= 1.0f)
+            return false;
+        Vector3 direction = normalize(Vector3{ bounds.coneApex[0] - cameraPosition[0], bounds.coneApex[1] - cameraPosition[1],
+            bounds.coneApex[2] - cameraPosition[2] });
+        return dot(direction, Vector3{ bounds.coneAxis[0], bounds.coneAxis[1], bounds.coneAxis[2] }) >= bounds.coneCutoff;
+    }
+
+    MeshletCullStats cullMeshlets(const MeshletData& meshlets, const Frustum& frustum, const float (&cameraPosition)[3],
+        std::vector<uint32>& visible)
+    {
+        MeshletCullStats stats;
+        for (uint32 i = 0; i < meshlets.bounds.size(); ++i)
+        {
+            const auto& bounds = meshlets.bounds[i];
+            if (!isSphereInFrustum(frustum, bounds.center, bounds.radius))
+                ++stats.frustumCulledCount;
+            else if (isMeshletBackfacing(bounds, cameraPosition))
+                ++stats.coneCulledCount;
+            else
+            {
+                visible.push_back(i);
+                ++stats.visibleCount;
+            }
+        }
+        return stats;
+    }
+}
\ No newline at end of file
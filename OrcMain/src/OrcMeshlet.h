@@ -0,0 +1,67 @@
+#pragma once
+
+#include "OrcMesh.h"
+#include "OrcTypes.h"
+
+#include <span>
+#include <vector>
+
+// Limits of a meshlet, within what mesh shaders can output from one thread group. 124 triangles keep
+// a meshlet's local indices a multiple of 4 bytes.
+#define ORC_MESHLET_MAX_VERTICES 64
+#define ORC_MESHLET_MAX_TRIANGLES 124
+
+namespace Orc
+{
+    struct MeshletSettings
+    {
+        uint32 maxVertices = ORC_MESHLET_MAX_VERTICES;
+        uint32 maxTriangles = ORC_MESHLET_MAX_TRIANGLES;
+        // Trades compact meshlets for narrower normal cones, and so more of them culled by the cone test.
+        float coneWeight = 0.25f;
+    };
+
+    struct MeshletStats
+    {
+        uint32 meshletCount = 0;
+        // Average fraction of maxVertices and maxTriangles a meshlet uses.
+        float vertexFill = 0;
+        float triangleFill = 0;
+        // Meshlet vertices over the vertices of the mesh; vertices on meshlet borders are transformed once
+        // per meshlet.
+        float vertexDuplication = 0;
+        // Meshlets whose normal cone is narrow enough for the cone test.
+        uint32 cullableConeCount = 0;
+    };
+
+    // Six planes (a, b, c, d), normalized and facing inwards, so a point p is inside if
+    // a * p.x + b * p.y + c * p.z + d >= 0 for each.
+    struct Frustum
+    {
+        float planes[6][4];
+    };
+
+    struct MeshletCullStats
+    {
+        uint32 visibleCount = 0;
+        uint32 frustumCulledCount = 0;
+        uint32 coneCulledCount = 0;
+    };
+
+    // Builds meshlets greedily: each grows by the triangle adding the fewest vertices, preferring those
+    // close to its centre and facing like it, and is closed when no triangle fits. Run after
+    // optimizeMesh, whose triangle order seeds meshlets next to each other.
+    MeshletData buildMeshlets(std::span<const Vertex> vertices, std::span<const uint32> indices, std::span<const Submesh> submeshes,
+        const MeshletSettings& settings = MeshletSettings());
+    MeshletStats analyzeMeshlets(const MeshletData& meshlets, uint32 vertexCount, const MeshletSettings& settings = MeshletSettings());
+
+    // Extracts the frustum of a row-major view-projection matrix that transforms row vectors, with
+    // depth mapped to [0, 1] as in Direct3D.
+    Frustum makeFrustum(const float (&viewProjection)[16]);
+    bool isSphereInFrustum(const Frustum& frustum, const float (&center)[3], float radius);
+    bool isMeshletBackfacing(const MeshletBounds& bounds, const float (&cameraPosition)[3]);
+    // Reference for GPU cluster culling: appends the meshlets that are in the frustum and do not face away
+    // from the camera to visible. The frustum and the camera position are in the mesh's space.
+    MeshletCullStats cullMeshlets(const MeshletData& meshlets, const Frustum& frustum, const float (&cameraPosition)[3],
+        std::vector<uint32>& visible);
+}
\ No newline at end of file
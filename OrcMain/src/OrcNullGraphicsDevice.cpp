@@ -0,0 +1,124 @@
+#include "OrcCommandList.h"
+#include "OrcCommandStream.h"
+#include "OrcException.h"
+#include "OrcNullGraphicsDevice.h"
+#include "OrcTypes.h"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace Orc
+{
+    namespace
+    {
+        struct NullCommandReplayer
+        {
+            ResourceState* backBufferState;
+            uint32 backBufferCount;
+            NullBuffer* buffers;
+            uint64 commandCount = 0;
+
+            void operator()(const ResourceBarrierCommand& cmd)
+            {
+                if (cmd.resource < backBufferCount)
+                {
+                    if (backBufferState[cmd.resource] != cmd.before)
+                        throw OrcException("Resource barrier does not match the tracked resource state");
+                    backBufferState[cmd.resource] = cmd.after;
+                }
+                ++commandCount;
+            }
+
+            void operator()(const ClearRenderTargetCommand& cmd)
+            {
+                if (cmd.renderTarget < backBufferCount && backBufferState[cmd.renderTarget] != ResourceState::RS_RENDER_TARGET)
+                    throw OrcException("Render target is cleared outside of the render target state");
+                ++commandCount;
+            }
+
+            void operator()(const SetViewportCommand&) { ++commandCount; }
+            void operator()(const SetScissorRectCommand&) { ++commandCount; }
+            void operator()(const DrawInstancedCommand&) { ++commandCount; }
+            void operator()(const DrawIndexedInstancedCommand&) { ++commandCount; }
+            void operator()(const DispatchCommand&) { ++commandCount; }
+            void operator()(const CopyBufferRegionCommand& cmd)
+            {
+                auto& destination = buffers[cmd.destination].data;
+                const auto& source = buffers[cmd.source].data;
+                if (cmd.destinationOffset + cmd.numBytes > destination.size() || cmd.sourceOffset + cmd.numBytes > source.size())
+                    throw OrcException("Buffer copy out of bounds");
+                std::memcpy(destination.data() + cmd.destinationOffset, source.data() + cmd.sourceOffset, cmd.numBytes);
+                ++commandCount;
+            }
+        };
+    }
+
+    NullGraphicsDevice::NullGraphicsDevice(const GraphicsSettings& settings, JobSystem* jobSystem) : GraphicsDevice(GraphicsBackendType::GBT_NULL, settings, jobSystem)
+    {
+        for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+        {
+            mQueues[i] = std::make_unique<EmulatedQueue>(static_cast<CommandListType>(i));
+            mQueues[i]->setWaitStrategy(settings.waitStrategy, std::chrono::microseconds(settings.waitSpinMicroseconds));
+        }
+        // Without a frame latency waitable, DXGI's default maximum frame latency of 3 applies.
+        auto maxQueuedFrames = settings.framePacingMode == FramePacingMode::FPM_FENCE ? 3 : settings.maxFrameLatency;
+        _setPresentClock(std::make_unique<SimulatedPresentClock>(std::chrono::microseconds(16667), maxQueuedFrames));
+        mBackBufferState.assign(mSettings.backBufferCount, ResourceState::RS_PRESENT);
+        mBuffers.resize(ORC_MAX_RESOURCE_COUNT);
+        for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+            mCommandAllocatorPool[i] = std::make_unique<CommandAllocatorPool<uint32>>([this]() { return mNextAllocatorId++; }, [](uint32&) {});
+    }
+
+    NullGraphicsDevice::~NullGraphicsDevice()
+    {
+        _waitForIdle();
+    }
+
+    void NullGraphicsDevice::_executeCommandLists(CommandListType type, const std::vector<CommandListContext*>& contexts, uint64 fenceValue)
+    {
+        auto index = static_cast<uint32>(type);
+        if (!contexts.empty())
+        {
+            auto allocator = mCommandAllocatorPool[index]->acquire(mQueues[index]->getCompletedValue());
+            NullCommandReplayer replayer{ mBackBufferState.data(), static_cast<uint32>(mBackBufferState.size()), mBuffers.data() };
+            for (auto context : contexts)
+                context->getCommandStream().replay(replayer);
+            mReplayedCommandCount += replayer.commandCount;
+            mExecutedCommandListCount[index] += contexts.size();
+            mCommandAllocatorPool[index]->release(allocator, fenceValue);
+        }
+        ++mSubmissionCount[index];
+    }
+
+    void NullGraphicsDevice::_present()
+    {
+        if (mBackBufferState[mBackBufferIndex] != ResourceState::RS_PRESENT)
+            throw OrcException("Back buffer must be in the present state");
+        mOccluded = mSimulatedOcclusion;
+        _moveToNextFrame((mBackBufferIndex + 1) % mSettings.backBufferCount);
+
+        std::lock_guard<std::mutex> lock(mSubmitMutex);
+        for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+            mCommandAllocatorPool[i]->trim(mQueues[i]->getCompletedValue(), mSettings.framesInFlight);
+    }
+
+    void NullGraphicsDevice::_createBuffer(ResourceHandle handle, uint64 size, HeapType heapType)
+    {
+        mBuffers[handle].data.assign(size, 0);
+        mBuffers[handle].heapType = heapType;
+    }
+
+    void NullGraphicsDevice::_releaseResource(ResourceHandle handle)
+    {
+        mBuffers[handle] = NullBuffer();
+    }
+
+    uint8* NullGraphicsDevice::_getMappedData(ResourceHandle handle)
+    {
+        if (mBuffers[handle].heapType != HeapType::HT_UPLOAD)
+            throw OrcException("Only upload buffers can be mapped");
+        return mBuffers[handle].data.data();
+    }
+}
\ No newline at end of file
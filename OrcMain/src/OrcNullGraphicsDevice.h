@@ -0,0 +1,62 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcCommandAllocatorPool.h"
+#include "OrcCommandList.h"
+#include "OrcEmulatedQueue.h"
+#include "OrcGraphicsDevice.h"
+#include "OrcTypes.h"
+
+#include <memory>
+#include <vector>
+
+namespace Orc
+{
+    struct NullBuffer
+    {
+        std::vector<uint8> data;
+        HeapType heapType = HeapType::HT_DEFAULT;
+    };
+
+    // Headless backend: frames and command streams are tracked on the CPU only and every queue is an
+    // EmulatedQueue that completes its signals as soon as its GPU waits allow. Frames are paced
+    // against a 60 Hz SimulatedPresentClock, so pacing costs no real time. The present mode does not
+    // affect the simulated display, but PM_CAPPED still holds frames back in real time.
+    class NullGraphicsDevice : public GraphicsDevice
+    {
+    public:
+        NullGraphicsDevice(const GraphicsSettings& settings, JobSystem* jobSystem);
+        ~NullGraphicsDevice();
+
+        CommandAllocatorPoolStats getCommandAllocatorPoolStats(CommandListType type) const override { return mCommandAllocatorPool[static_cast<uint32>(type)]->getStats(); }
+
+        uint64 getCompletedFenceValue(CommandListType type) const { return getQueue(type)->getCompletedValue(); }
+        uint64 getExecutedCommandListCount(CommandListType type) const { return mExecutedCommandListCount[static_cast<uint32>(type)]; }
+        uint64 getSubmissionCount(CommandListType type) const { return mSubmissionCount[static_cast<uint32>(type)]; }
+        uint64 getReplayedCommandCount() const { return mReplayedCommandCount; }
+
+        // Simulates the window becoming occluded or visible; presents report it like DXGI_STATUS_OCCLUDED.
+        void setSimulatedOcclusion(bool occluded) { mSimulatedOcclusion = occluded; }
+    protected:
+        void _present() override;
+        bool _testOcclusion() override { return mSimulatedOcclusion; }
+        void _executeCommandLists(CommandListType type, const std::vector<CommandListContext*>& contexts, uint64 fenceValue) override;
+        void _createBuffer(ResourceHandle handle, uint64 size, HeapType heapType) override;
+        void _releaseResource(ResourceHandle handle) override;
+        uint8* _getMappedData(ResourceHandle handle) override;
+    private:
+        uint64 mExecutedCommandListCount[ORC_COMMAND_LIST_TYPE_COUNT]{};
+        uint64 mSubmissionCount[ORC_COMMAND_LIST_TYPE_COUNT]{};
+        uint64 mReplayedCommandCount = 0;
+        bool mSimulatedOcclusion = false;
+
+        std::vector<ResourceState> mBackBufferState;
+        // Buffer contents live in CPU memory so replayed copies can be checked. Sized up front so
+        // buffers can be created while another thread replays.
+        std::vector<NullBuffer> mBuffers;
+
+        uint32 mNextAllocatorId = 0;
+        std::unique_ptr<CommandAllocatorPool<uint32>> mCommandAllocatorPool[ORC_COMMAND_LIST_TYPE_COUNT];
+    };
+}
\ No newline at end of file
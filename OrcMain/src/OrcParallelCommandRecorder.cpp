@@ -0,0 +1,55 @@
+#include "OrcGraphicsDevice.h"
+#include "OrcJobSystem.h"
+#include "OrcParallelCommandRecorder.h"
+
+namespace Orc
+{
+    ParallelCommandRecorder::ParallelCommandRecorder(GraphicsDevice* device, JobSystem* jobSystem) : mDevice(device), mJobSystem(jobSystem)
+    {
+        mPools = std::vector<ContextPool>(mJobSystem->getThreadCount() + 1);
+    }
+
+    uint32 ParallelCommandRecorder::getThreadCount() const
+    {
+        return mJobSystem->getThreadCount();
+    }
+
+    const std::vector<CommandListContext*>& ParallelCommandRecorder::record(CommandListType type, uint32 chunkCount, const RecordFunction& recordChunk)
+    {
+        auto typeIndex = static_cast<uint32>(type);
+        for (auto& pool : mPools)
+            pool.usedCount[typeIndex] = 0;
+        mRecorded.assign(chunkCount, nullptr);
+
+        mJobSystem->parallelFor(chunkCount, [&](uint32 begin, uint32 end) { _recordChunks(type, begin, end, recordChunk); });
+        return mRecorded;
+    }
+
+    void ParallelCommandRecorder::_recordChunks(CommandListType type, uint32 begin, uint32 end, const RecordFunction& recordChunk)
+    {
+        auto& pool = mPools[mJobSystem->getCurrentThreadIndex()];
+        auto typeIndex = static_cast<uint32>(type);
+        auto& contexts = pool.contexts[typeIndex];
+
+        for (uint32 chunk = begin; chunk < end; ++chunk)
+        {
+            if (pool.usedCount[typeIndex] == contexts.size())
+                contexts.push_back(mDevice->createCommandListContext(type));
+            CommandListContext* context = contexts[pool.usedCount[typeIndex]++].get();
+
+            try
+            {
+                context->begin();
+                recordChunk(*context, chunk);
+                context->end();
+                mRecorded[chunk] = context;
+            }
+            catch (...)
+            {
+                if (context->isRecording())
+                    context->end();
+                throw;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcCommandList.h"
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Orc
+{
+    class GraphicsDevice;
+    class JobSystem;
+
+    // Fork/join recording of command list chunks on a job system. Each job system thread, the calling
+    // one included, owns its own pool of contexts, and the recorded contexts are returned in chunk
+    // order so submission is deterministic no matter which thread recorded which chunk. Contexts are
+    // reused by the next record() call, so they must be executed before then.
+    class ParallelCommandRecorder
+    {
+    public:
+        using RecordFunction = std::function<void(CommandListContext& context, uint32 chunkIndex)>;
+
+        ParallelCommandRecorder(GraphicsDevice* device, JobSystem* jobSystem);
+        ~ParallelCommandRecorder() = default;
+
+        const std::vector<CommandListContext*>& record(CommandListType type, uint32 chunkCount, const RecordFunction& recordChunk);
+
+        uint32 getThreadCount() const;
+
+        ORC_DISABLE_COPY_AND_MOVE(ParallelCommandRecorder)
+    private:
+        struct alignas(64) ContextPool
+        {
+            std::vector<std::shared_ptr<CommandListContext>> contexts[ORC_COMMAND_LIST_TYPE_COUNT];
+            uint32 usedCount[ORC_COMMAND_LIST_TYPE_COUNT]{};
+        };
+
+        void _recordChunks(CommandListType type, uint32 begin, uint32 end, const RecordFunction& recordChunk);
+
+        GraphicsDevice* mDevice;
+        JobSystem* mJobSystem;
+        // One pool per job system thread, plus one for a calling thread outside the job system.
+        std::vector<ContextPool> mPools;
+        std::vector<CommandListContext*> mRecorded;
+    };
+}
\ No newline at end of file
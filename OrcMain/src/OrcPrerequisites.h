@@ -1,5 +1,6 @@
 #pragma once
 
+#ifdef _WIN32
 #pragma comment(lib, "d3d12.lib")
 #pragma comment(lib, "dxgi.lib")
 #pragma comment(lib, "dxguid.lib")
@@ -13,5 +14,4 @@
 #include <dxgi1_6.h>
 #include <wrl/client.h>
 #include <wrl/wrappers/corewrappers.h>
-
-#define ORC_SWAPCHAIN_COUNT 3
\ No newline at end of file
+#endif
\ No newline at end of file
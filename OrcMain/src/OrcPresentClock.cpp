@@ -0,0 +1,59 @@
+#include "OrcPresentClock.h"
+
+#include <algorithm>
+
+namespace Orc
+{
+    SimulatedPresentClock::SimulatedPresentClock(Duration refreshInterval, uint32 maxQueuedFrames)
+        : mStart(std::chrono::steady_clock::now()), mNow(mStart), mRefreshInterval(refreshInterval), mMaxQueuedFrames(std::max(maxQueuedFrames, 1u))
+    {
+    }
+
+    void SimulatedPresentClock::sleepUntil(TimePoint time)
+    {
+        if (time > mNow)
+            _setNow(time);
+    }
+
+    void SimulatedPresentClock::waitForPresentSlot()
+    {
+        if (mQueuedFrames.size() >= mMaxQueuedFrames)
+            _setNow(mQueuedFrames[mQueuedFrames.size() - mMaxQueuedFrames].flipTime);
+    }
+
+    void SimulatedPresentClock::onPresent(TimePoint frameStart)
+    {
+        waitForPresentSlot();
+        auto flipTime = _nextVblank(mNow);
+        if (!mQueuedFrames.empty())
+            flipTime = std::max(flipTime, mQueuedFrames.back().flipTime + mRefreshInterval);
+        mQueuedFrames.push_back({ frameStart, flipTime });
+    }
+
+    bool SimulatedPresentClock::getLastVblank(TimePoint& time, uint64& count) const
+    {
+        count = static_cast<uint64>((mNow - mStart) / mRefreshInterval);
+        time = mStart + count * mRefreshInterval;
+        return true;
+    }
+
+    void SimulatedPresentClock::_setNow(TimePoint time)
+    {
+        mNow = time;
+        while (!mQueuedFrames.empty() && mQueuedFrames.front().flipTime <= mNow)
+        {
+            const auto& frame = mQueuedFrames.front();
+            if (mFlippedFrameCount)
+                mMissedVblankCount += (frame.flipTime - mLastFlipTime) / mRefreshInterval - 1;
+            mTotalLatency += frame.flipTime - frame.frameStart;
+            mLastFlipTime = frame.flipTime;
+            ++mFlippedFrameCount;
+            mQueuedFrames.pop_front();
+        }
+    }
+
+    SimulatedPresentClock::TimePoint SimulatedPresentClock::_nextVblank(TimePoint time) const
+    {
+        return mStart + ((time - mStart) / mRefreshInterval + 1) * mRefreshInterval;
+    }
+}
\ No newline at end of file
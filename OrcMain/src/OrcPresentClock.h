@@ -0,0 +1,80 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <chrono>
+#include <deque>
+
+namespace Orc
+{
+    // Time source and display feedback used by FramePacer. Backends provide one for their swap chain;
+    // SimulatedPresentClock stands in for a display so pacing can run and be measured headless.
+    class PresentClock
+    {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+        using Duration = std::chrono::nanoseconds;
+
+        virtual ~PresentClock() = default;
+
+        virtual TimePoint now() const = 0;
+        virtual void sleepUntil(TimePoint time) = 0;
+        // Blocks until the swap chain accepts another frame without exceeding the maximum frame latency.
+        virtual void waitForPresentSlot() = 0;
+        // Called when a frame whose CPU work started at frameStart is handed to the swap chain.
+        virtual void onPresent(TimePoint frameStart) = 0;
+        // Time and index of the latest vertical blank, false if the display has not reported one yet.
+        virtual bool getLastVblank(TimePoint& time, uint64& count) const = 0;
+    };
+
+    // Virtual-time display refreshing every refreshInterval. Presented frames flip on the first vblank
+    // after they were presented, one per vblank, and at most maxQueuedFrames wait to flip; presenting
+    // into a full queue blocks like Present does. Sleeping and waiting advance the virtual clock
+    // instead of blocking, and advance() simulates CPU work.
+    class SimulatedPresentClock : public PresentClock
+    {
+    public:
+        SimulatedPresentClock(Duration refreshInterval, uint32 maxQueuedFrames);
+        ~SimulatedPresentClock() = default;
+
+        TimePoint now() const override { return mNow; }
+        void sleepUntil(TimePoint time) override;
+        void waitForPresentSlot() override;
+        void onPresent(TimePoint frameStart) override;
+        bool getLastVblank(TimePoint& time, uint64& count) const override;
+
+        void advance(Duration duration) { _setNow(mNow + duration); }
+
+        uint64 getFlippedFrameCount() const { return mFlippedFrameCount; }
+        // Vblanks after the first flip that showed no new frame.
+        uint64 getMissedVblankCount() const { return mMissedVblankCount; }
+        // Sum over flipped frames of the time from the start of their CPU work to their flip.
+        Duration getTotalLatency() const { return mTotalLatency; }
+        Duration getRefreshInterval() const { return mRefreshInterval; }
+
+        ORC_DISABLE_COPY_AND_MOVE(SimulatedPresentClock)
+    private:
+        struct QueuedFrame
+        {
+            TimePoint frameStart;
+            TimePoint flipTime;
+        };
+
+        void _setNow(TimePoint time);
+        TimePoint _nextVblank(TimePoint time) const;
+
+        TimePoint mStart;
+        TimePoint mNow;
+        Duration mRefreshInterval;
+        uint32 mMaxQueuedFrames;
+        std::deque<QueuedFrame> mQueuedFrames;
+        TimePoint mLastFlipTime{};
+
+        uint64 mFlippedFrameCount = 0;
+        uint64 mMissedVblankCount = 0;
+        Duration mTotalLatency{};
+    };
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "OrcCpuPause.h"
+#include "OrcQueue.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <thread>
+
+namespace Orc
+{
+    void Queue::waitFor(uint64 value)
+    {
+        mWaitCount.fetch_add(1, std::memory_order_relaxed);
+        if (isComplete(value))
+            return;
+
+        auto start = std::chrono::steady_clock::now();
+        switch (mWaitStrategy)
+        {
+        case WaitStrategy::WS_BLOCK:
+            _waitFor(value);
+            break;
+        case WaitStrategy::WS_SPIN_THEN_BLOCK:
+        {
+            auto spinEnd = start + mSpinTime;
+            bool completed = false;
+            while (!(completed = isComplete(value)) && std::chrono::steady_clock::now() < spinEnd)
+            {
+                for (uint32 i = 0; i < 32; ++i)
+                    ORC_CPU_PAUSE();
+            }
+            if (completed)
+            {
+                mSpinResolvedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            _waitFor(value);
+            break;
+        }
+        case WaitStrategy::WS_YIELD:
+            while (!isComplete(value))
+                std::this_thread::yield();
+            break;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        auto microseconds = static_cast<uint64>(elapsed.count() / 1000);
+        auto bucket = std::min<uint32>(static_cast<uint32>(std::bit_width(microseconds)), ORC_WAIT_HISTOGRAM_BUCKET_COUNT - 1);
+        mDurationHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+        mBlockedNanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+        mBlockedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    QueueWaitStats Queue::getWaitStats() const
+    {
+        QueueWaitStats stats;
+        stats.waitCount = mWaitCount.load(std::memory_order_relaxed);
+        stats.blockedCount = mBlockedCount.load(std::memory_order_relaxed);
+        stats.spinResolvedCount = mSpinResolvedCount.load(std::memory_order_relaxed);
+        stats.blockedTime = std::chrono::nanoseconds(mBlockedNanoseconds.load(std::memory_order_relaxed));
+        for (uint32 i = 0; i < ORC_WAIT_HISTOGRAM_BUCKET_COUNT; ++i)
+            stats.durationHistogram[i] = mDurationHistogram[i].load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void Queue::resetWaitStats()
+    {
+        mWaitCount.store(0, std::memory_order_relaxed);
+        mBlockedCount.store(0, std::memory_order_relaxed);
+        mSpinResolvedCount.store(0, std::memory_order_relaxed);
+        mBlockedNanoseconds.store(0, std::memory_order_relaxed);
+        for (auto& count : mDurationHistogram)
+            count.store(0, std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
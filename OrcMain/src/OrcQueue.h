@@ -0,0 +1,84 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcCommandList.h"
+#include "OrcDefines.h"
+#include "OrcGraphicsSettings.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+#include <chrono>
+
+#define ORC_WAIT_HISTOGRAM_BUCKET_COUNT 16
+
+namespace Orc
+{
+    struct QueueWaitStats
+    {
+        uint64 waitCount = 0;
+        // Waits that parked or yielded the thread.
+        uint64 blockedCount = 0;
+        // Waits that the spin phase resolved without parking the thread, which are not blocked ones.
+        uint64 spinResolvedCount = 0;
+        std::chrono::nanoseconds blockedTime{};
+        // Blocked waits by duration: bucket 0 is under 1us, bucket i under 2^i us, the last one open ended.
+        uint64 durationHistogram[ORC_WAIT_HISTOGRAM_BUCKET_COUNT]{};
+    };
+
+    // A command queue with a monotonically increasing timeline: every signal() returns the next value,
+    // which completes once the queue has executed everything submitted before it.
+    class Queue
+    {
+    public:
+        virtual ~Queue() = default;
+
+        virtual uint64 signal() = 0;
+        virtual uint64 getCompletedValue() const = 0;
+        // Makes work submitted to this queue after the call wait on the GPU until other reaches value.
+        virtual void gpuWait(Queue& other, uint64 value) = 0;
+
+        bool isComplete(uint64 value) const
+        {
+            if (value <= mCompletedValueCache.load(std::memory_order_relaxed))
+                return true;
+            auto completed = getCompletedValue();
+            mCompletedValueCache.store(completed, std::memory_order_relaxed);
+            return value <= completed;
+        }
+
+        // Blocks the calling thread until value has completed, following the wait strategy. Only waits
+        // that park or yield the thread are timed. Safe to call from several threads at once.
+        void waitFor(uint64 value);
+        // Every submission is followed by a signal, so the last signaled value covers all submitted work.
+        void waitForIdle() { waitFor(mLastSignaledValue); }
+
+        void setWaitStrategy(WaitStrategy strategy, std::chrono::microseconds spinTime) { mWaitStrategy = strategy; mSpinTime = spinTime; }
+        WaitStrategy getWaitStrategy() const { return mWaitStrategy; }
+
+        CommandListType getType() const { return mType; }
+        uint64 getLastSignaledValue() const { return mLastSignaledValue; }
+        QueueWaitStats getWaitStats() const;
+        void resetWaitStats();
+
+        ORC_DISABLE_COPY_AND_MOVE(Queue)
+    protected:
+        Queue(CommandListType type) : mType(type) {}
+
+        // Parks the calling thread until value has completed.
+        virtual void _waitFor(uint64 value) = 0;
+
+        CommandListType mType;
+        uint64 mLastSignaledValue = 0;
+        mutable std::atomic<uint64> mCompletedValueCache{ 0 };
+
+        WaitStrategy mWaitStrategy = WaitStrategy::WS_BLOCK;
+        std::chrono::microseconds mSpinTime{};
+        // Updated by every thread that waits, the render thread and the main thread among them.
+        std::atomic<uint64> mWaitCount{ 0 };
+        std::atomic<uint64> mBlockedCount{ 0 };
+        std::atomic<uint64> mSpinResolvedCount{ 0 };
+        std::atomic<int64> mBlockedNanoseconds{ 0 };
+        std::atomic<uint64> mDurationHistogram[ORC_WAIT_HISTOGRAM_BUCKET_COUNT]{};
+    };
+}
\ No newline at end of file
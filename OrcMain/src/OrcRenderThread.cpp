@@ -0,0 +1,113 @@
+#include "OrcRenderThread.h"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace Orc
+{
+    RenderThread::RenderThread(RenderFunction render) : mRender(std::move(render))
+    {
+        mThread = std::thread(&RenderThread::_threadMain, this);
+    }
+
+    RenderThread::~RenderThread()
+    {
+        mShutdown.store(true, std::memory_order_release);
+        mSnapshotEvent.set();
+        mThread.join();
+    }
+
+    FrameSnapshot& RenderThread::beginSnapshot()
+    {
+        auto start = std::chrono::steady_clock::now();
+        while (mSnapshots.hasPending())
+        {
+            _rethrowIfFailed();
+            mConsumedEvent.wait();
+        }
+        _rethrowIfFailed();
+        mSimulationStart = std::chrono::steady_clock::now();
+        mMainWaitTime += mSimulationStart - start;
+        return mSnapshots.getWriteBuffer();
+    }
+
+    void RenderThread::submitSnapshot()
+    {
+        auto now = std::chrono::steady_clock::now();
+        mSimulationTime += now - mSimulationStart;
+        if (mSubmittedCount == 0)
+            mFirstSubmitTime = now;
+        // The render thread still working on an earlier frame means this one was simulated in parallel.
+        if (mCompletedCount.load(std::memory_order_acquire) < mSubmittedCount)
+            ++mOverlappedFrameCount;
+
+        ++mSubmittedCount;
+        mSnapshots.publish();
+        mSnapshotEvent.set();
+    }
+
+    void RenderThread::waitForIdle()
+    {
+        while (mCompletedCount.load(std::memory_order_acquire) < mSubmittedCount)
+        {
+            _rethrowIfFailed();
+            mConsumedEvent.wait();
+        }
+        _rethrowIfFailed();
+    }
+
+    RenderThreadStats RenderThread::getStats() const
+    {
+        RenderThreadStats stats;
+        stats.submittedFrameCount = mSubmittedCount;
+        stats.renderedFrameCount = mCompletedCount.load(std::memory_order_acquire);
+        stats.overlappedFrameCount = mOverlappedFrameCount;
+        stats.simulationTime = mSimulationTime;
+        stats.renderTime = std::chrono::nanoseconds(mRenderTime.load(std::memory_order_relaxed));
+        stats.mainWaitTime = mMainWaitTime;
+        stats.renderWaitTime = std::chrono::nanoseconds(mRenderWaitTime.load(std::memory_order_relaxed));
+        if (mSubmittedCount)
+            stats.wallTime = std::chrono::steady_clock::now() - mFirstSubmitTime;
+        return stats;
+    }
+
+    void RenderThread::_rethrowIfFailed()
+    {
+        if (mFailed.load(std::memory_order_acquire))
+            std::rethrow_exception(mException);
+    }
+
+    void RenderThread::_threadMain()
+    {
+        for (;;)
+        {
+            auto waitStart = std::chrono::steady_clock::now();
+            while (!mSnapshots.acquire())
+            {
+                if (mShutdown.load(std::memory_order_acquire))
+                    return;
+                mSnapshotEvent.wait();
+            }
+            auto renderStart = std::chrono::steady_clock::now();
+            mRenderWaitTime.fetch_add((renderStart - waitStart).count(), std::memory_order_relaxed);
+            mConsumedEvent.set();
+
+            try
+            {
+                mRender(mSnapshots.getReadBuffer());
+            }
+            catch (...)
+            {
+                mException = std::current_exception();
+                mFailed.store(true, std::memory_order_release);
+                mConsumedEvent.set();
+                return;
+            }
+
+            mRenderTime.fetch_add((std::chrono::steady_clock::now() - renderStart).count(), std::memory_order_relaxed);
+            mCompletedCount.fetch_add(1, std::memory_order_release);
+            mConsumedEvent.set();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcDefines.h"
+#include "OrcEvent.h"
+#include "OrcFrameSnapshot.h"
+#include "OrcRoot.h"
+#include "OrcTripleBuffer.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <thread>
+
+namespace Orc
+{
+    // Renders frame snapshots on its own thread. At most one snapshot waits for the render thread, so
+    // the main thread builds frame N+1 while frame N is being submitted but never runs further ahead.
+    class RenderThread
+    {
+    public:
+        using RenderFunction = std::function<void(const FrameSnapshot& snapshot)>;
+
+        RenderThread(RenderFunction render);
+        ~RenderThread();
+
+        // Waits until the previous snapshot was picked up and returns the buffer to fill.
+        FrameSnapshot& beginSnapshot();
+        void submitSnapshot();
+        // Waits until every submitted snapshot has been rendered.
+        void waitForIdle();
+
+        RenderThreadStats getStats() const;
+
+        ORC_DISABLE_COPY_AND_MOVE(RenderThread)
+    private:
+        void _threadMain();
+        void _rethrowIfFailed();
+
+        RenderFunction mRender;
+        TripleBuffer<FrameSnapshot> mSnapshots;
+        Event mSnapshotEvent;
+        Event mConsumedEvent;
+        std::atomic<bool> mShutdown{ false };
+        std::atomic<bool> mFailed{ false };
+        std::exception_ptr mException;
+
+        uint64 mSubmittedCount = 0;
+        std::atomic<uint64> mCompletedCount{ 0 };
+
+        std::chrono::steady_clock::time_point mFirstSubmitTime{};
+        std::chrono::steady_clock::time_point mSimulationStart{};
+        uint64 mOverlappedFrameCount = 0;
+        std::chrono::nanoseconds mSimulationTime{};
+        std::chrono::nanoseconds mMainWaitTime{};
+        std::atomic<int64> mRenderTime{ 0 };
+        std::atomic<int64> mRenderWaitTime{ 0 };
+
+        std::thread mThread;
+    };
+}
\ No newline at end of file
@@ -1,42 +1,258 @@
+#include "OrcAsyncScheduler.h"
+#include "OrcCommandList.h"
+#include "OrcDetail.h"
+#include "OrcEntityLoader.h"
+#include "OrcEvent.h"
+#include "OrcFrameSnapshot.h"
 #include "OrcGraphicsDevice.h"
+#include "OrcJobSystem.h"
 #include "OrcManager.h"
+#include "OrcRenderThread.h"
 #include "OrcRoot.h"
 #include "OrcTypes.h"
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <vector>
 
 namespace Orc
 {
-    Root::Root(void* handle, uint32 w, uint32 h) : mWidthForSwapChain(w), mHeightForSwapChain(h)
+    namespace
     {
-        HWND* hwndPtr = static_cast<HWND*>(handle);
-        mGraphicsDevice = std::make_shared<GraphicsDevice>(*hwndPtr, mWidthForSwapChain, mHeightForSwapChain);
+        constexpr uint32 INFINITE_TIMEOUT = std::numeric_limits<uint32>::max();
+        // Fences signal no event the loop can wait on, so an idle on-demand loop polls them at this rate.
+        constexpr uint32 FENCE_POLL_INTERVAL_MILLISECONDS = 1;
+    }
+
+    Root::Root(void* handle, uint32 w, uint32 h, const GraphicsSettings& settings, uint32 workerThreadCount) : mWidthForSwapChain(w), mHeightForSwapChain(h)
+    {
+        auto jobSystem = std::make_shared<JobSystem>(workerThreadCount);
+        mJobSystem = jobSystem;
+        auto device = GraphicsDevice::create(handle, mWidthForSwapChain, mHeightForSwapChain, settings, jobSystem.get());
+        auto event = std::make_shared<Event>();
+        mGraphicsDevice = device;
+        mInvalidateEvent = event;
+        mInlineSnapshot = std::make_shared<FrameSnapshot>();
+
+        auto scheduler = std::make_shared<AsyncScheduler>(jobSystem.get());
+        scheduler->setWakeFunction([event = event.get()] { event->set(); });
+        mAsyncScheduler = scheduler;
+        mEntityLoader = std::make_shared<EntityLoader>(device.get(), jobSystem.get(), scheduler.get());
+    }
+
+    Root::~Root()
+    {
+        // The render thread uses the graphics device, so it has to stop first.
+        mRenderThread.reset();
     }
 
     void Root::startRendering()
+    {
+        mQueuedEndRendering = false;
+        while (!mQueuedEndRendering)
+        {
+            if (!_processMessages())
+                break;
+
+            if (isThrottled())
+                _throttle();
+            else if (mRenderMode == RenderMode::RM_CONTINUOUS || _consumeInvalidation())
+                renderOneFrame();
+            else if (!_getAsyncScheduler()->poll())
+                _waitForInvalidation(_getAsyncScheduler()->hasFenceWaits() ? FENCE_POLL_INTERVAL_MILLISECONDS : INFINITE_TIMEOUT);
+        }
+        if (auto renderThread = static_cast<RenderThread*>(mRenderThread.get()))
+            renderThread->waitForIdle();
+    }
+
+    void Root::renderOneFrame()
+    {
+        _getAsyncScheduler()->poll();
+        if (mFrameStartedCallback)
+            mFrameStartedCallback(mRenderedFrameCount);
+
+        if (auto renderThread = static_cast<RenderThread*>(mRenderThread.get()))
+        {
+            _buildSnapshot(renderThread->beginSnapshot());
+            renderThread->submitSnapshot();
+        }
+        else
+        {
+            auto& snapshot = *static_cast<FrameSnapshot*>(mInlineSnapshot.get());
+            _buildSnapshot(snapshot);
+            _renderSnapshot(snapshot);
+        }
+        ++mRenderedFrameCount;
+    }
+
+    void Root::_buildSnapshot(FrameSnapshot& snapshot)
+    {
+        snapshot.frameNumber = mRenderedFrameCount;
+        snapshot.simulationStart = std::chrono::steady_clock::now();
+        snapshot.scenes.resize(mSceneManagers.size());
+        for (size_t i = 0; i < mSceneManagers.size(); ++i)
+        {
+            mSceneManagers[i]->_selectLods();
+            mSceneManagers[i]->_buildSnapshot(snapshot.scenes[i]);
+        }
+    }
+
+    void Root::_renderSnapshot(const FrameSnapshot& snapshot)
     {
         GraphicsDevice* realDevice = static_cast<GraphicsDevice*>(mGraphicsDevice.get());
+        realDevice->beginDraw();
+        realDevice->endDraw();
+        // Tagged while the snapshot still holds the meshes, so whichever thread drops the last reference
+        // sees the value. Later submissions only make it more conservative.
+        auto frameFenceValue = realDevice->getLastSignaledFenceValue(CommandListType::CLT_GRAPHICS);
+        for (const auto& scene : snapshot.scenes)
+        {
+            for (const auto& item : scene.drawItems)
+                item.mesh->lastFrameFenceValue = frameFenceValue;
+        }
+    }
+
+    void Root::setRenderThreadEnabled(bool enabled)
+    {
+        if (enabled == isRenderThreadEnabled())
+            return;
+        if (enabled)
+        {
+            mRenderThread = std::make_shared<RenderThread>([this](const FrameSnapshot& snapshot) { _renderSnapshot(snapshot); });
+            return;
+        }
+        static_cast<RenderThread*>(mRenderThread.get())->waitForIdle();
+        mRenderThread.reset();
+    }
+
+    void Root::setMaxConcurrentEntityLoads(uint32 count)
+    {
+        _getEntityLoader()->setMaxConcurrentLoads(count);
+    }
+
+    void Root::setMeshImportSettings(const MeshImportSettings& settings)
+    {
+        _getEntityLoader()->setImportSettings(settings);
+    }
+
+    const MeshImportSettings& Root::getMeshImportSettings() const
+    {
+        return _getEntityLoader()->getImportSettings();
+    }
+
+    uint32 Root::getPendingEntityLoadCount() const
+    {
+        return _getEntityLoader()->getQueuedLoadCount() + _getEntityLoader()->getActiveLoadCount();
+    }
+
+    RenderThreadStats Root::getRenderThreadStats() const
+    {
+        if (auto renderThread = static_cast<RenderThread*>(mRenderThread.get()))
+            return renderThread->getStats();
+        return RenderThreadStats();
+    }
+
+    void Root::setPresentMode(PresentMode mode, uint32 frameRateCap)
+    {
+        static_cast<GraphicsDevice*>(mGraphicsDevice.get())->setPresentMode(mode, frameRateCap);
+    }
+
+    void Root::queueEndRendering()
+    {
+        mQueuedEndRendering = true;
+        static_cast<Event*>(mInvalidateEvent.get())->set();
+    }
+
+    void Root::invalidate()
+    {
+        mInvalidated.store(true, std::memory_order_release);
+        static_cast<Event*>(mInvalidateEvent.get())->set();
+    }
+
+    bool Root::_processMessages()
+    {
+#ifdef _WIN32
         MSG msg = {};
-        while (WM_QUIT != msg.message)
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
         {
-            if (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
-            {
-                TranslateMessage(&msg);
-                DispatchMessageW(&msg);
-            }
-            else
+            if (WM_QUIT == msg.message)
+                return false;
+            if ((msg.message >= WM_KEYFIRST && msg.message <= WM_KEYLAST) || (msg.message >= WM_MOUSEFIRST && msg.message <= WM_MOUSELAST) ||
+                msg.message == WM_INPUT || msg.message == WM_PAINT)
+                mInvalidated.store(true, std::memory_order_relaxed);
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+#endif
+        return true;
+    }
+
+    bool Root::isThrottled() const
+    {
+        return mMinimized || static_cast<GraphicsDevice*>(mGraphicsDevice.get())->isOccluded();
+    }
+
+    void Root::_throttle()
+    {
+        // A minimized window is restored through WM_SIZE, which wakes the wait; occlusion has no such
+        // notification, so it is probed with a test present at a low rate.
+        // Visibility probes present on the swap chain, which the render thread must not be using.
+        if (auto renderThread = static_cast<RenderThread*>(mRenderThread.get()))
+            renderThread->waitForIdle();
+        if (mMinimized)
+        {
+            _waitForInvalidation(INFINITE_TIMEOUT);
+            return;
+        }
+        _waitForInvalidation(mOcclusionProbeIntervalMilliseconds);
+        ++mOcclusionProbeCount;
+        if (static_cast<GraphicsDevice*>(mGraphicsDevice.get())->probeVisibility())
+            invalidate();
+    }
+
+    bool Root::_consumeInvalidation()
+    {
+        bool dirty = mInvalidated.exchange(false, std::memory_order_acquire);
+        for (auto& sceneManager : mSceneManagers)
+        {
+            auto generation = sceneManager->getGeneration();
+            if (generation != sceneManager->mRenderedGeneration)
             {
-                realDevice->beginDraw();
-                realDevice->endDraw();
+                sceneManager->mRenderedGeneration = generation;
+                dirty = true;
             }
         }
+        return dirty;
+    }
+
+    bool Root::_waitForInvalidation(uint32 timeoutMilliseconds)
+    {
+        auto event = static_cast<Event*>(mInvalidateEvent.get());
+#ifdef _WIN32
+        // Window messages wake the loop as well, so input is handled without polling.
+        HANDLE handle = event->getNativeHandle();
+        auto timeout = timeoutMilliseconds == INFINITE_TIMEOUT ? INFINITE : static_cast<DWORD>(timeoutMilliseconds);
+        return MsgWaitForMultipleObjectsEx(1, &handle, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE) != WAIT_TIMEOUT;
+#else
+        if (timeoutMilliseconds == INFINITE_TIMEOUT)
+        {
+            event->wait();
+            return true;
+        }
+        return event->wait(std::chrono::milliseconds(timeoutMilliseconds));
+#endif
     }
 
     SceneManager* Root::createSceneManager(const String& sceneManagerName)
     {
-        return nullptr;
+        auto sceneManager = std::make_shared<detail::SceneManager>(this, sceneManagerName);
+        mSceneManagers.push_back(sceneManager);
+        invalidate();
+        return sceneManager.get();
     }
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "OrcPrerequisites.h"
+
+#include "OrcCommandList.h"
+#include "OrcException.h"
+#include "OrcTypes.h"
+
+#include <vector>
+
+namespace Orc
+{
+    struct QueueWait
+    {
+        CommandListType queue;
+        uint64 fenceValue;
+    };
+
+    // Fence values signaled by GraphicsDevice::submitBatch, 0 for queues the batch did not touch.
+    struct SubmissionResult
+    {
+        uint64 fenceValue[ORC_COMMAND_LIST_TYPE_COUNT]{};
+
+        uint64 getFenceValue(CommandListType type) const { return fenceValue[static_cast<uint32>(type)]; }
+    };
+
+    // Accumulates closed command list contexts per queue. Submitting the batch executes every queue's
+    // contexts in insertion order with a single ExecuteCommandLists and a single fence signal, after
+    // the queue has waited on the GPU for the fence values added with addQueueWait.
+    class SubmissionBatch
+    {
+    public:
+        void addCommandListContext(CommandListContext* context)
+        {
+            mContexts[static_cast<uint32>(context->getCommandListType())].push_back(context);
+        }
+
+        void addCommandListContexts(const std::vector<CommandListContext*>& contexts)
+        {
+            for (auto context : contexts)
+                addCommandListContext(context);
+        }
+
+        void addQueueWait(CommandListType queue, CommandListType waitQueue, uint64 fenceValue)
+        {
+            if (queue == waitQueue)
+                throw OrcException("A queue cannot wait on its own fence");
+            mWaits[static_cast<uint32>(queue)].push_back({ waitQueue, fenceValue });
+        }
+
+        void addQueueWait(CommandListType queue, const SubmissionResult& previous, CommandListType waitQueue)
+        {
+            if (previous.getFenceValue(waitQueue))
+                addQueueWait(queue, waitQueue, previous.getFenceValue(waitQueue));
+        }
+
+        void clear()
+        {
+            for (uint32 i = 0; i < ORC_COMMAND_LIST_TYPE_COUNT; ++i)
+            {
+                mContexts[i].clear();
+                mWaits[i].clear();
+            }
+        }
+
+        const std::vector<CommandListContext*>& getCommandListContexts(CommandListType type) const { return mContexts[static_cast<uint32>(type)]; }
+        const std::vector<QueueWait>& getQueueWaits(CommandListType type) const { return mWaits[static_cast<uint32>(type)]; }
+        bool isEmpty(CommandListType type) const { return mContexts[static_cast<uint32>(type)].empty() && mWaits[static_cast<uint32>(type)].empty(); }
+    private:
+        std::vector<CommandListContext*> mContexts[ORC_COMMAND_LIST_TYPE_COUNT];
+        std::vector<QueueWait> mWaits[ORC_COMMAND_LIST_TYPE_COUNT];
+    };
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace Orc
+{
+    template <typename T = void>
+    class Task;
+    template <typename T>
+    class TaskPromise;
+
+    class TaskPromiseBase
+    {
+    public:
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept { return false; }
+            // Symmetric transfer to the awaiting coroutine keeps long chains of tasks from growing the stack.
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                auto continuation = handle.promise().mContinuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { mException = std::current_exception(); }
+
+        void setContinuation(std::coroutine_handle<> continuation) { mContinuation = continuation; }
+        void rethrowIfFailed() const
+        {
+            if (mException)
+                std::rethrow_exception(mException);
+        }
+    private:
+        std::coroutine_handle<> mContinuation;
+        std::exception_ptr mException;
+    };
+
+    template <typename T>
+    class TaskPromise : public TaskPromiseBase
+    {
+    public:
+        Task<T> get_return_object();
+        template <typename U>
+        void return_value(U&& value) { mValue.emplace(std::forward<U>(value)); }
+
+        T takeResult()
+        {
+            rethrowIfFailed();
+            return std::move(*mValue);
+        }
+    private:
+        std::optional<T> mValue;
+    };
+
+    template <>
+    class TaskPromise<void> : public TaskPromiseBase
+    {
+    public:
+        Task<void> get_return_object();
+        void return_void() {}
+
+        void takeResult() { rethrowIfFailed(); }
+    };
+
+    // Lazily started coroutine. Awaiting a task starts it and resumes the awaiting coroutine when it
+    // finishes, with its result or exception; AsyncScheduler::spawn runs one without an awaiting caller.
+    template <typename T>
+    class Task
+    {
+    public:
+        using promise_type = TaskPromise<T>;
+
+        Task() = default;
+        Task(Task&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (mHandle)
+                    mHandle.destroy();
+                mHandle = std::exchange(other.mHandle, nullptr);
+            }
+            return *this;
+        }
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task()
+        {
+            if (mHandle)
+                mHandle.destroy();
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() noexcept { return handle.done(); }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().setContinuation(awaiting);
+                    return handle;
+                }
+                T await_resume() { return handle.promise().takeResult(); }
+            };
+            return Awaiter{ mHandle };
+        }
+
+        bool isDone() const { return !mHandle || mHandle.done(); }
+        std::coroutine_handle<promise_type> getHandle() const { return mHandle; }
+    private:
+        friend promise_type;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) : mHandle(handle) {}
+
+        std::coroutine_handle<promise_type> mHandle;
+    };
+
+    template <typename T>
+    Task<T> TaskPromise<T>::get_return_object()
+    {
+        return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> TaskPromise<void>::get_return_object()
+    {
+        return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "OrcTypes.h"
+
+#include <vector>
+
+namespace Orc
+{
+    struct TextureMip
+    {
+        uint32 width;
+        uint32 height;
+        // Where the level starts in TextureData::texels.
+        uint64 offset;
+    };
+
+    // An RGBA8 image and its mip chain down to 1x1, packed largest level first.
+    struct TextureData
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        std::vector<TextureMip> mips;
+        std::vector<uint8> texels;
+    };
+}
\ No newline at end of file
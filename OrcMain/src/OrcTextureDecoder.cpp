@@ -0,0 +1,139 @@
+#include "OrcException.h"
+#include "OrcTextureDecoder.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace Orc
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr uint32 TEXEL_SIZE = 4;
+
+        uint64 getElapsedNanoseconds(Clock::time_point start)
+        {
+            return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+    }
+
+    uint64 layoutMips(TextureData& texture)
+    {
+        texture.mips.clear();
+        uint32 mipWidth = texture.width, mipHeight = texture.height;
+        uint64 offset = 0;
+        for (;;)
+        {
+            texture.mips.push_back({ mipWidth, mipHeight, offset });
+            offset += uint64(mipWidth) * mipHeight * TEXEL_SIZE;
+            if (mipWidth <= 1 && mipHeight <= 1)
+                break;
+            mipWidth = std::max(mipWidth / 2, 1u);
+            mipHeight = std::max(mipHeight / 2, 1u);
+        }
+        return offset;
+    }
+
+    TextureData decodeImage(std::span<const uint8> encoded)
+    {
+        if (encoded.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+            throw OrcException("Image is too large to decode");
+
+        int width = 0, height = 0, channels = 0;
+        std::unique_ptr<stbi_uc, void (*)(void*)> pixels(
+            stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()), &width, &height, &channels, TEXEL_SIZE), stbi_image_free);
+        if (!pixels)
+            throw OrcException(String("Cannot decode image: ") + stbi_failure_reason());
+
+        TextureData texture;
+        texture.width = static_cast<uint32>(width);
+        texture.height = static_cast<uint32>(height);
+        texture.texels.resize(layoutMips(texture));
+        std::memcpy(texture.texels.data(), pixels.get(), uint64(texture.width) * texture.height * TEXEL_SIZE);
+        return texture;
+    }
+
+    void generateMips(TextureData& texture)
+    {
+        for (size_t level = 1; level < texture.mips.size(); ++level)
+        {
+            const auto& source = texture.mips[level - 1];
+            const auto& target = texture.mips[level];
+            const uint8* sourceTexels = texture.texels.data() + source.offset;
+            uint8* targetTexels = texture.texels.data() + target.offset;
+            uint64 sourcePitch = uint64(source.width) * TEXEL_SIZE;
+
+            for (uint32 y = 0; y < target.height; ++y)
+            {
+                // A dimension that is already 1 is not halved, so both samples are the same row or column.
+                const uint8* row0 = sourceTexels + std::min(y * 2, source.height - 1) * sourcePitch;
+                const uint8* row1 = sourceTexels + std::min(y * 2 + 1, source.height - 1) * sourcePitch;
+                uint8* out = targetTexels + uint64(y) * target.width * TEXEL_SIZE;
+                for (uint32 x = 0; x < target.width; ++x)
+                {
+                    uint32 x0 = std::min(x * 2, source.width - 1) * TEXEL_SIZE;
+                    uint32 x1 = std::min(x * 2 + 1, source.width - 1) * TEXEL_SIZE;
+                    for (uint32 c = 0; c < TEXEL_SIZE; ++c)
+                        out[x * TEXEL_SIZE + c] = static_cast<uint8>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+                }
+            }
+        }
+    }
+
+    TextureDecoder::~TextureDecoder()
+    {
+        try
+        {
+            wait();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    void TextureDecoder::decode(std::span<const uint8> encoded, TextureData& texture)
+    {
+        mJobSystem->run([this, encoded, &texture]
+        {
+            auto start = Clock::now();
+            texture = decodeImage(encoded);
+            mDecodeTime.fetch_add(getElapsedNanoseconds(start), std::memory_order_relaxed);
+            mImageCount.fetch_add(1, std::memory_order_relaxed);
+            mEncodedBytes.fetch_add(encoded.size(), std::memory_order_relaxed);
+            mDecodedBytes.fetch_add(texture.mips[0].width * uint64(texture.mips[0].height) * TEXEL_SIZE, std::memory_order_relaxed);
+
+            // Started from the decode job, which still holds the counter, so wait() cannot miss it.
+            mJobSystem->run([this, &texture]
+            {
+                auto start = Clock::now();
+                generateMips(texture);
+                mMipTime.fetch_add(getElapsedNanoseconds(start), std::memory_order_relaxed);
+            }, &mCounter);
+        }, &mCounter);
+    }
+
+    void TextureDecoder::wait()
+    {
+        mJobSystem->wait(mCounter);
+    }
+
+    TextureDecoderStats TextureDecoder::getStats() const
+    {
+        TextureDecoderStats stats;
+        stats.imageCount = mImageCount.load(std::memory_order_relaxed);
+        stats.encodedBytes = mEncodedBytes.load(std::memory_order_relaxed);
+        stats.decodedBytes = mDecodedBytes.load(std::memory_order_relaxed);
+        stats.decodeTime = std::chrono::nanoseconds(mDecodeTime.load(std::memory_order_relaxed));
+        stats.mipTime = std::chrono::nanoseconds(mMipTime.load(std::memory_order_relaxed));
+        return stats;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcJobSystem.h"
+#include "OrcTexture.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <span>
+
+namespace Orc
+{
+    // Fills mips with the levels of a width x height texture down to 1x1 and returns the bytes they
+    // take, without sizing texels.
+    uint64 layoutMips(TextureData& texture);
+    // Decodes a PNG or JPEG to RGBA8 and lays out the whole mip chain, of which only the first level is
+    // filled. Throws OrcException if the image cannot be decoded.
+    TextureData decodeImage(std::span<const uint8> encoded);
+    // Fills every level but the first by averaging 2x2 blocks of the level above.
+    void generateMips(TextureData& texture);
+
+    struct TextureDecoderStats
+    {
+        uint64 imageCount = 0;
+        uint64 encodedBytes = 0;
+        // RGBA8 bytes of the first levels; the mips add a third on top.
+        uint64 decodedBytes = 0;
+        // Time spent in decode and mip jobs, summed over the threads that ran them.
+        std::chrono::nanoseconds decodeTime{};
+        std::chrono::nanoseconds mipTime{};
+    };
+
+    // Decodes images on a job system. Every image is decoded by a job of its own, which starts another
+    // to generate the mips once it is done, so the images of an asset decode in parallel instead of one
+    // after another on the loading thread.
+    class TextureDecoder
+    {
+    public:
+        TextureDecoder(JobSystem* jobSystem) : mJobSystem(jobSystem) {}
+        // Waits for the jobs still running, discarding their failures.
+        ~TextureDecoder();
+
+        // Starts decoding encoded into texture, both of which must stay valid until wait() returns.
+        void decode(std::span<const uint8> encoded, TextureData& texture);
+        // Runs jobs until every decode started so far is done. Rethrows the first failure.
+        void wait();
+
+        TextureDecoderStats getStats() const;
+
+        ORC_DISABLE_COPY_AND_MOVE(TextureDecoder)
+    private:
+        JobSystem* mJobSystem;
+        JobCounter mCounter;
+
+        std::atomic<uint64> mImageCount{ 0 };
+        std::atomic<uint64> mEncodedBytes{ 0 };
+        std::atomic<uint64> mDecodedBytes{ 0 };
+        std::atomic<uint64> mDecodeTime{ 0 };
+        std::atomic<uint64> mMipTime{ 0 };
+    };
+}
\ No newline at end of file
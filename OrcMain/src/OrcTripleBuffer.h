@@ -0,0 +1,52 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+
+namespace Orc
+{
+    // Lock-free single producer, single consumer handoff of the latest value. The producer fills the
+    // write buffer and publishes it; the consumer acquires the latest published buffer. Buffers are
+    // recycled, so the producer must overwrite every field and can keep container capacity.
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer() = default;
+        ~TripleBuffer() = default;
+
+        T& getWriteBuffer() { return mBuffers[mWriteIndex]; }
+        // Returns true if the previously published buffer was never acquired and is dropped.
+        bool publish()
+        {
+            auto previous = mMiddle.exchange(mWriteIndex | FRESH_BIT, std::memory_order_acq_rel);
+            mWriteIndex = previous & INDEX_MASK;
+            return (previous & FRESH_BIT) != 0;
+        }
+
+        // Returns false if nothing was published since the last acquire.
+        bool acquire()
+        {
+            if (!hasPending())
+                return false;
+            auto previous = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel);
+            mReadIndex = previous & INDEX_MASK;
+            return true;
+        }
+        const T& getReadBuffer() const { return mBuffers[mReadIndex]; }
+
+        bool hasPending() const { return (mMiddle.load(std::memory_order_acquire) & FRESH_BIT) != 0; }
+
+        ORC_DISABLE_COPY_AND_MOVE(TripleBuffer)
+    private:
+        static constexpr uint32 INDEX_MASK = 3;
+        static constexpr uint32 FRESH_BIT = 4;
+
+        T mBuffers[3];
+        uint32 mWriteIndex = 0;
+        alignas(64) std::atomic<uint32> mMiddle{ 1 };
+        alignas(64) uint32 mReadIndex = 2;
+    };
+}
\ No newline at end of file
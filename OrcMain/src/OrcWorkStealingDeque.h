@@ -0,0 +1,87 @@
+#pragma once
+
+#include "OrcDefines.h"
+#include "OrcTypes.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Orc
+{
+    // Chase-Lev deque with a fixed power of two capacity, after Le et al., "Correct and Efficient
+    // Work-Stealing for Weak Memory Models", with the standalone fences folded into the neighbouring
+    // operations so thread sanitizers can follow them. The owner thread pushes and pops at the bottom
+    // in LIFO order; any other thread steals the oldest item from the top. T must be trivially
+    // copyable, in practice a pointer.
+    template <typename T>
+    class WorkStealingDeque
+    {
+    public:
+        WorkStealingDeque(uint32 capacity) : mBuffer(std::make_unique<std::atomic<T>[]>(capacity)), mMask(capacity - 1)
+        {
+        }
+        ~WorkStealingDeque() = default;
+
+        // Owner only. Returns false if the deque is full.
+        bool push(T item)
+        {
+            auto bottom = mBottom.load(std::memory_order_relaxed);
+            auto top = mTop.load(std::memory_order_acquire);
+            if (bottom - top > static_cast<int64>(mMask))
+                return false;
+            mBuffer[bottom & mMask].store(item, std::memory_order_relaxed);
+            mBottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Owner only. Returns false if the deque is empty or a thief took the last item.
+        bool pop(T& item)
+        {
+            auto bottom = mBottom.load(std::memory_order_relaxed) - 1;
+            // Publishing the claim before reading top must not be reordered, or a thief could take the same item.
+            mBottom.store(bottom, std::memory_order_seq_cst);
+            auto top = mTop.load(std::memory_order_seq_cst);
+            if (top > bottom)
+            {
+                mBottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            item = mBuffer[bottom & mMask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last item: race thieves for it through top.
+                bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                mBottom.store(bottom + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        // Any thread. Returns false if the deque is empty or another thread won the race for the item.
+        bool steal(T& item)
+        {
+            auto top = mTop.load(std::memory_order_seq_cst);
+            auto bottom = mBottom.load(std::memory_order_seq_cst);
+            if (top >= bottom)
+                return false;
+
+            item = mBuffer[top & mMask].load(std::memory_order_relaxed);
+            return mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        }
+
+        // Approximate unless called by the owner.
+        uint32 size() const
+        {
+            auto size = mBottom.load(std::memory_order_relaxed) - mTop.load(std::memory_order_relaxed);
+            return size > 0 ? static_cast<uint32>(size) : 0;
+        }
+
+        ORC_DISABLE_COPY_AND_MOVE(WorkStealingDeque)
+    private:
+        std::unique_ptr<std::atomic<T>[]> mBuffer;
+        int64 mMask;
+        alignas(64) std::atomic<int64> mTop{ 0 };
+        alignas(64) std::atomic<int64> mBottom{ 0 };
+    };
+}
\ No newline at end of file
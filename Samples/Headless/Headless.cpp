@@ -0,0 +1,71 @@
+#include "OrcApplicationContext.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    try
+    {
+        Orc::GraphicsSettings settings;
+        settings.backend = Orc::GraphicsBackendType::GBT_NULL;
+        Orc::ApplicationContext ctx(L"OrcHeadless", 800, 600, settings);
+        auto root = ctx.getRoot();
+
+        constexpr Orc::uint32 frameCount = 100000;
+        auto start = std::chrono::steady_clock::now();
+        for (Orc::uint32 i = 0; i < frameCount; ++i)
+            root->renderOneFrame();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << frameCount << " frames in " << elapsed.count() << " s, "
+            << frameCount / elapsed.count() << " frames/s, "
+            << elapsed.count() * 1e6 / frameCount << " us/frame" << std::endl;
+
+        // On demand, the loop only renders when another thread changes the scene.
+        constexpr Orc::uint32 changeCount = 10;
+        auto sceneManager = root->createSceneManager("Scene");
+        root->setRenderMode(Orc::RenderMode::RM_ON_DEMAND);
+        auto renderedBefore = root->getRenderedFrameCount();
+        std::thread producer([&]()
+        {
+            for (Orc::uint32 i = 0; i < changeCount; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                sceneManager->invalidate();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            root->queueEndRendering();
+        });
+        start = std::chrono::steady_clock::now();
+        root->startRendering();
+        elapsed = std::chrono::steady_clock::now() - start;
+        producer.join();
+
+        std::cout << "on demand: " << root->getRenderedFrameCount() - renderedBefore << " frames for "
+            << changeCount << " scene changes in " << elapsed.count() << " s" << std::endl;
+
+        // With a render thread, the frame started callback simulates the next frame while the previous one is submitted.
+        root->setRenderMode(Orc::RenderMode::RM_CONTINUOUS);
+        root->setRenderThreadEnabled(true);
+        Orc::uint32 simulatedFrames = 0;
+        root->setFrameStartedCallback([&](Orc::uint64)
+        {
+            if (++simulatedFrames == frameCount)
+                root->queueEndRendering();
+        });
+        root->startRendering();
+        auto stats = root->getRenderThreadStats();
+        std::cout << "render thread: " << stats.renderedFrameCount << " frames in "
+            << std::chrono::duration<double>(stats.wallTime).count() << " s, " << stats.overlappedFrameCount
+            << " simulated while the previous frame was rendering" << std::endl;
+        root->setFrameStartedCallback(nullptr);
+        root->setRenderThreadEnabled(false);
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+
+    return 0;
+}
\ No newline at end of file
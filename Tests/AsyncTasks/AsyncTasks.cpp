@@ -0,0 +1,143 @@
+#include "OrcAsyncScheduler.h"
+#include "OrcEmulatedQueue.h"
+#include "OrcJobSystem.h"
+#include "OrcTask.h"
+#include "OrcTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    Orc::Task<Orc::uint64> uploadAsync(Orc::AsyncScheduler& scheduler, Orc::EmulatedQueue& copyQueue, std::vector<Orc::uint8> data)
+    {
+        // Stands in for recording a copy and submitting it.
+        auto fenceValue = copyQueue.signal();
+        co_await scheduler.waitForFence(copyQueue, fenceValue);
+        ORC_CHECK(copyQueue.isComplete(fenceValue));
+        co_return data.size();
+    }
+
+    Orc::Task<void> loadAsync(Orc::AsyncScheduler& scheduler, Orc::EmulatedQueue& copyQueue, std::string path, Orc::uint8 fill, Orc::uint32& finishedCount)
+    {
+        auto data = co_await scheduler.readFile(std::move(path));
+        ORC_CHECK(std::all_of(data.begin(), data.end(), [fill](Orc::uint8 byte) { return byte == fill; }));
+        auto size = data.size();
+        auto uploaded = co_await uploadAsync(scheduler, copyQueue, std::move(data));
+        ORC_CHECK(uploaded == size);
+        ++finishedCount;
+    }
+
+    Orc::Task<void> yieldLoop(Orc::AsyncScheduler& scheduler, Orc::uint32 count, Orc::uint32& resumedCount)
+    {
+        for (Orc::uint32 i = 0; i < count; ++i)
+        {
+            co_await scheduler.yield();
+            ++resumedCount;
+        }
+    }
+
+    Orc::Task<void> slowLoad(Orc::AsyncScheduler& scheduler, Orc::EmulatedQueue& copyQueue, bool& finished)
+    {
+        co_await scheduler.runJob([]() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+        co_await scheduler.waitForFence(copyQueue, copyQueue.getLastSignaledValue());
+        finished = true;
+    }
+
+    // Waiting between polls blocks until a job finishes or a fence completes, rather than spinning.
+    void checkWait()
+    {
+        Orc::JobSystem jobSystem(2);
+        Orc::EmulatedQueue copyQueue(Orc::CommandListType::CLT_COPY, false);
+        copyQueue.signal();
+        std::thread gpu([&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(40));
+            copyQueue.process();
+        });
+
+        Orc::AsyncScheduler scheduler(&jobSystem);
+        bool finished = false;
+        scheduler.spawn(slowLoad(scheduler, copyQueue, finished));
+        Orc::uint32 pollCount = 0;
+        while (!finished && pollCount < 100)
+        {
+            ++pollCount;
+            if (!scheduler.poll())
+                scheduler.wait();
+        }
+        gpu.join();
+        ORC_CHECK(finished);
+        ORC_CHECK(pollCount <= 6);
+    }
+}
+
+// Coroutines read a file, submit an upload and wait for its fence against a copy queue timeline that
+// retires one submission per frame. No coroutine may resume before its fence completes, so at no frame can
+// more loads have finished than submissions retired, and every load has to finish.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 fileCount = 16;
+        constexpr Orc::uint32 fileSize = 4096;
+        constexpr Orc::uint32 maxFrameCount = 1000000;
+
+        auto directory = std::filesystem::temp_directory_path() / "OrcAsyncTasksTest";
+        std::filesystem::create_directories(directory);
+        std::vector<std::string> paths;
+        for (Orc::uint32 i = 0; i < fileCount; ++i)
+        {
+            paths.push_back((directory / ("file" + std::to_string(i) + ".bin")).string());
+            std::ofstream(paths.back(), std::ios::binary) << std::string(fileSize, static_cast<char>(i));
+        }
+
+        Orc::JobSystem jobSystem(0);
+        Orc::EmulatedQueue copyQueue(Orc::CommandListType::CLT_COPY, false);
+        Orc::uint32 finishedCount = 0;
+        {
+            Orc::AsyncScheduler scheduler(&jobSystem);
+            for (Orc::uint32 i = 0; i < fileCount; ++i)
+                scheduler.spawn(loadAsync(scheduler, copyQueue, paths[i], static_cast<Orc::uint8>(i), finishedCount));
+
+            Orc::uint32 frameCount = 0;
+            while (scheduler.getPendingTaskCount() > 0 && frameCount < maxFrameCount)
+            {
+                ++frameCount;
+                copyQueue.retireNext();
+                if (!scheduler.poll())
+                    std::this_thread::yield();
+                ORC_CHECK(finishedCount <= copyQueue.getCompletedValue());
+            }
+            ORC_CHECK(finishedCount == fileCount);
+            ORC_CHECK(frameCount >= fileCount);
+            ORC_CHECK(scheduler.getStats().bytesRead == Orc::uint64(fileCount) * fileSize);
+
+            // A yield resumes in the next poll and no sooner.
+            Orc::uint32 resumedCount = 0;
+            scheduler.spawn(yieldLoop(scheduler, 3, resumedCount));
+            for (Orc::uint32 i = 1; i <= 3; ++i)
+            {
+                ORC_CHECK(scheduler.poll() == 1);
+                ORC_CHECK(resumedCount == i);
+            }
+            ORC_CHECK(scheduler.getPendingTaskCount() == 0);
+        }
+        checkWait();
+
+        std::filesystem::remove_all(directory);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
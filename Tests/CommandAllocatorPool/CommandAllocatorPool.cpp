@@ -0,0 +1,110 @@
+#include "OrcCommandAllocatorPool.h"
+#include "OrcEmulatedQueue.h"
+#include "OrcTest.h"
+
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    // Allocators are numbered in creation order, so a test can tell which one it got back.
+    struct Allocators
+    {
+        Orc::uint32 nextId = 0;
+        std::vector<Orc::uint32> resets;
+
+        Orc::CommandAllocatorPool<Orc::uint32> makePool()
+        {
+            return Orc::CommandAllocatorPool<Orc::uint32>([this]() { return nextId++; }, [this](Orc::uint32& allocator) { resets.push_back(allocator); });
+        }
+    };
+
+    // An allocator only comes back once the fence of its submission completes, oldest first, and is reset
+    // before it does.
+    void checkReuseAfterFence()
+    {
+        Allocators allocators;
+        auto pool = allocators.makePool();
+        Orc::EmulatedQueue queue(Orc::CommandListType::CLT_GRAPHICS, false);
+
+        auto first = pool.acquire(queue.getCompletedValue());
+        pool.release(first, queue.signal());
+        auto second = pool.acquire(queue.getCompletedValue());
+        ORC_CHECK(second != first);
+        pool.release(second, queue.signal());
+
+        queue.retireNext();
+        ORC_CHECK(pool.acquire(queue.getCompletedValue()) == first);
+        ORC_CHECK(allocators.resets == std::vector<Orc::uint32>{ first });
+        // The second allocator's fence has not completed, so a third is created.
+        auto third = pool.acquire(queue.getCompletedValue());
+        ORC_CHECK(third != first && third != second);
+
+        queue.process();
+        ORC_CHECK(pool.acquire(queue.getCompletedValue()) == second);
+        ORC_CHECK(allocators.resets == (std::vector<Orc::uint32>{ first, second }));
+
+        const auto& stats = pool.getStats();
+        ORC_CHECK(stats.acquireCount == 5);
+        ORC_CHECK(stats.createdCount == 3);
+        ORC_CHECK(stats.reusedCount == 2);
+        ORC_CHECK(stats.liveCount == 3);
+        ORC_CHECK(stats.idleCount == 0);
+    }
+
+    // After a burst, trim brings the idle allocators down to what framesInFlight frames acquire at the
+    // current rate, without ever destroying one whose fence is pending.
+    void checkTrim()
+    {
+        constexpr Orc::uint32 burstSize = 10;
+        constexpr Orc::uint32 framesInFlight = 2;
+        Allocators allocators;
+        auto pool = allocators.makePool();
+        Orc::EmulatedQueue queue(Orc::CommandListType::CLT_GRAPHICS, false);
+
+        std::vector<Orc::uint32> burst;
+        for (Orc::uint32 i = 0; i < burstSize; ++i)
+            burst.push_back(pool.acquire(queue.getCompletedValue()));
+        for (auto allocator : burst)
+            pool.release(allocator, queue.signal());
+        ORC_CHECK(pool.getStats().peakLiveCount == burstSize);
+
+        // Nothing has completed, so even a frame without acquires destroys nothing.
+        pool.trim(queue.getCompletedValue(), framesInFlight);
+        ORC_CHECK(pool.trim(queue.getCompletedValue(), framesInFlight) == 0);
+        ORC_CHECK(pool.getStats().idleCount == burstSize);
+
+        // Half the burst completes: only completed allocators may go.
+        for (Orc::uint32 i = 0; i < burstSize / 2; ++i)
+            queue.retireNext();
+        ORC_CHECK(pool.trim(queue.getCompletedValue(), framesInFlight) == burstSize / 2);
+        ORC_CHECK(pool.getStats().idleCount == burstSize / 2);
+
+        // Once everything completes, a frame acquiring one allocator keeps framesInFlight of them idle.
+        queue.process();
+        auto allocator = pool.acquire(queue.getCompletedValue());
+        pool.release(allocator, queue.signal());
+        queue.process();
+        ORC_CHECK(pool.trim(queue.getCompletedValue(), framesInFlight) == burstSize / 2 - framesInFlight);
+        ORC_CHECK(pool.getStats().idleCount == framesInFlight);
+        ORC_CHECK(pool.getStats().liveCount == framesInFlight);
+        ORC_CHECK(pool.getStats().destroyedCount == burstSize - framesInFlight);
+        ORC_CHECK(pool.getStats().createdCount == burstSize);
+    }
+}
+
+int main()
+{
+    try
+    {
+        checkReuseAfterFence();
+        checkTrim();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "OrcEmulatedQueue.h"
+#include "OrcException.h"
+#include "OrcTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+    // Signals take consecutive values and complete strictly in order, one per retireNext.
+    void checkSignalOrder()
+    {
+        Orc::EmulatedQueue queue(Orc::CommandListType::CLT_GRAPHICS, false);
+        ORC_CHECK(queue.signal() == 1);
+        ORC_CHECK(queue.signal() == 2);
+        ORC_CHECK(queue.signal() == 3);
+        ORC_CHECK(queue.getLastSignaledValue() == 3);
+        ORC_CHECK(queue.getCompletedValue() == 0);
+        ORC_CHECK(!queue.isComplete(1));
+
+        ORC_CHECK(queue.retireNext());
+        ORC_CHECK(queue.isComplete(1));
+        ORC_CHECK(!queue.isComplete(2));
+        ORC_CHECK(queue.process() == 3);
+        ORC_CHECK(queue.isComplete(3));
+        ORC_CHECK(!queue.retireNext());
+
+        Orc::EmulatedQueue autoQueue(Orc::CommandListType::CLT_COPY);
+        auto value = autoQueue.signal();
+        ORC_CHECK(autoQueue.isComplete(value));
+        autoQueue.waitFor(value);
+        ORC_CHECK(autoQueue.getWaitStats().waitCount == 1);
+        ORC_CHECK(autoQueue.getWaitStats().blockedCount == 0);
+    }
+
+    // A signal queued after a GPU wait completes only once the other queue reaches the awaited value.
+    void checkGpuWait()
+    {
+        Orc::EmulatedQueue copyQueue(Orc::CommandListType::CLT_COPY, false);
+        Orc::EmulatedQueue graphicsQueue(Orc::CommandListType::CLT_GRAPHICS, false);
+        auto copyValue = copyQueue.signal();
+        auto beforeWait = graphicsQueue.signal();
+        graphicsQueue.gpuWait(copyQueue, copyValue);
+        auto afterWait = graphicsQueue.signal();
+
+        ORC_CHECK(graphicsQueue.process() == beforeWait);
+        ORC_CHECK(!graphicsQueue.isComplete(afterWait));
+        copyQueue.process();
+        ORC_CHECK(graphicsQueue.process() == afterWait);
+
+        // With auto-complete, waiting behind a GPU wait nothing will satisfy fails instead of hanging.
+        Orc::EmulatedQueue blockedQueue(Orc::CommandListType::CLT_COMPUTE);
+        Orc::EmulatedQueue neverQueue(Orc::CommandListType::CLT_COPY, false);
+        blockedQueue.gpuWait(neverQueue, neverQueue.signal());
+        auto blockedValue = blockedQueue.signal();
+        bool threw = false;
+        try
+        {
+            blockedQueue.waitFor(blockedValue);
+        }
+        catch (const Orc::OrcException&)
+        {
+            threw = true;
+        }
+        ORC_CHECK(threw);
+    }
+
+    // waitFor returns only once its value completes, whichever way the thread waits.
+    void checkWaitFor(Orc::WaitStrategy strategy)
+    {
+        Orc::EmulatedQueue queue(Orc::CommandListType::CLT_GRAPHICS, false);
+        queue.setWaitStrategy(strategy, std::chrono::microseconds(50));
+        queue.signal();
+        auto value = queue.signal();
+
+        std::atomic<bool> returned{ false };
+        std::atomic<bool> completeOnReturn{ false };
+        std::thread waiter([&]()
+        {
+            queue.waitFor(value);
+            completeOnReturn = queue.isComplete(value);
+            returned = true;
+        });
+        queue.retireNext();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ORC_CHECK(!returned);
+        queue.retireNext();
+        waiter.join();
+        ORC_CHECK(returned);
+        ORC_CHECK(completeOnReturn);
+
+        auto stats = queue.getWaitStats();
+        ORC_CHECK(stats.waitCount == 1);
+        ORC_CHECK(stats.blockedCount + stats.spinResolvedCount == 1);
+
+        // Yielding never reaches the emulated fence, so only a blocking wait can tell the value is not signaled.
+        if (strategy == Orc::WaitStrategy::WS_YIELD)
+            return;
+        bool threw = false;
+        try
+        {
+            queue.waitFor(queue.getLastSignaledValue() + 1);
+        }
+        catch (const Orc::OrcException&)
+        {
+            threw = true;
+        }
+        ORC_CHECK(threw);
+    }
+
+    // Several threads blocked on the same queue each return once their own value completes, and none
+    // misses the completion another one was woken for.
+    void checkConcurrentWaiters(Orc::WaitStrategy strategy)
+    {
+        Orc::EmulatedQueue queue(Orc::CommandListType::CLT_GRAPHICS, false);
+        queue.setWaitStrategy(strategy, std::chrono::microseconds(50));
+        auto firstValue = queue.signal();
+        auto secondValue = queue.signal();
+
+        std::atomic<Orc::uint32> firstReturned{ 0 };
+        std::atomic<Orc::uint32> secondReturned{ 0 };
+        std::thread waiters[4];
+        for (Orc::uint32 i = 0; i < 4; ++i)
+        {
+            waiters[i] = std::thread([&, i]()
+            {
+                if (i % 2)
+                {
+                    queue.waitFor(secondValue);
+                    ++secondReturned;
+                }
+                else
+                {
+                    queue.waitFor(firstValue);
+                    ++firstReturned;
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.retireNext();
+        while (firstReturned < 2)
+            std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ORC_CHECK(secondReturned == 0);
+        queue.retireNext();
+        for (auto& waiter : waiters)
+            waiter.join();
+        ORC_CHECK(secondReturned == 2);
+        ORC_CHECK(queue.getWaitStats().waitCount == 4);
+    }
+}
+
+int main()
+{
+    try
+    {
+        checkSignalOrder();
+        checkGpuWait();
+        checkWaitFor(Orc::WaitStrategy::WS_BLOCK);
+        checkWaitFor(Orc::WaitStrategy::WS_SPIN_THEN_BLOCK);
+        checkWaitFor(Orc::WaitStrategy::WS_YIELD);
+        checkConcurrentWaiters(Orc::WaitStrategy::WS_BLOCK);
+        checkConcurrentWaiters(Orc::WaitStrategy::WS_SPIN_THEN_BLOCK);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
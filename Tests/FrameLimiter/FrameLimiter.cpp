@@ -0,0 +1,90 @@
+#include "OrcException.h"
+#include "OrcFrameLimiter.h"
+#include "OrcTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace
+{
+    using Clock = Orc::FrameLimiter::Clock;
+
+    void busyWait(std::chrono::microseconds duration)
+    {
+        auto end = Clock::now() + duration;
+        while (Clock::now() < end);
+    }
+
+    // Frames never leave faster than the cap: the k-th frame after the first is released no sooner than k
+    // intervals after it. They also keep close to it on average, within bounds loose enough for a loaded
+    // machine, which can hold the thread past its deadline for a whole scheduler time slice.
+    void checkRate(double frameRate, Orc::uint32 frameCount)
+    {
+        Orc::FrameLimiter limiter(frameRate);
+        // Rounded down like the limiter's, so whole intervals compare exactly.
+        auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / frameRate));
+        // Read before the first frame starts the cadence, so it is no later than the limiter's reference.
+        auto start = Clock::now();
+        limiter.wait();
+        for (Orc::uint32 i = 1; i <= frameCount; ++i)
+        {
+            busyWait(std::chrono::duration_cast<std::chrono::microseconds>(interval * 3 / 10));
+            limiter.wait();
+            ORC_CHECK(Clock::now() - start >= interval * i);
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        ORC_CHECK(elapsed < interval * frameCount * 3 / 2);
+        ORC_CHECK(limiter.getFrameCount() == frameCount + 1);
+        ORC_CHECK(limiter.getLateness() / frameCount < std::max<std::chrono::nanoseconds>(interval / 2, std::chrono::milliseconds(5)));
+    }
+
+    // A frame more than an interval late restarts the cadence instead of letting the following frames
+    // through back to back to catch up.
+    void checkStallRestartsCadence()
+    {
+        constexpr Orc::uint32 frameCount = 5;
+        Orc::FrameLimiter limiter(100.0);
+        limiter.wait();
+        busyWait(std::chrono::milliseconds(35));
+        auto restart = Clock::now();
+        limiter.wait();
+        for (Orc::uint32 i = 0; i < frameCount; ++i)
+            limiter.wait();
+        ORC_CHECK(Clock::now() - restart >= std::chrono::milliseconds(10) * frameCount);
+    }
+
+    void checkInvalidRate()
+    {
+        Orc::FrameLimiter limiter;
+        bool threw = false;
+        try
+        {
+            limiter.setFrameRate(0.0);
+        }
+        catch (const Orc::OrcException&)
+        {
+            threw = true;
+        }
+        ORC_CHECK(threw);
+        ORC_CHECK(limiter.getFrameRate() > 59.9 && limiter.getFrameRate() < 60.1);
+    }
+}
+
+int main()
+{
+    try
+    {
+        checkRate(60.0, 20);
+        checkRate(250.0, 50);
+        checkStallRestartsCadence();
+        checkInvalidRate();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
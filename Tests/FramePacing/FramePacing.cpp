@@ -0,0 +1,89 @@
+#include "OrcFramePacer.h"
+#include "OrcPresentClock.h"
+#include "OrcTest.h"
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <random>
+
+namespace
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    struct PacingResult
+    {
+        // Average time from the start of a frame's CPU work to its flip.
+        Milliseconds latency{};
+        Orc::uint64 flippedCount = 0;
+        Orc::uint64 missedVblankCount = 0;
+    };
+
+    PacingResult pace(Orc::FramePacingMode mode, Orc::uint32 maxFrameLatency, std::chrono::microseconds frameCost, Orc::uint32 frameCount)
+    {
+        Orc::SimulatedPresentClock clock(std::chrono::microseconds(16667), mode == Orc::FramePacingMode::FPM_FENCE ? 3 : maxFrameLatency);
+        Orc::FramePacer pacer(&clock, mode, std::chrono::microseconds(1000));
+        std::mt19937 random(42);
+        std::uniform_int_distribution<std::int64_t> jitter(-500, 500);
+        for (Orc::uint32 i = 0; i < frameCount; ++i)
+        {
+            pacer.beginFrame();
+            clock.advance(frameCost + std::chrono::microseconds(jitter(random)));
+            pacer.endFrame();
+        }
+
+        PacingResult result;
+        result.flippedCount = clock.getFlippedFrameCount();
+        result.missedVblankCount = clock.getMissedVblankCount();
+        if (result.flippedCount)
+            result.latency = Milliseconds(clock.getTotalLatency()) / double(result.flippedCount);
+        return result;
+    }
+}
+
+// Paces frames with a jittery CPU cost well under the refresh interval of a simulated 60 Hz display. No
+// mode may miss a vblank. Queueing up to three frames behind a fence puts four refreshes between input and
+// flip, the latency waitable one refresh per frame of latency, and just-in-time pacing little more than the
+// frame's own cost.
+int main()
+{
+    try
+    {
+        constexpr Orc::uint32 frameCount = 2000;
+        constexpr double refresh = 16.667;
+        // Allowance for the jitter, the just-in-time margin and the pacer's estimates.
+        constexpr double slack = 2.0;
+
+        for (auto frameCost : { std::chrono::microseconds(3000), std::chrono::microseconds(8000), std::chrono::microseconds(14000) })
+        {
+            double cost = Milliseconds(frameCost).count();
+
+            auto fence = pace(Orc::FramePacingMode::FPM_FENCE, 1, frameCost, frameCount);
+            ORC_CHECK(fence.missedVblankCount == 0);
+            ORC_CHECK(fence.flippedCount + 3 >= frameCount);
+            ORC_CHECK(fence.latency.count() > 3.5 * refresh && fence.latency.count() < 4.0 * refresh + slack);
+
+            for (Orc::uint32 maxFrameLatency : { 1u, 2u })
+            {
+                auto waitable = pace(Orc::FramePacingMode::FPM_LATENCY_WAITABLE, maxFrameLatency, frameCost, frameCount);
+                ORC_CHECK(waitable.missedVblankCount == 0);
+                ORC_CHECK(waitable.flippedCount + maxFrameLatency >= frameCount);
+                ORC_CHECK(waitable.latency.count() > maxFrameLatency * refresh - slack && waitable.latency.count() < maxFrameLatency * refresh + slack);
+
+                auto justInTime = pace(Orc::FramePacingMode::FPM_JUST_IN_TIME, maxFrameLatency, frameCost, frameCount);
+                ORC_CHECK(justInTime.missedVblankCount == 0);
+                ORC_CHECK(justInTime.flippedCount + maxFrameLatency >= frameCount);
+                ORC_CHECK(justInTime.latency.count() >= cost - slack);
+                ORC_CHECK(justInTime.latency.count() < waitable.latency.count());
+                if (maxFrameLatency == 1)
+                    ORC_CHECK(justInTime.latency.count() < cost + slack);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
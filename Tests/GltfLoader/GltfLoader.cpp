@@ -0,0 +1,100 @@
+#include "OrcGltfLoader.h"
+#include "OrcTest.h"
+
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    std::string encodeBase64(const Orc::uint8* data, size_t size)
+    {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string encoded;
+        for (size_t i = 0; i < size; i += 3)
+        {
+            Orc::uint32 bits = data[i] << 16;
+            if (i + 1 < size)
+                bits |= data[i + 1] << 8;
+            if (i + 2 < size)
+                bits |= data[i + 2];
+            encoded += alphabet[bits >> 18 & 63];
+            encoded += alphabet[bits >> 12 & 63];
+            encoded += i + 1 < size ? alphabet[bits >> 6 & 63] : '=';
+            encoded += i + 2 < size ? alphabet[bits & 63] : '=';
+        }
+        return encoded;
+    }
+
+    // One triangle in the YZ plane, counter-clockwise seen from +X, with every vertex normal +X, placed by a
+    // single node with the given transform properties.
+    Orc::MeshData decodeTriangle(const std::string& nodeTransform)
+    {
+        const float attributes[18] = {
+            0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+            1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+        };
+        Orc::uint8 bytes[sizeof(attributes)];
+        std::memcpy(bytes, attributes, sizeof(attributes));
+        std::string json = R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0)" +
+            (nodeTransform.empty() ? std::string() : "," + nodeTransform) +
+            R"(}],"meshes":[{"primitives":[{"attributes":{"POSITION":0,"NORMAL":1}}]}],)"
+            R"("accessors":[{"bufferView":0,"componentType":5126,"count":3,"type":"VEC3"},{"bufferView":0,"byteOffset":36,"componentType":5126,"count":3,"type":"VEC3"}],)"
+            R"("bufferViews":[{"buffer":0,"byteLength":72}],)"
+            R"("buffers":[{"byteLength":72,"uri":"data:application/octet-stream;base64,)" + encodeBase64(bytes, sizeof(bytes)) + R"("}]})";
+        Orc::GltfAsset asset(reinterpret_cast<const Orc::uint8*>(json.data()), json.size(), "");
+        return asset.decode();
+    }
+
+    bool isNear(const float* a, const float (&b)[3])
+    {
+        return std::abs(a[0] - b[0]) < 1e-5f && std::abs(a[1] - b[1]) < 1e-5f && std::abs(a[2] - b[2]) < 1e-5f;
+    }
+
+    // Every decoded normal is expected, and points the way the decoded winding faces.
+    void checkNormals(const std::string& nodeTransform, const float (&expected)[3])
+    {
+        auto mesh = decodeTriangle(nodeTransform);
+        if (!ORC_CHECK(mesh.vertices.size() == 3 && mesh.indices.size() == 3))
+            return;
+        const float* p0 = mesh.vertices[mesh.indices[0]].position;
+        const float* p1 = mesh.vertices[mesh.indices[1]].position;
+        const float* p2 = mesh.vertices[mesh.indices[2]].position;
+        float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        float face[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        float length = std::sqrt(face[0] * face[0] + face[1] * face[1] + face[2] * face[2]);
+        for (auto& c : face)
+            c /= length;
+        ORC_CHECK(isNear(face, expected));
+        for (const auto& vertex : mesh.vertices)
+            ORC_CHECK(isNear(vertex.normal, expected));
+    }
+}
+
+// Decodes a triangle under rotated, mirrored and sheared nodes. Normals transform by the inverse transpose
+// of the node's matrix and keep facing out of the triangle as wound after decoding.
+int main()
+{
+    try
+    {
+        checkNormals("", { 1.0f, 0.0f, 0.0f });
+        // 90 degrees about Z takes +X to +Y.
+        checkNormals(R"("rotation":[0,0,0.70710678,0.70710678])", { 0.0f, 1.0f, 0.0f });
+        // Mirrored along X and stretched along Y, which flips the winding.
+        checkNormals(R"("scale":[-1,2,1])", { -1.0f, 0.0f, 0.0f });
+        // x += y, whose inverse transpose takes +X to (1, -1, 0).
+        checkNormals(R"("matrix":[1,0,0,0,1,1,0,0,0,0,1,0,0,0,0,1])", { 0.70710678f, -0.70710678f, 0.0f });
+
+        auto rotated = decodeTriangle(R"("rotation":[0,0,0.70710678,0.70710678])");
+        ORC_CHECK(isNear(rotated.vertices[1].position, { -1.0f, 0.0f, 0.0f }));
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "OrcMeshOptimizer.h"
+#include "OrcTest.h"
+#include "OrcTestMeshes.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace
+{
+    using VertexKey = std::array<float, 8>;
+    using Triangle = std::array<VertexKey, 3>;
+
+    // A triangle by the vertices its corners refer to, rotated to start at the smallest so renumbering and
+    // reordering compare equal while a flipped winding does not.
+    Triangle getTriangle(const Orc::MeshData& mesh, Orc::uint32 firstIndex)
+    {
+        Triangle triangle;
+        for (Orc::uint32 corner = 0; corner < 3; ++corner)
+            std::memcpy(triangle[corner].data(), &mesh.vertices[mesh.indices[firstIndex + corner]], sizeof(VertexKey));
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        return triangle;
+    }
+
+    std::vector<Triangle> getTriangles(const Orc::MeshData& mesh, const Orc::Submesh& submesh)
+    {
+        std::vector<Triangle> triangles;
+        for (Orc::uint32 index = 0; index < submesh.indexCount; index += 3)
+            triangles.push_back(getTriangle(mesh, submesh.indexOffset + index));
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // Each submesh of the mesh and of each level of detail, in order.
+    std::vector<Orc::Submesh> getRanges(const Orc::MeshData& mesh)
+    {
+        std::vector<Orc::Submesh> ranges = mesh.submeshes;
+        for (const auto& lod : mesh.lods)
+            ranges.insert(ranges.end(), lod.submeshes.begin(), lod.submeshes.end());
+        return ranges;
+    }
+
+    // Appends a level of detail keeping every fourth triangle of each submesh, behind the mesh's indices.
+    void addLod(Orc::MeshData& mesh)
+    {
+        Orc::MeshLod lod;
+        for (const auto& submesh : mesh.submeshes)
+        {
+            auto indexOffset = static_cast<Orc::uint32>(mesh.indices.size());
+            for (Orc::uint32 index = 0; index < submesh.indexCount; index += 12)
+            {
+                for (Orc::uint32 corner = 0; corner < 3; ++corner)
+                    mesh.indices.push_back(mesh.indices[submesh.indexOffset + index + corner]);
+            }
+            lod.submeshes.push_back({ indexOffset, static_cast<Orc::uint32>(mesh.indices.size()) - indexOffset, submesh.materialIndex });
+        }
+        mesh.lods.push_back(lod);
+    }
+
+    // Reordering keeps every submesh's triangles, windings included, within its own range, and leaves the
+    // ranges where they were. Renumbering leaves no index past the vertices and no vertex unreferenced.
+    void checkOptimized(Orc::MeshData mesh, const Orc::MeshOptimizationSettings& settings)
+    {
+        auto ranges = getRanges(mesh);
+        std::vector<std::vector<Triangle>> before;
+        for (const auto& range : ranges)
+            before.push_back(getTriangles(mesh, range));
+        auto indexCount = mesh.indices.size();
+
+        auto stats = Orc::optimizeMesh(mesh, settings);
+        if (!ORC_CHECK(mesh.indices.size() == indexCount) || !ORC_CHECK(getRanges(mesh).size() == ranges.size()))
+            return;
+        auto after = getRanges(mesh);
+        for (size_t i = 0; i < ranges.size(); ++i)
+        {
+            ORC_CHECK(after[i].indexOffset == ranges[i].indexOffset && after[i].indexCount == ranges[i].indexCount);
+            ORC_CHECK(getTriangles(mesh, after[i]) == before[i]);
+        }
+
+        std::set<Orc::uint32> referenced(mesh.indices.begin(), mesh.indices.end());
+        ORC_CHECK(*referenced.rbegin() < mesh.vertices.size());
+        if (settings.vertexFetch)
+            ORC_CHECK(referenced.size() == mesh.vertices.size());
+        if (settings.vertexCache)
+            ORC_CHECK(stats.cacheAfter.acmr <= stats.cacheBefore.acmr);
+    }
+
+    // On a shuffled grid every pass combination keeps the geometry, and cache ordering brings the ACMR from
+    // close to the 3 of shuffled triangles to under 1.
+    void checkShuffledGrid()
+    {
+        auto mesh = Orc::Test::shuffleMesh(Orc::Test::makeTerrain(48));
+        Orc::MeshOptimizationSettings settings;
+        for (int passes = 0; passes < 4; ++passes)
+        {
+            settings.vertexCache = passes & 1;
+            settings.overdraw = passes & 1;
+            settings.vertexFetch = passes & 2;
+            checkOptimized(mesh, settings);
+        }
+
+        auto stats = Orc::optimizeMesh(mesh, Orc::MeshOptimizationSettings());
+        ORC_CHECK(stats.cacheBefore.acmr > 2.0f);
+        ORC_CHECK(stats.cacheAfter.acmr < 1.0f);
+        ORC_CHECK(stats.fetchAfter.overfetch < stats.fetchBefore.overfetch);
+    }
+
+    // Submeshes and levels of detail are ordered separately, and an unreferenced vertex is dropped.
+    void checkSubmeshesAndLods()
+    {
+        auto mesh = Orc::Test::shuffleMesh(Orc::Test::makeSphere(16, 32, 3));
+        addLod(mesh);
+        mesh.vertices.push_back({ { 2.0f, 2.0f, 2.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f } });
+        checkOptimized(mesh, Orc::MeshOptimizationSettings());
+
+        auto vertexCount = mesh.vertices.size();
+        Orc::optimizeMesh(mesh, Orc::MeshOptimizationSettings());
+        ORC_CHECK(mesh.vertices.size() == vertexCount - 1);
+    }
+}
+
+int main()
+{
+    try
+    {
+        checkShuffledGrid();
+        checkSubmeshesAndLods();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
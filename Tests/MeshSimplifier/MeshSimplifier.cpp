@@ -0,0 +1,83 @@
+#include "OrcMeshSimplifier.h"
+#include "OrcTest.h"
+#include "OrcTestMeshes.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    Orc::uint32 getTriangleCount(const std::vector<Orc::Submesh>& submeshes)
+    {
+        Orc::uint32 indexCount = 0;
+        for (const auto& submesh : submeshes)
+            indexCount += submesh.indexCount;
+        return indexCount / 3;
+    }
+
+    // Levels keep the mesh's own indices and submeshes, and follow them with one range per submesh and
+    // level, back to back and with the submesh's material. Each level has fewer triangles than the one
+    // before, by at least maxTriangleRatio, and an error at least as large.
+    void checkLods(Orc::MeshData mesh, const Orc::LodSettings& settings)
+    {
+        auto original = mesh;
+        Orc::generateLods(mesh, settings);
+        ORC_CHECK(std::equal(original.indices.begin(), original.indices.end(), mesh.indices.begin()));
+        if (!ORC_CHECK(mesh.submeshes.size() == original.submeshes.size()) || !ORC_CHECK(mesh.lods.size() >= 2))
+            return;
+
+        float extent = 0;
+        for (Orc::uint32 axis = 0; axis < 3; ++axis)
+            extent = std::max(extent, mesh.bounds.max[axis] - mesh.bounds.min[axis]);
+        auto indexOffset = static_cast<Orc::uint32>(original.indices.size());
+        auto previousTriangleCount = getTriangleCount(mesh.submeshes);
+        float previousError = 0;
+        for (const auto& lod : mesh.lods)
+        {
+            if (!ORC_CHECK(lod.submeshes.size() == mesh.submeshes.size()))
+                return;
+            for (size_t i = 0; i < lod.submeshes.size(); ++i)
+            {
+                const auto& submesh = lod.submeshes[i];
+                ORC_CHECK(submesh.indexOffset == indexOffset);
+                ORC_CHECK(submesh.indexCount % 3 == 0);
+                ORC_CHECK(submesh.materialIndex == mesh.submeshes[i].materialIndex);
+                indexOffset += submesh.indexCount;
+            }
+            auto triangleCount = getTriangleCount(lod.submeshes);
+            ORC_CHECK(triangleCount > 0);
+            ORC_CHECK(triangleCount <= settings.maxTriangleRatio * previousTriangleCount);
+            ORC_CHECK(lod.error >= previousError);
+            ORC_CHECK(lod.error <= settings.levelErrors.back() * extent);
+            previousTriangleCount = triangleCount;
+            previousError = lod.error;
+        }
+        ORC_CHECK(indexOffset == mesh.indices.size());
+        ORC_CHECK(std::all_of(mesh.indices.begin(), mesh.indices.end(), [&](Orc::uint32 index) { return index < mesh.vertices.size(); }));
+    }
+}
+
+int main()
+{
+    try
+    {
+        checkLods(Orc::Test::makeSphere(32, 64, 3), Orc::LodSettings());
+        checkLods(Orc::Test::makeTerrain(64), Orc::LodSettings());
+
+        // Every level is kept when each may have as many triangles as the one before.
+        Orc::LodSettings settings;
+        settings.maxTriangleRatio = 1.0f;
+        auto mesh = Orc::Test::makeSphere(32, 64, 2);
+        checkLods(mesh, settings);
+        Orc::generateLods(mesh, settings);
+        ORC_CHECK(mesh.lods.size() == settings.levelErrors.size());
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "OrcMeshlet.h"
+#include "OrcTest.h"
+#include "OrcTestMeshes.h"
+
+#include <array>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace
+{
+    using Triangle = std::array<Orc::uint32, 3>;
+
+    constexpr float ORIGIN[3] = { 0.0f, 0.0f, 0.0f };
+
+    Triangle getMeshletTriangle(const Orc::MeshletData& meshlets, const Orc::Meshlet& meshlet, Orc::uint32 triangle)
+    {
+        Triangle corners;
+        for (Orc::uint32 corner = 0; corner < 3; ++corner)
+            corners[corner] = meshlets.vertices[meshlet.vertexOffset + meshlets.triangles[meshlet.triangleOffset + triangle * 3 + corner]];
+        return corners;
+    }
+
+    // Every triangle of each submesh is in exactly one of its meshlets, with its corners in order, and
+    // every meshlet is within the limits.
+    void checkPartition(const Orc::MeshData& mesh, const Orc::MeshletData& meshlets, const Orc::MeshletSettings& settings)
+    {
+        if (!ORC_CHECK(meshlets.submeshOffsets.size() == mesh.submeshes.size() + 1) || !ORC_CHECK(meshlets.bounds.size() == meshlets.meshlets.size()))
+            return;
+        ORC_CHECK(meshlets.submeshOffsets.back() == meshlets.meshlets.size());
+        for (size_t submesh = 0; submesh < mesh.submeshes.size(); ++submesh)
+        {
+            std::map<Triangle, int> remaining;
+            const auto& range = mesh.submeshes[submesh];
+            for (Orc::uint32 i = range.indexOffset; i < range.indexOffset + range.indexCount; i += 3)
+                ++remaining[{ mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2] }];
+
+            for (Orc::uint32 m = meshlets.submeshOffsets[submesh]; m < meshlets.submeshOffsets[submesh + 1]; ++m)
+            {
+                const auto& meshlet = meshlets.meshlets[m];
+                ORC_CHECK(meshlet.vertexCount <= settings.maxVertices);
+                ORC_CHECK(meshlet.triangleCount > 0 && meshlet.triangleCount <= settings.maxTriangles);
+                ORC_CHECK(meshlet.triangleOffset % 4 == 0);
+                for (Orc::uint32 triangle = 0; triangle < meshlet.triangleCount; ++triangle)
+                {
+                    for (Orc::uint32 corner = 0; corner < 3; ++corner)
+                        ORC_CHECK(meshlets.triangles[meshlet.triangleOffset + triangle * 3 + corner] < meshlet.vertexCount);
+                    // A triangle missing here belongs to another submesh or was emitted twice.
+                    auto it = remaining.find(getMeshletTriangle(meshlets, meshlet, triangle));
+                    if (ORC_CHECK(it != remaining.end() && it->second > 0))
+                        --it->second;
+                }
+            }
+            for (const auto& [triangle, count] : remaining)
+                ORC_CHECK(count == 0);
+        }
+    }
+
+    // A meshlet may only be culled by its cone if every triangle in it faces away from the camera.
+    void checkConeCulling(const Orc::MeshData& mesh, const Orc::MeshletData& meshlets)
+    {
+        for (int camera = 0; camera < 64; ++camera)
+        {
+            float t = (camera + 0.5f) / 64;
+            float height = 1.0f - 2.0f * t, ring = std::sqrt(1.0f - height * height);
+            float angle = camera * 2.4f;
+            float distance = camera % 2 ? 4.0f : 1.5f;
+            float eye[3] = { std::cos(angle) * ring * distance, height * distance, std::sin(angle) * ring * distance };
+            for (size_t m = 0; m < meshlets.meshlets.size(); ++m)
+            {
+                if (!Orc::isMeshletBackfacing(meshlets.bounds[m], eye))
+                    continue;
+                const auto& meshlet = meshlets.meshlets[m];
+                for (Orc::uint32 triangle = 0; triangle < meshlet.triangleCount; ++triangle)
+                {
+                    auto corners = getMeshletTriangle(meshlets, meshlet, triangle);
+                    const float* p0 = mesh.vertices[corners[0]].position;
+                    const float* p1 = mesh.vertices[corners[1]].position;
+                    const float* p2 = mesh.vertices[corners[2]].position;
+                    float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                    float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                    float normal[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                    float toEye[3] = { eye[0] - p0[0], eye[1] - p0[1], eye[2] - p0[2] };
+                    ORC_CHECK(normal[0] * toEye[0] + normal[1] * toEye[1] + normal[2] * toEye[2] <= 1e-6f);
+                }
+            }
+
+            float viewProjection[16];
+            Orc::Test::makeViewProjection(eye, ORIGIN, 0.01f, 100.0f, viewProjection);
+            std::vector<Orc::uint32> visible;
+            auto stats = Orc::cullMeshlets(meshlets, Orc::makeFrustum(viewProjection), eye, visible);
+            ORC_CHECK(stats.visibleCount == visible.size());
+            ORC_CHECK(stats.visibleCount + stats.frustumCulledCount + stats.coneCulledCount == meshlets.meshlets.size());
+            // The camera looks at the sphere from outside, so some of it is visible and its far side is not.
+            ORC_CHECK(stats.visibleCount > 0);
+            ORC_CHECK(stats.coneCulledCount > 0);
+        }
+    }
+
+    void checkFrustum()
+    {
+        // With the identity matrix the frustum is the clip space box -1 <= x, y <= 1, 0 <= z <= 1.
+        float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+        auto box = Orc::makeFrustum(identity);
+        ORC_CHECK(Orc::isSphereInFrustum(box, { 0.0f, 0.0f, 0.5f }, 0.1f));
+        ORC_CHECK(!Orc::isSphereInFrustum(box, { 2.0f, 0.0f, 0.5f }, 0.5f));
+        ORC_CHECK(Orc::isSphereInFrustum(box, { 2.0f, 0.0f, 0.5f }, 1.5f));
+        ORC_CHECK(!Orc::isSphereInFrustum(box, { 0.0f, -1.5f, 0.5f }, 0.25f));
+        ORC_CHECK(!Orc::isSphereInFrustum(box, { 0.0f, 0.0f, -0.5f }, 0.4f));
+        ORC_CHECK(!Orc::isSphereInFrustum(box, { 0.0f, 0.0f, 1.3f }, 0.2f));
+        ORC_CHECK(Orc::isSphereInFrustum(box, { 0.0f, 0.0f, 1.3f }, 0.4f));
+
+        // A camera 10 units from the origin sees 5.77 units up and 10.26 units across at its distance.
+        float eye[3] = { 0.0f, 0.0f, -10.0f };
+        float viewProjection[16];
+        Orc::Test::makeViewProjection(eye, ORIGIN, 0.01f, 100.0f, viewProjection);
+        auto frustum = Orc::makeFrustum(viewProjection);
+        ORC_CHECK(Orc::isSphereInFrustum(frustum, { 0.0f, 0.0f, 0.0f }, 1.0f));
+        ORC_CHECK(!Orc::isSphereInFrustum(frustum, { 0.0f, 0.0f, -20.0f }, 1.0f));
+        ORC_CHECK(!Orc::isSphereInFrustum(frustum, { 0.0f, 0.0f, 200.0f }, 1.0f));
+        ORC_CHECK(Orc::isSphereInFrustum(frustum, { 0.0f, 6.0f, 0.0f }, 1.0f));
+        ORC_CHECK(!Orc::isSphereInFrustum(frustum, { 0.0f, 20.0f, 0.0f }, 1.0f));
+        ORC_CHECK(Orc::isSphereInFrustum(frustum, { 11.0f, 0.0f, 0.0f }, 1.0f));
+        ORC_CHECK(!Orc::isSphereInFrustum(frustum, { 12.0f, 0.0f, 0.0f }, 1.0f));
+    }
+}
+
+// Builds meshlets for a sphere of two submeshes with the default limits and tighter ones, checks they
+// partition each submesh's triangles within the limits, that the cone test never culls a meshlet with a
+// triangle facing the camera, and that spheres of known placement are in or out of known frustums.
+int main()
+{
+    try
+    {
+        auto mesh = Orc::Test::makeSphere(24, 48, 2);
+        // Meshlets closed by the vertex limit, then by the triangle limit.
+        Orc::MeshletSettings fewVertices, fewTriangles;
+        fewVertices.maxVertices = 16;
+        fewTriangles.maxTriangles = 12;
+        for (const auto& settings : { Orc::MeshletSettings(), fewVertices, fewTriangles })
+        {
+            auto meshlets = Orc::buildMeshlets(mesh.vertices, mesh.indices, mesh.submeshes, settings);
+            checkPartition(mesh, meshlets, settings);
+            checkConeCulling(mesh, meshlets);
+        }
+        checkFrustum();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return Orc::Test::getExitCode();
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <iostream>
+
+namespace Orc::Test
+{
+    inline int& getFailureCount()
+    {
+        static int failureCount = 0;
+        return failureCount;
+    }
+
+    inline bool check(bool condition, const char* expression, const char* file, int line)
+    {
+        if (!condition)
+        {
+            std::cerr << file << '(' << line << "): check failed: " << expression << std::endl;
+            ++getFailureCount();
+        }
+        return condition;
+    }
+
+    // What main returns: 1 once any check failed, so ctest reports the test as failed.
+    inline int getExitCode() { return getFailureCount() ? 1 : 0; }
+}
+
+// Reports a failed condition with its location and carries on, so one run lists every failure.
+#define ORC_CHECK(condition) ::Orc::Test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
\ No newline at end of file
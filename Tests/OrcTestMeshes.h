@@ -0,0 +1,153 @@
+#pragma once
+
+#include "OrcMesh.h"
+#include "OrcTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Generated meshes and cameras shared by the tests and the benchmarks.
+namespace Orc::Test
+{
+    // A UV sphere of radius 1 with outward-facing, counter-clockwise triangles, split into submeshCount
+    // submeshes of consecutive triangles whose material indices are their own.
+    inline MeshData makeSphere(uint32 rings, uint32 segments, uint32 submeshCount = 1)
+    {
+        MeshData mesh;
+        for (uint32 ring = 0; ring <= rings; ++ring)
+        {
+            float theta = std::numbers::pi_v<float> * ring / rings;
+            for (uint32 segment = 0; segment <= segments; ++segment)
+            {
+                float phi = 2.0f * std::numbers::pi_v<float> * segment / segments;
+                float x = std::sin(theta) * std::cos(phi), y = std::cos(theta), z = std::sin(theta) * std::sin(phi);
+                mesh.vertices.push_back({ { x, y, z }, { x, y, z }, { float(segment) / segments, float(ring) / rings } });
+            }
+        }
+        for (uint32 ring = 0; ring < rings; ++ring)
+        {
+            for (uint32 segment = 0; segment < segments; ++segment)
+            {
+                uint32 i = ring * (segments + 1) + segment;
+                mesh.indices.insert(mesh.indices.end(), { i, i + 1, i + segments + 1, i + 1, i + segments + 2, i + segments + 1 });
+            }
+        }
+        auto triangleCount = static_cast<uint32>(mesh.indices.size() / 3);
+        for (uint32 i = 0; i < submeshCount; ++i)
+        {
+            uint32 first = triangleCount * i / submeshCount, last = triangleCount * (i + 1) / submeshCount;
+            mesh.submeshes.push_back({ first * 3, (last - first) * 3, static_cast<int32>(i) });
+        }
+        mesh.computeBounds();
+        return mesh;
+    }
+
+    // A gridSize x gridSize height field, a stand-in for terrain, whose normals all face up. Triangles are
+    // in scanline order.
+    inline MeshData makeTerrain(uint32 gridSize)
+    {
+        MeshData mesh;
+        for (uint32 y = 0; y < gridSize; ++y)
+        {
+            for (uint32 x = 0; x < gridSize; ++x)
+            {
+                float u = static_cast<float>(x) / (gridSize - 1), v = static_cast<float>(y) / (gridSize - 1);
+                float height = 0.05f * std::sin(u * 20.0f) * std::cos(v * 20.0f);
+                mesh.vertices.push_back({ { u * 2.0f - 1.0f, height, v * 2.0f - 1.0f }, { 0.0f, 1.0f, 0.0f }, { u, v } });
+            }
+        }
+        for (uint32 y = 0; y + 1 < gridSize; ++y)
+        {
+            for (uint32 x = 0; x + 1 < gridSize; ++x)
+            {
+                uint32 i = y * gridSize + x;
+                mesh.indices.insert(mesh.indices.end(), { i, i + gridSize, i + 1, i + 1, i + gridSize, i + gridSize + 1 });
+            }
+        }
+        mesh.submeshes.push_back({ 0, static_cast<uint32>(mesh.indices.size()), 0 });
+        mesh.computeBounds();
+        return mesh;
+    }
+
+    // Shuffles triangles within each submesh and vertices across the mesh, as exporters that do not care
+    // about ordering leave them.
+    inline MeshData shuffleMesh(MeshData mesh, uint32 seed = 42)
+    {
+        std::mt19937 random(seed);
+        std::vector<uint32> remap(mesh.vertices.size());
+        for (uint32 i = 0; i < remap.size(); ++i)
+            remap[i] = i;
+        std::shuffle(remap.begin(), remap.end(), random);
+
+        std::vector<Vertex> vertices(mesh.vertices.size());
+        for (size_t i = 0; i < remap.size(); ++i)
+            vertices[remap[i]] = mesh.vertices[i];
+        std::vector<uint32> indices(mesh.indices.size());
+        for (const auto& submesh : mesh.submeshes)
+        {
+            std::vector<uint32> triangles(submesh.indexCount / 3);
+            for (uint32 i = 0; i < triangles.size(); ++i)
+                triangles[i] = submesh.indexOffset / 3 + i;
+            std::shuffle(triangles.begin(), triangles.end(), random);
+            for (uint32 i = 0; i < triangles.size(); ++i)
+            {
+                for (uint32 corner = 0; corner < 3; ++corner)
+                    indices[submesh.indexOffset + i * 3 + corner] = remap[mesh.indices[triangles[i] * 3 + corner]];
+            }
+        }
+        mesh.vertices = std::move(vertices);
+        mesh.indices = std::move(indices);
+        return mesh;
+    }
+
+    // Row-major view-projection of a 60 degree, 16:9 perspective camera at eye looking at target, for row
+    // vectors and left-handed coordinates as in DirectXMath.
+    inline void makeViewProjection(const float (&eye)[3], const float (&target)[3], float nearPlane, float farPlane, float (&matrix)[16])
+    {
+        auto normalize = [](float (&v)[3])
+        {
+            float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+            for (auto& c : v)
+                c /= length;
+        };
+        float z[3] = { target[0] - eye[0], target[1] - eye[1], target[2] - eye[2] };
+        normalize(z);
+        float up[3] = { 0.0f, 1.0f, 0.0f };
+        if (std::abs(z[1]) > 0.99f)
+        {
+            up[1] = 0.0f;
+            up[2] = 1.0f;
+        }
+        float x[3] = { up[1] * z[2] - up[2] * z[1], up[2] * z[0] - up[0] * z[2], up[0] * z[1] - up[1] * z[0] };
+        normalize(x);
+        float y[3] = { z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2], z[0] * x[1] - z[1] * x[0] };
+        float view[16] = {
+            x[0], y[0], z[0], 0.0f,
+            x[1], y[1], z[1], 0.0f,
+            x[2], y[2], z[2], 0.0f,
+            -(x[0] * eye[0] + x[1] * eye[1] + x[2] * eye[2]), -(y[0] * eye[0] + y[1] * eye[1] + y[2] * eye[2]), -(z[0] * eye[0] + z[1] * eye[1] + z[2] * eye[2]), 1.0f,
+        };
+
+        float yScale = 1.0f / std::tan(std::numbers::pi_v<float> / 6.0f), xScale = yScale / (16.0f / 9.0f);
+        float depth = farPlane / (farPlane - nearPlane);
+        float projection[16] = {
+            xScale, 0.0f, 0.0f, 0.0f,
+            0.0f, yScale, 0.0f, 0.0f,
+            0.0f, 0.0f, depth, 1.0f,
+            0.0f, 0.0f, -nearPlane * depth, 0.0f,
+        };
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                matrix[row * 4 + column] = 0.0f;
+                for (int k = 0; k < 4; ++k)
+                    matrix[row * 4 + column] += view[row * 4 + k] * projection[k * 4 + column];
+            }
+        }
+    }
+}
\ No newline at end of file
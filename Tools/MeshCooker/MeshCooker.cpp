@@ -0,0 +1,85 @@
+#include "OrcCookedMesh.h"
+#include "OrcJobSystem.h"
+
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Cooks each .gltf or .glb given on the command line into an .orcmesh next to it, or to the path
+// following -o when cooking a single file. Geometry is optimized for the vertex cache, overdraw and
+// vertex fetch unless --no-optimize or --no-overdraw turn that off, then split into meshlets unless
+// --no-meshlets is given. --lods adds a chain of simplified levels of detail.
+int main(int argc, char** argv)
+{
+    try
+    {
+        std::vector<std::filesystem::path> sources;
+        std::filesystem::path output;
+        Orc::MeshCookSettings settings;
+        auto& optimization = settings.optimization;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if (argument == "-o" && i + 1 < argc)
+                output = argv[++i];
+            else if (argument == "--no-optimize")
+                optimization.vertexCache = optimization.overdraw = optimization.vertexFetch = false;
+            else if (argument == "--no-overdraw")
+                optimization.overdraw = false;
+            else if (argument == "--no-meshlets")
+                settings.buildMeshlets = false;
+            else if (argument == "--lods")
+                settings.generateLods = true;
+            else
+                sources.push_back(argument);
+        }
+        if (sources.empty() || (!output.empty() && sources.size() != 1))
+        {
+            std::cerr << "Usage: MeshCooker [--no-optimize] [--no-overdraw] [--no-meshlets] [--lods] <model.gltf|model.glb>... [-o <model.orcmesh>]" << std::endl;
+            return 1;
+        }
+
+        Orc::JobSystem jobSystem(0);
+        int failedCount = 0;
+        for (const auto& source : sources)
+        {
+            auto cooked = output.empty() ? std::filesystem::path(source).replace_extension(".orcmesh") : output;
+            try
+            {
+                auto start = std::chrono::steady_clock::now();
+                auto stats = Orc::cookMesh(source.string(), cooked.string(), &jobSystem, settings);
+                const auto& cache = stats.optimization;
+                std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                std::cout << source.string() << " -> " << cooked.string() << " (" << std::filesystem::file_size(cooked) << " bytes, "
+                    << elapsed.count() << " ms)" << std::endl;
+                std::cout << "    ACMR " << cache.cacheBefore.acmr << " -> " << cache.cacheAfter.acmr << ", ATVR " << cache.cacheBefore.atvr << " -> "
+                    << cache.cacheAfter.atvr << ", vertex overfetch " << cache.fetchBefore.overfetch << " -> " << cache.fetchAfter.overfetch << std::endl;
+                if (settings.buildMeshlets)
+                {
+                    const auto& meshlets = stats.meshlets;
+                    std::cout << "    " << meshlets.meshletCount << " meshlets, " << meshlets.vertexFill * 100 << "% vertex and " << meshlets.triangleFill * 100
+                        << "% triangle fill, " << meshlets.vertexDuplication << "x vertices, " << meshlets.cullableConeCount << " with cullable cones" << std::endl;
+                }
+                for (size_t level = 0; level < stats.lods.size(); ++level)
+                {
+                    Orc::uint64 indexCount = 0;
+                    for (const auto& submesh : stats.lods[level].submeshes)
+                        indexCount += submesh.indexCount;
+                    std::cout << "    LOD " << level + 1 << ": " << indexCount / 3 << " triangles, error " << stats.lods[level].error << std::endl;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << source.string() << ": " << e.what() << std::endl;
+                ++failedCount;
+            }
+        }
+        return failedCount ? 1 : 0;
+    }
+    catch (const std::exception& e) { std::cerr << e.what() << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught." << std::endl; }
+    return 1;
+}
\ No newline at end of file